@@ -52,6 +52,7 @@ class TrainCfg {
   std::string loss_name_;             /**< Set part of the name that identify a loss kernel */
   MixPrecisionCfg mix_precision_cfg_; /**< Mix precision configuration */
   bool accumulate_gradients_ = false;
+  size_t recompute_memory_budget_ = 0; /**< Activation memory budget in bytes, recompute activations to meet it */
 };
 
 }  // namespace mindspore
@@ -18,10 +18,13 @@
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_PS_FUSED_PULL_WEIGHT_KERNEL_H_
 
 #include <map>
+#include <algorithm>
+#include <utility>
 #include <vector>
 #include <string>
 #include <memory>
 #include <functional>
+#include <numeric>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 #include "schema/fl_job_generated.h"
@@ -32,6 +35,107 @@ namespace mindspore {
 namespace kernel {
 // The duration between two PullWeight requests when return code is ResponseCode_SucNotReady.
 constexpr int kRetryDurationOfPullWeights = 200;
+// The max bytes of the weights pulled in one request.
+constexpr size_t kPullWeightBucketSize = 4 << 20;
+
+// Holds the responses of the weight buckets of one pull, so that the weights are updated only after every bucket is
+// pulled, and only if all of them come from the same iteration.
+class PullWeightStaging {
+ public:
+  explicit PullWeightStaging(size_t bucket_num) : responses_(bucket_num) {}
+  ~PullWeightStaging() = default;
+
+  // Keep the response of the bucket unless the server is not ready yet, return the parsed response.
+  const schema::ResponsePullWeight *Stage(size_t bucket_id, const std::shared_ptr<std::vector<unsigned char>> &msg) {
+    MS_EXCEPTION_IF_NULL(msg);
+    const schema::ResponsePullWeight *pull_weight_rsp = flatbuffers::GetRoot<schema::ResponsePullWeight>(msg->data());
+    MS_EXCEPTION_IF_NULL(pull_weight_rsp);
+    if (pull_weight_rsp->retcode() != schema::ResponseCode_SucNotReady) {
+      responses_.at(bucket_id) = msg;
+    }
+    return pull_weight_rsp;
+  }
+
+  // Return whether all the buckets are staged from the same iteration, latest_iteration is set to the newest one.
+  bool SameIteration(uint64_t *latest_iteration) const {
+    MS_EXCEPTION_IF_NULL(latest_iteration);
+    bool same = true;
+    for (size_t i = 0; i < responses_.size(); i++) {
+      auto iteration = static_cast<uint64_t>(Response(i)->iteration());
+      same = same && (i == 0 || iteration == *latest_iteration);
+      *latest_iteration = (i == 0) ? iteration : std::max(*latest_iteration, iteration);
+    }
+    return same;
+  }
+
+  void Clear() {
+    for (auto &response : responses_) {
+      response = nullptr;
+    }
+  }
+
+  // Copy the staged weights of the buckets, which hold the indexes of the weights and names.
+  void CopyWeights(const std::vector<std::vector<size_t>> &buckets, const std::vector<std::string> &weight_names,
+                   const std::vector<AddressPtr> &weights) const {
+    if (buckets.size() != responses_.size()) {
+      MS_LOG(EXCEPTION) << "The bucket number " << buckets.size() << " is not equal to the response number "
+                        << responses_.size();
+    }
+    // Check all the buckets before copying any of them, so the weights are never partially updated.
+    std::map<std::string, Address> feature_map;
+    for (size_t i = 0; i < buckets.size(); i++) {
+      auto bucket_feature_map = ParseFeatureMap(Response(i), buckets[i].size());
+      feature_map.insert(bucket_feature_map.begin(), bucket_feature_map.end());
+      for (size_t index : buckets[i]) {
+        if (feature_map.count(weight_names.at(index)) == 0) {
+          MS_LOG(EXCEPTION) << "The weights for " << weight_names[index] << " is not pulled from server.";
+        }
+        MS_EXCEPTION_IF_NULL(weights.at(index));
+      }
+    }
+    for (const auto &bucket : buckets) {
+      for (size_t index : bucket) {
+        const Address &weight = feature_map[weight_names[index]];
+        int ret = memcpy_s(weights[index]->addr, weights[index]->size, weight.addr, weight.size);
+        if (ret != 0) {
+          MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+        }
+      }
+    }
+  }
+
+ private:
+  const schema::ResponsePullWeight *Response(size_t bucket_id) const {
+    const auto &msg = responses_.at(bucket_id);
+    if (msg == nullptr) {
+      MS_LOG(EXCEPTION) << "The weights of bucket " << bucket_id << " are not pulled.";
+    }
+    return flatbuffers::GetRoot<schema::ResponsePullWeight>(msg->data());
+  }
+
+  static std::map<std::string, Address> ParseFeatureMap(const schema::ResponsePullWeight *pull_weight_rsp,
+                                                        size_t weight_num) {
+    MS_EXCEPTION_IF_NULL(pull_weight_rsp);
+    auto fbs_feature_map = pull_weight_rsp->feature_map();
+    MS_EXCEPTION_IF_NULL(fbs_feature_map);
+    if (fbs_feature_map->size() != weight_num) {
+      MS_LOG(EXCEPTION) << "FusedPullWeightKernel should get " << weight_num << " weights, but got "
+                        << fbs_feature_map->size() << " weights.";
+    }
+
+    std::map<std::string, Address> feature_map;
+    for (size_t i = 0; i < fbs_feature_map->size(); i++) {
+      std::string weight_full_name = fbs_feature_map->Get(i)->weight_fullname()->str();
+      float *weight_data = const_cast<float *>(fbs_feature_map->Get(i)->data()->data());
+      size_t weight_size = fbs_feature_map->Get(i)->data()->size() * sizeof(float);
+      feature_map[weight_full_name] = {weight_data, weight_size};
+    }
+    return feature_map;
+  }
+
+  std::vector<std::shared_ptr<std::vector<unsigned char>>> responses_;
+};
+
 template <typename T>
 class FusedPullWeightKernel : public CPUKernel {
  public:
@@ -46,9 +150,6 @@ class FusedPullWeightKernel : public CPUKernel {
                         << weight_full_names_.size() << " weights as inputs.";
     }
 
-    std::shared_ptr<fl::FBBuilder> fbb = std::make_shared<fl::FBBuilder>();
-    MS_EXCEPTION_IF_NULL(fbb);
-
     total_iteration_++;
     uint64_t step_num_per_iteration = fl::worker::FLWorker::GetInstance().worker_step_num_per_iteration();
     if (step_num_per_iteration == 0) {
@@ -64,61 +165,32 @@ class FusedPullWeightKernel : public CPUKernel {
 
     fl_iteration_++;
     MS_LOG(INFO) << "Launching pulling weight for federated learning iteration " << fl_iteration_;
-    if (!BuildPullWeightReq(fbb)) {
-      MS_LOG(EXCEPTION) << "Building request for FusedPullWeight failed.";
-    }
-
-    std::shared_ptr<std::vector<unsigned char>> pull_weight_rsp_msg = nullptr;
-    const schema::ResponsePullWeight *pull_weight_rsp = nullptr;
-    int retcode = schema::ResponseCode_SucNotReady;
-    while (retcode == schema::ResponseCode_SucNotReady) {
-      if (!fl::worker::FLWorker::GetInstance().running()) {
-        MS_LOG(WARNING) << "Worker has finished.";
-        return true;
-      }
-      if (!fl::worker::FLWorker::GetInstance().SendToServer(
-            0, fbb->GetBufferPointer(), fbb->GetSize(), ps::core::TcpUserCommand::kPullWeight, &pull_weight_rsp_msg)) {
-        MS_LOG(WARNING) << "Sending request for FusedPullWeight to server 0 failed. Retry later.";
-        retcode = schema::ResponseCode_SucNotReady;
-        std::this_thread::sleep_for(std::chrono::milliseconds(kRetryDurationOfPullWeights));
-        continue;
-      }
-      MS_EXCEPTION_IF_NULL(pull_weight_rsp_msg);
-
-      pull_weight_rsp = flatbuffers::GetRoot<schema::ResponsePullWeight>(pull_weight_rsp_msg->data());
-      MS_EXCEPTION_IF_NULL(pull_weight_rsp);
-      retcode = pull_weight_rsp->retcode();
-      if (retcode == schema::ResponseCode_SucNotReady) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(kRetryDurationOfPullWeights));
-        fl_iteration_ = pull_weight_rsp->iteration();
-        MS_LOG(DEBUG) << "Server is not ready for downloading yet. Reason: " << pull_weight_rsp->reason()->str()
-                      << ". Retry later.";
-        // Recreate fbb to avoid memory leak of FlatBuffers.
-        fbb = std::make_shared<fl::FBBuilder>();
-        if (!BuildPullWeightReq(fbb)) {
-          MS_LOG(EXCEPTION) << "Building request for FusedPullWeight failed.";
+    // The weights are pulled in buckets, each of which is sent to a different server concurrently, so that the
+    // servers serialize and transfer the weights in parallel. The weights are updated only after all the buckets are
+    // pulled from the same iteration, otherwise all of them are pulled again.
+    std::vector<std::vector<size_t>> buckets = SplitBuckets(inputs);
+    PullWeightStaging staging(buckets.size());
+    uint32_t server_num = fl::worker::FLWorker::GetInstance().server_num();
+    while (true) {
+      std::vector<size_t> pending_buckets(buckets.size());
+      std::iota(pending_buckets.begin(), pending_buckets.end(), 0);
+      while (!pending_buckets.empty()) {
+        if (!fl::worker::FLWorker::GetInstance().running()) {
+          MS_LOG(WARNING) << "Worker has finished.";
+          return true;
         }
-        continue;
-      } else if (retcode != schema::ResponseCode_SUCCEED) {
-        MS_LOG(WARNING) << "FusedPullWeight failed. Server return code: " << pull_weight_rsp->retcode()
-                        << ", reason: " << pull_weight_rsp->reason()->str();
-      } else {
-        MS_LOG(DEBUG) << "FusedPullWeight succeed.";
-      }
-    }
-
-    auto feature_map = ParseFeatureMap(pull_weight_rsp);
-    for (size_t i = 0; i < weight_full_names_.size(); i++) {
-      const std::string &weight_name = weight_full_names_[i];
-      if (feature_map.count(weight_name) == 0) {
-        MS_LOG(EXCEPTION) << "The weights for " << weight_name << " is not pulled from server.";
+        pending_buckets = PullBuckets(buckets, pending_buckets, server_num, &staging);
       }
-      int ret =
-        memcpy_s(inputs[i]->addr, inputs[i]->size, feature_map[weight_name].addr, feature_map[weight_name].size);
-      if (ret != 0) {
-        MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+      uint64_t latest_iteration = 0;
+      if (staging.SameIteration(&latest_iteration)) {
+        break;
       }
+      MS_LOG(INFO) << "The weights are pulled from different iterations, pull all of them again from iteration "
+                   << latest_iteration;
+      fl_iteration_ = latest_iteration;
+      staging.Clear();
     }
+    staging.CopyWeights(buckets, weight_full_names_, inputs);
     MS_LOG(INFO) << "Pull weights for " << weight_full_names_ << " success. Iteration: " << fl_iteration_;
     fl::worker::FLWorker::GetInstance().SetIterationRunning();
     return true;
@@ -157,11 +229,28 @@ class FusedPullWeightKernel : public CPUKernel {
   void InitSizeLists() { return; }
 
  private:
-  bool BuildPullWeightReq(std::shared_ptr<fl::FBBuilder> fbb) {
+  // Split the weights into the buckets of at most kPullWeightBucketSize bytes, except the ones larger than that which
+  // take a bucket each.
+  std::vector<std::vector<size_t>> SplitBuckets(const std::vector<AddressPtr> &weights) const {
+    std::vector<std::vector<size_t>> buckets;
+    size_t bucket_size = kPullWeightBucketSize;
+    for (size_t i = 0; i < weights.size(); i++) {
+      MS_EXCEPTION_IF_NULL(weights[i]);
+      if (buckets.empty() || bucket_size + weights[i]->size > kPullWeightBucketSize) {
+        buckets.emplace_back();
+        bucket_size = 0;
+      }
+      buckets.back().push_back(i);
+      bucket_size += weights[i]->size;
+    }
+    return buckets;
+  }
+
+  bool BuildPullWeightReq(std::shared_ptr<fl::FBBuilder> fbb, const std::vector<size_t> &bucket) {
     MS_EXCEPTION_IF_NULL(fbb);
     std::vector<flatbuffers::Offset<flatbuffers::String>> fbs_weight_names;
-    for (const std::string &weight_name : weight_full_names_) {
-      auto fbs_weight_name = fbb->CreateString(weight_name);
+    for (size_t index : bucket) {
+      auto fbs_weight_name = fbb->CreateString(weight_full_names_[index]);
       fbs_weight_names.push_back(fbs_weight_name);
     }
     auto fbs_weight_names_vector = fbb->CreateVector(fbs_weight_names);
@@ -174,22 +263,56 @@ class FusedPullWeightKernel : public CPUKernel {
     return true;
   }
 
-  std::map<std::string, Address> ParseFeatureMap(const schema::ResponsePullWeight *pull_weight_rsp) {
-    MS_EXCEPTION_IF_NULL(pull_weight_rsp);
-    auto fbs_feature_map = pull_weight_rsp->feature_map();
-    if (fbs_feature_map->size() != weight_full_names_.size()) {
-      MS_LOG(EXCEPTION) << "FusedPullWeightKernel should get " << weight_full_names_.size() << " weights, but got "
-                        << fbs_feature_map->size() << " weights.";
+  // Send at most one bucket to each server, stage the responses and return the buckets to pull again.
+  std::vector<size_t> PullBuckets(const std::vector<std::vector<size_t>> &buckets,
+                                  const std::vector<size_t> &pending_buckets, uint32_t server_num,
+                                  PullWeightStaging *staging) {
+    MS_EXCEPTION_IF_NULL(staging);
+    size_t bucket_num = std::min(pending_buckets.size(), static_cast<size_t>(std::max(server_num, 1U)));
+    std::vector<std::shared_ptr<fl::FBBuilder>> fbbs;
+    std::vector<uint32_t> servers;
+    std::vector<const void *> data;
+    std::vector<size_t> sizes;
+    for (size_t i = 0; i < bucket_num; i++) {
+      // Recreate fbb to avoid memory leak of FlatBuffers.
+      fbbs.push_back(std::make_shared<fl::FBBuilder>());
+      if (!BuildPullWeightReq(fbbs[i], buckets[pending_buckets[i]])) {
+        MS_LOG(EXCEPTION) << "Building request for FusedPullWeight failed.";
+      }
+      servers.push_back(static_cast<uint32_t>(i));
+      data.push_back(fbbs[i]->GetBufferPointer());
+      sizes.push_back(fbbs[i]->GetSize());
+    }
+    std::vector<std::shared_ptr<std::vector<unsigned char>>> pull_weight_rsp_msgs;
+    if (!fl::worker::FLWorker::GetInstance().SendToServers(servers, data, sizes, ps::core::TcpUserCommand::kPullWeight,
+                                                           &pull_weight_rsp_msgs)) {
+      MS_LOG(WARNING) << "Sending request for FusedPullWeight to servers " << servers << " failed. Retry later.";
+      std::this_thread::sleep_for(std::chrono::milliseconds(kRetryDurationOfPullWeights));
+      return pending_buckets;
     }
 
-    std::map<std::string, Address> feature_map;
-    for (size_t i = 0; i < fbs_feature_map->size(); i++) {
-      std::string weight_full_name = fbs_feature_map->Get(i)->weight_fullname()->str();
-      float *weight_data = const_cast<float *>(fbs_feature_map->Get(i)->data()->data());
-      size_t weight_size = fbs_feature_map->Get(i)->data()->size() * sizeof(float);
-      feature_map[weight_full_name] = {weight_data, weight_size};
+    std::vector<size_t> not_ready_buckets;
+    for (size_t i = 0; i < bucket_num; i++) {
+      auto pull_weight_rsp = staging->Stage(pending_buckets[i], pull_weight_rsp_msgs.at(i));
+      int retcode = pull_weight_rsp->retcode();
+      if (retcode == schema::ResponseCode_SucNotReady) {
+        fl_iteration_ = pull_weight_rsp->iteration();
+        MS_LOG(DEBUG) << "Server " << servers[i] << " is not ready for downloading yet. Reason: "
+                      << pull_weight_rsp->reason()->str() << ". Retry later.";
+        not_ready_buckets.push_back(pending_buckets[i]);
+      } else if (retcode != schema::ResponseCode_SUCCEED) {
+        MS_LOG(WARNING) << "FusedPullWeight failed. Server return code: " << pull_weight_rsp->retcode()
+                        << ", reason: " << pull_weight_rsp->reason()->str();
+      } else {
+        MS_LOG(DEBUG) << "FusedPullWeight from server " << servers[i] << " succeed.";
+      }
     }
-    return feature_map;
+    bool has_not_ready = !not_ready_buckets.empty();
+    not_ready_buckets.insert(not_ready_buckets.end(), pending_buckets.begin() + bucket_num, pending_buckets.end());
+    if (has_not_ready) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(kRetryDurationOfPullWeights));
+    }
+    return not_ready_buckets;
   }
 
   uint32_t server_num_;
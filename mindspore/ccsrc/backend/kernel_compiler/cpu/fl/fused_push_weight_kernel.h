@@ -21,6 +21,8 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <numeric>
+#include <utility>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 #include "ps/ps_context.h"
@@ -66,43 +68,52 @@ class FusedPushWeightKernel : public CPUKernel {
       MS_LOG(EXCEPTION) << "Building request for FusedPushWeight failed.";
     }
 
-    // The server number may change after scaling in/out.
-    for (uint32_t i = 0; i < fl::worker::FLWorker::GetInstance().server_num(); i++) {
-      std::shared_ptr<std::vector<unsigned char>> push_weight_rsp_msg = nullptr;
-      const schema::ResponsePushWeight *push_weight_rsp = nullptr;
-      int retcode = schema::ResponseCode_SucNotReady;
-      while (retcode == schema::ResponseCode_SucNotReady) {
-        if (!fl::worker::FLWorker::GetInstance().running()) {
-          MS_LOG(WARNING) << "Worker has finished.";
-          return true;
-        }
-        if (!fl::worker::FLWorker::GetInstance().SendToServer(i, fbb->GetBufferPointer(), fbb->GetSize(),
-                                                              ps::core::TcpUserCommand::kPushWeight,
-                                                              &push_weight_rsp_msg)) {
-          MS_LOG(WARNING) << "Sending request for FusedPushWeight to server " << i << " failed.";
-          retcode = schema::ResponseCode_SucNotReady;
-          std::this_thread::sleep_for(std::chrono::milliseconds(kRetryDurationOfPushWeights));
-          continue;
-        }
-        MS_EXCEPTION_IF_NULL(push_weight_rsp_msg);
+    // The server number may change after scaling in/out. The request is sent to all the servers concurrently, and only
+    // the servers which are not ready are requested again.
+    std::vector<uint32_t> pending_servers(fl::worker::FLWorker::GetInstance().server_num());
+    std::iota(pending_servers.begin(), pending_servers.end(), 0);
+    while (!pending_servers.empty()) {
+      if (!fl::worker::FLWorker::GetInstance().running()) {
+        MS_LOG(WARNING) << "Worker has finished.";
+        return true;
+      }
+      std::vector<const void *> data(pending_servers.size(), fbb->GetBufferPointer());
+      std::vector<size_t> sizes(pending_servers.size(), fbb->GetSize());
+      std::vector<std::shared_ptr<std::vector<unsigned char>>> push_weight_rsp_msgs;
+      if (!fl::worker::FLWorker::GetInstance().SendToServers(pending_servers, data, sizes,
+                                                             ps::core::TcpUserCommand::kPushWeight,
+                                                             &push_weight_rsp_msgs)) {
+        MS_LOG(WARNING) << "Sending request for FusedPushWeight to servers " << pending_servers << " failed.";
+        std::this_thread::sleep_for(std::chrono::milliseconds(kRetryDurationOfPushWeights));
+        continue;
+      }
 
-        push_weight_rsp = flatbuffers::GetRoot<schema::ResponsePushWeight>(push_weight_rsp_msg->data());
+      std::vector<uint32_t> not_ready_servers;
+      for (size_t i = 0; i < pending_servers.size(); i++) {
+        MS_EXCEPTION_IF_NULL(push_weight_rsp_msgs[i]);
+        const schema::ResponsePushWeight *push_weight_rsp =
+          flatbuffers::GetRoot<schema::ResponsePushWeight>(push_weight_rsp_msgs[i]->data());
         MS_EXCEPTION_IF_NULL(push_weight_rsp);
-        retcode = push_weight_rsp->retcode();
+        int retcode = push_weight_rsp->retcode();
         if (retcode == schema::ResponseCode_SucNotReady) {
-          std::this_thread::sleep_for(std::chrono::milliseconds(kRetryDurationOfPushWeights));
           fl_iteration_ = push_weight_rsp->iteration();
-          MS_LOG(DEBUG) << "Server is not ready for pushing weight yet. Reason: " << push_weight_rsp->reason()->str()
-                        << ". Retry later.";
-          if (!BuildPushWeightReq(fbb, inputs)) {
-            MS_LOG(EXCEPTION) << "Building request for FusedPushWeight failed.";
-          }
-          continue;
+          MS_LOG(DEBUG) << "Server " << pending_servers[i] << " is not ready for pushing weight yet. Reason: "
+                        << push_weight_rsp->reason()->str() << ". Retry later.";
+          not_ready_servers.push_back(pending_servers[i]);
         } else if (retcode != schema::ResponseCode_SUCCEED) {
           MS_LOG(WARNING) << "FusedPushWeight failed. Server return code: " << push_weight_rsp->retcode()
                           << ", reason: " << push_weight_rsp->reason()->str();
         } else {
-          MS_LOG(DEBUG) << "FusedPushWeight succeed.";
+          MS_LOG(DEBUG) << "FusedPushWeight to server " << pending_servers[i] << " succeed.";
+        }
+      }
+      pending_servers = std::move(not_ready_servers);
+      if (!pending_servers.empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(kRetryDurationOfPushWeights));
+        // Recreate fbb to avoid memory leak of FlatBuffers.
+        fbb = std::make_shared<fl::FBBuilder>();
+        if (!BuildPushWeightReq(fbb, inputs)) {
+          MS_LOG(EXCEPTION) << "Building request for FusedPushWeight failed.";
         }
       }
     }
@@ -0,0 +1,232 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/fp32_grad/fused_optimizer.h"
+#include <math.h>
+#include "nnacl/intrinsics/ms_simd_instructions.h"
+
+static inline float FusedGrad(const FusedOptimizerSegment *seg, size_t i) {
+  float grad = 0.0f;
+  if (seg->grad_sum_ != NULL) {
+    grad += seg->grad_sum_[i];
+    seg->grad_sum_[i] = 0.0f;
+  }
+  if (seg->gradient_ != NULL) {
+    grad += seg->gradient_[i];
+  }
+  return grad;
+}
+
+#ifdef ENABLE_AVX
+static inline MS_FLOAT32X8 FusedGradX8(const FusedOptimizerSegment *seg, size_t i) {
+  MS_FLOAT32X8 zero = MS_MOV256_F32(0.0f);
+  MS_FLOAT32X8 grad = zero;
+  if (seg->grad_sum_ != NULL) {
+    grad = MS_LD256_F32(seg->grad_sum_ + i);
+    MS_ST256_F32(seg->grad_sum_ + i, zero);
+  }
+  if (seg->gradient_ != NULL) {
+    grad = MS_ADD256_F32(grad, MS_LD256_F32(seg->gradient_ + i));
+  }
+  return grad;
+}
+#endif
+
+#if defined(ENABLE_ARM) || defined(ENABLE_AVX) || defined(ENABLE_SSE)
+static inline MS_FLOAT32X4 FusedGradX4(const FusedOptimizerSegment *seg, size_t i) {
+  MS_FLOAT32X4 zero = MS_MOVQ_F32(0.0f);
+  MS_FLOAT32X4 grad = zero;
+  if (seg->grad_sum_ != NULL) {
+    grad = MS_LDQ_F32(seg->grad_sum_ + i);
+    MS_STQ_F32(seg->grad_sum_ + i, zero);
+  }
+  if (seg->gradient_ != NULL) {
+    grad = MS_ADDQ_F32(grad, MS_LDQ_F32(seg->gradient_ + i));
+  }
+  return grad;
+}
+#endif
+
+static void FusedAdamSegment(const FusedOptimizerSegment *seg, size_t start, size_t end) {
+  float *weight = seg->weight_;
+  float *m = seg->moment1_;
+  float *v = seg->moment2_;
+  const float one_minus_beta1 = 1.0f - seg->beta1_;
+  const float one_minus_beta2 = 1.0f - seg->beta2_;
+  size_t i = start;
+#ifdef ENABLE_AVX
+  MS_FLOAT32X8 beta1_8 = MS_MOV256_F32(seg->beta1_);
+  MS_FLOAT32X8 one_minus_beta1_8 = MS_MOV256_F32(one_minus_beta1);
+  MS_FLOAT32X8 one_minus_beta2_8 = MS_MOV256_F32(one_minus_beta2);
+  MS_FLOAT32X8 lr_8 = MS_MOV256_F32(seg->lr_);
+  MS_FLOAT32X8 eps_8 = MS_MOV256_F32(seg->epsilon_);
+  for (; i + C8NUM <= end; i += C8NUM) {
+    MS_FLOAT32X8 grad = FusedGradX8(seg, i);
+    MS_FLOAT32X8 m_8 = MS_LD256_F32(m + i);
+    m_8 = MS_ADD256_F32(m_8, MS_MUL256_F32(MS_SUB256_F32(grad, m_8), one_minus_beta1_8));
+    MS_ST256_F32(m + i, m_8);
+    MS_FLOAT32X8 v_8 = MS_LD256_F32(v + i);
+    v_8 = MS_ADD256_F32(v_8, MS_MUL256_F32(MS_SUB256_F32(MS_MUL256_F32(grad, grad), v_8), one_minus_beta2_8));
+    MS_ST256_F32(v + i, v_8);
+    MS_FLOAT32X8 update = m_8;
+    if (seg->use_nesterov_) {
+      update = MS_ADD256_F32(MS_MUL256_F32(m_8, beta1_8), MS_MUL256_F32(one_minus_beta1_8, grad));
+    }
+    update = MS_DIV256_F32(MS_MUL256_F32(lr_8, update), MS_ADD256_F32(MS_SQRTFX8_F32(v_8), eps_8));
+    MS_ST256_F32(weight + i, MS_SUB256_F32(MS_LD256_F32(weight + i), update));
+  }
+#endif
+#if defined(ENABLE_ARM) || defined(ENABLE_AVX) || defined(ENABLE_SSE)
+  MS_FLOAT32X4 beta1_4 = MS_MOVQ_F32(seg->beta1_);
+  MS_FLOAT32X4 one_minus_beta1_4 = MS_MOVQ_F32(one_minus_beta1);
+  MS_FLOAT32X4 one_minus_beta2_4 = MS_MOVQ_F32(one_minus_beta2);
+  MS_FLOAT32X4 lr_4 = MS_MOVQ_F32(seg->lr_);
+  MS_FLOAT32X4 eps_4 = MS_MOVQ_F32(seg->epsilon_);
+  for (; i + C4NUM <= end; i += C4NUM) {
+    MS_FLOAT32X4 grad = FusedGradX4(seg, i);
+    MS_FLOAT32X4 m_4 = MS_LDQ_F32(m + i);
+    m_4 = MS_ADDQ_F32(m_4, MS_MULQ_F32(MS_SUBQ_F32(grad, m_4), one_minus_beta1_4));
+    MS_STQ_F32(m + i, m_4);
+    MS_FLOAT32X4 v_4 = MS_LDQ_F32(v + i);
+    v_4 = MS_ADDQ_F32(v_4, MS_MULQ_F32(MS_SUBQ_F32(MS_MULQ_F32(grad, grad), v_4), one_minus_beta2_4));
+    MS_STQ_F32(v + i, v_4);
+    MS_FLOAT32X4 update = m_4;
+    if (seg->use_nesterov_) {
+      update = MS_ADDQ_F32(MS_MULQ_F32(m_4, beta1_4), MS_MULQ_F32(one_minus_beta1_4, grad));
+    }
+    update = MS_DIVQ_F32(MS_MULQ_F32(lr_4, update), MS_ADDQ_F32(MS_SQRTFX4_F32(v_4), eps_4));
+    MS_STQ_F32(weight + i, MS_SUBQ_F32(MS_LDQ_F32(weight + i), update));
+  }
+#endif
+  for (; i < end; ++i) {
+    float grad = FusedGrad(seg, i);
+    m[i] += (grad - m[i]) * one_minus_beta1;
+    v[i] += (grad * grad - v[i]) * one_minus_beta2;
+    float update = seg->use_nesterov_ ? (m[i] * seg->beta1_ + one_minus_beta1 * grad) : m[i];
+    weight[i] -= seg->lr_ * update / (sqrtf(v[i]) + seg->epsilon_);
+  }
+}
+
+static void FusedSgdSegment(const FusedOptimizerSegment *seg, size_t start, size_t end) {
+  float *weight = seg->weight_;
+  float *accumulate = seg->moment1_;
+  const float lr = seg->lr_;
+  const float momentum = seg->momentum_;
+  const float one_minus_dampening = 1.0f - seg->dampening_;
+  const bool use_accumulate = seg->sgd_init_ || momentum > 0.0f;
+  size_t i = start;
+#ifdef ENABLE_AVX
+  MS_FLOAT32X8 lr_8 = MS_MOV256_F32(lr);
+  MS_FLOAT32X8 momentum_8 = MS_MOV256_F32(momentum);
+  MS_FLOAT32X8 one_minus_dampening_8 = MS_MOV256_F32(one_minus_dampening);
+  for (; i + C8NUM <= end; i += C8NUM) {
+    MS_FLOAT32X8 grad = FusedGradX8(seg, i);
+    MS_FLOAT32X8 update = grad;
+    if (use_accumulate) {
+      MS_FLOAT32X8 acc = grad;
+      if (!seg->sgd_init_) {
+        MS_FLOAT32X8 prev = MS_LD256_F32(accumulate + i);
+        acc = MS_ADD256_F32(MS_MUL256_F32(prev, momentum_8), MS_MUL256_F32(grad, one_minus_dampening_8));
+      }
+      MS_ST256_F32(accumulate + i, acc);
+      update = seg->use_nesterov_ ? MS_ADD256_F32(MS_MUL256_F32(acc, momentum_8), grad) : acc;
+    }
+    MS_ST256_F32(weight + i, MS_SUB256_F32(MS_LD256_F32(weight + i), MS_MUL256_F32(update, lr_8)));
+  }
+#endif
+#if defined(ENABLE_ARM) || defined(ENABLE_AVX) || defined(ENABLE_SSE)
+  MS_FLOAT32X4 lr_4 = MS_MOVQ_F32(lr);
+  MS_FLOAT32X4 momentum_4 = MS_MOVQ_F32(momentum);
+  MS_FLOAT32X4 one_minus_dampening_4 = MS_MOVQ_F32(one_minus_dampening);
+  for (; i + C4NUM <= end; i += C4NUM) {
+    MS_FLOAT32X4 grad = FusedGradX4(seg, i);
+    MS_FLOAT32X4 update = grad;
+    if (use_accumulate) {
+      MS_FLOAT32X4 acc = grad;
+      if (!seg->sgd_init_) {
+        MS_FLOAT32X4 prev = MS_LDQ_F32(accumulate + i);
+        acc = MS_ADDQ_F32(MS_MULQ_F32(prev, momentum_4), MS_MULQ_F32(grad, one_minus_dampening_4));
+      }
+      MS_STQ_F32(accumulate + i, acc);
+      update = seg->use_nesterov_ ? MS_ADDQ_F32(MS_MULQ_F32(acc, momentum_4), grad) : acc;
+    }
+    MS_STQ_F32(weight + i, MS_SUBQ_F32(MS_LDQ_F32(weight + i), MS_MULQ_F32(update, lr_4)));
+  }
+#endif
+  for (; i < end; ++i) {
+    float grad = FusedGrad(seg, i);
+    float update = grad;
+    if (use_accumulate) {
+      accumulate[i] = seg->sgd_init_ ? grad : accumulate[i] * momentum + grad * one_minus_dampening;
+      update = seg->use_nesterov_ ? accumulate[i] * momentum + grad : accumulate[i];
+    }
+    weight[i] -= update * lr;
+  }
+}
+
+static void FusedAccumulateSegment(const FusedOptimizerSegment *seg, size_t start, size_t end) {
+  float *grad_sum = seg->grad_sum_;
+  const float *gradient = seg->gradient_;
+  if (grad_sum == NULL || gradient == NULL) {
+    return;
+  }
+  size_t i = start;
+#ifdef ENABLE_AVX
+  for (; i + C8NUM <= end; i += C8NUM) {
+    MS_ST256_F32(grad_sum + i, MS_ADD256_F32(MS_LD256_F32(grad_sum + i), MS_LD256_F32(gradient + i)));
+  }
+#endif
+#if defined(ENABLE_ARM) || defined(ENABLE_AVX) || defined(ENABLE_SSE)
+  for (; i + C4NUM <= end; i += C4NUM) {
+    MS_STQ_F32(grad_sum + i, MS_ADDQ_F32(MS_LDQ_F32(grad_sum + i), MS_LDQ_F32(gradient + i)));
+  }
+#endif
+  for (; i < end; ++i) {
+    grad_sum[i] += gradient[i];
+  }
+}
+
+typedef void (*FusedSegmentFunc)(const FusedOptimizerSegment *seg, size_t start, size_t end);
+
+static void FusedSegmentsRun(const FusedOptimizerSegment *segments, int segment_num, size_t start, size_t end,
+                             FusedSegmentFunc func) {
+  size_t offset = 0;
+  for (int s = 0; s < segment_num && offset < end; s++) {
+    const FusedOptimizerSegment *seg = segments + s;
+    size_t seg_end = offset + seg->length_;
+    if (seg_end > start) {
+      size_t begin = MSMAX(start, offset) - offset;
+      size_t stop = MSMIN(end, seg_end) - offset;
+      func(seg, begin, stop);
+    }
+    offset = seg_end;
+  }
+}
+
+static void FusedStepSegment(const FusedOptimizerSegment *seg, size_t start, size_t end) {
+  if (seg->type_ == FusedOptimizer_Adam) {
+    FusedAdamSegment(seg, start, end);
+  } else {
+    FusedSgdSegment(seg, start, end);
+  }
+}
+
+void FusedAccumulateGradFp32(const FusedOptimizerSegment *segments, int segment_num, size_t start, size_t end) {
+  FusedSegmentsRun(segments, segment_num, start, end, FusedAccumulateSegment);
+}
+
+void FusedOptimizerStepFp32(const FusedOptimizerSegment *segments, int segment_num, size_t start, size_t end) {
+  FusedSegmentsRun(segments, segment_num, start, end, FusedStepSegment);
+}
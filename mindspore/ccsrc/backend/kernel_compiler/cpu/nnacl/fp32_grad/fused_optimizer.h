@@ -0,0 +1,56 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_NNACL_FP32_GRAD_FUSED_OPTIMIZER_H_
+#define MINDSPORE_NNACL_FP32_GRAD_FUSED_OPTIMIZER_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "nnacl/op_base.h"
+
+typedef enum FusedOptimizerType { FusedOptimizer_Adam = 0, FusedOptimizer_Sgd = 1 } FusedOptimizerType;
+
+/* One parameter tensor of a multi-tensor optimizer step. The effective gradient of an element is
+ * grad_sum_[i] + gradient_[i], either pointer may be NULL. grad_sum_ is cleared after the update. */
+typedef struct FusedOptimizerSegment {
+  int type_;
+  float *weight_;
+  float *moment1_; /* adam: m, sgd: accumulate */
+  float *moment2_; /* adam: v */
+  float *grad_sum_;
+  const float *gradient_;
+  size_t length_;
+  float lr_; /* adam: bias corrected learning rate */
+  float beta1_;
+  float beta2_;
+  float epsilon_;
+  float momentum_;
+  float dampening_;
+  bool use_nesterov_;
+  bool sgd_init_; /* first sgd step copies the gradient into the accumulate */
+} FusedOptimizerSegment;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* start and end index the concatenation of all segments, so work splits evenly across tensors of any size */
+void FusedAccumulateGradFp32(const FusedOptimizerSegment *segments, int segment_num, size_t start, size_t end);
+void FusedOptimizerStepFp32(const FusedOptimizerSegment *segments, int segment_num, size_t start, size_t end);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_FP32_GRAD_FUSED_OPTIMIZER_H_
@@ -17,14 +17,20 @@
 #include "backend/kernel_compiler/cpu/ps/embedding_look_up_proxy_kernel.h"
 #include <vector>
 #include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <numeric>
 #include "ps/worker.h"
 #include "ps/util.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace kernel {
 namespace ps {
 constexpr size_t kEmbeddingLookUpProxyInputsNum = 2;
 constexpr size_t kEmbeddingLookUpProxyOutputsNum = 1;
+// The max number of steps the prefetched embedding rows are used for, 0 to look up synchronously in each step.
+constexpr char kEmbeddingStalenessEnv[] = "MS_DEV_PS_EMBEDDING_STALENESS";
 
 void EmbeddingLookUpProxyKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
@@ -65,7 +71,28 @@ void EmbeddingLookUpProxyKernel::InitKernel(const CNodePtr &kernel_node) {
                                                                    info)) {
       MS_LOG(EXCEPTION) << "InitPSEmbeddingTable failed.";
     }
+    size_t indices_num =
+      std::accumulate(indices_shape.begin(), indices_shape.end(), size_t(1), std::multiplies<size_t>());
+    size_t output_num = std::accumulate(output_shape.begin(), output_shape.end(), size_t(1), std::multiplies<size_t>());
+    if (indices_num > 0) {
+      InitPrefetcher(output_num / indices_num);
+    }
+  }
+}
+
+void EmbeddingLookUpProxyKernel::InitPrefetcher(size_t row_size) {
+  static const auto staleness_env = common::GetEnv(kEmbeddingStalenessEnv);
+  size_t max_staleness = std::strtoul(staleness_env.c_str(), nullptr, 0);
+  if (max_staleness == 0 || row_size == 0) {
+    return;
   }
+  auto key = key_;
+  prefetcher_ = std::make_shared<mindspore::ps::EmbeddingLookupPrefetcher>(
+    row_size, max_staleness, [key](const std::vector<int> &ids, std::vector<float> *rows) {
+      return mindspore::ps::Worker::GetInstance().DoPSEmbeddingLookup(key, ids, rows,
+                                                                      mindspore::ps::kEmbeddingLookupCmd);
+    });
+  MS_LOG(INFO) << "Prefetch the embedding lookup of key " << key_ << " with max staleness " << max_staleness;
 }
 
 bool EmbeddingLookUpProxyKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -79,6 +106,16 @@ bool EmbeddingLookUpProxyKernel::Launch(const std::vector<kernel::AddressPtr> &i
   size_t output_size = outputs[0]->size;
 
   size_t size = input_size / sizeof(int);
+  if (prefetcher_ != nullptr) {
+    // Use the rows prefetched during the last step, and prefetch the rows of the hot ids for the next step, which
+    // overlaps with the compute and the gradient push of this step.
+    std::vector<int> ids(indices_addr, indices_addr + size);
+    if (!prefetcher_->Lookup(ids, output_addr, output_size / sizeof(float))) {
+      MS_LOG(EXCEPTION) << "DoPSEmbeddingLookup failed.";
+    }
+    prefetcher_->Prefetch(ids);
+    return true;
+  }
   std::vector<int> lookup_ids(size, 0);
   std::vector<float> lookup_result(output_size / sizeof(float), 0);
   auto ret = memcpy_s(lookup_ids.data(), lookup_ids.size() * sizeof(int), indices_addr, input_size);
@@ -20,6 +20,7 @@
 #include "backend/kernel_compiler/cpu/embedding_look_up_cpu_kernel.h"
 #include <vector>
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "ps/embedding_lookup_prefetcher.h"
 
 namespace mindspore {
 namespace kernel {
@@ -35,8 +36,11 @@ class EmbeddingLookUpProxyKernel : public EmbeddingLookUpCPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
+  void InitPrefetcher(size_t row_size);
+
   size_t key_{0};
   size_t input_dims_{1};
+  mindspore::ps::EmbeddingLookupPrefetcherPtr prefetcher_{nullptr};
 };
 
 MS_REG_CPU_KERNEL(
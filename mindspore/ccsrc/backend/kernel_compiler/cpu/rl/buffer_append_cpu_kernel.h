@@ -22,12 +22,13 @@
 #include <algorithm>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/rl/priority_replay_buffer.h"
 
 namespace mindspore {
 namespace kernel {
 class BufferCPUAppendKernel : public CPUKernel {
  public:
-  BufferCPUAppendKernel() : element_nums_(0), exp_batch_(0), capacity_(0) {}
+  BufferCPUAppendKernel() : element_nums_(0), exp_batch_(0), capacity_(0), priority_(false) {}
 
   ~BufferCPUAppendKernel() override = default;
   void Init(const CNodePtr &kernel_node) {
@@ -35,6 +36,9 @@ class BufferCPUAppendKernel : public CPUKernel {
     auto types = AnfAlgo::GetNodeAttr<std::vector<TypePtr>>(kernel_node, "buffer_dtype");
     capacity_ = AnfAlgo::GetNodeAttr<int64_t>(kernel_node, "capacity");
     exp_batch_ = AnfAlgo::GetNodeAttr<int64_t>(kernel_node, "exp_batch");
+    if (AnfAlgo::HasNodeAttr("priority", kernel_node)) {
+      priority_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, "priority");
+    }
     element_nums_ = shapes.size();
     for (size_t i = 0; i < element_nums_; i++) {
       exp_element_list.push_back(shapes[i] * UnitSizeInBytes(types[i]->type_id()));
@@ -50,6 +54,10 @@ class BufferCPUAppendKernel : public CPUKernel {
     // count and head
     input_size_list_.push_back(sizeof(int));
     input_size_list_.push_back(sizeof(int));
+    // the sum tree of the priorities
+    if (priority_) {
+      input_size_list_.push_back(2 * LongToSize(capacity_) * sizeof(float));
+    }
     output_size_list_.push_back(sizeof(int));
   }
 
@@ -89,6 +97,14 @@ class BufferCPUAppendKernel : public CPUKernel {
       }
     };
     ParallelLaunchAutoSearch(task, element_nums_, this, &parallel_search_info_);
+    if (priority_) {
+      // The new experience gets the max priority, only the overwritten slots of the sum tree are updated.
+      SumTree sum_tree(GetDeviceAddress<float>(inputs, 2 * element_nums_ + 2), LongToSize(capacity_));
+      auto max_priority = sum_tree.Max();
+      for (int64_t i = 0; i < exp_batch_; ++i) {
+        sum_tree.Update(LongToSize((index + i) % capacity_), max_priority);
+      }
+    }
     return true;
   }
 
@@ -101,6 +117,7 @@ class BufferCPUAppendKernel : public CPUKernel {
   size_t element_nums_;
   int64_t exp_batch_;
   int64_t capacity_;
+  bool priority_;
   std::vector<size_t> exp_element_list;
 };
 }  // namespace kernel
@@ -16,20 +16,22 @@
 
 #ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RL_BUFFER_SAMPLE_CPU_KERNEL_H_
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RL_BUFFER_SAMPLE_CPU_KERNEL_H_
-#include <stdlib.h>
 #include <memory>
 #include <string>
 #include <vector>
 #include <algorithm>
 #include <random>
+#include <unordered_set>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/rl/priority_replay_buffer.h"
 
 namespace mindspore {
 namespace kernel {
 class BufferCPUSampleKernel : public CPUKernel {
  public:
-  BufferCPUSampleKernel() : element_nums_(0), capacity_(0), batch_size_(0), exp_size_(0), seed_(0), unique_(false) {}
+  BufferCPUSampleKernel()
+      : element_nums_(0), capacity_(0), batch_size_(0), exp_size_(0), seed_(0), unique_(false), priority_(false) {}
 
   ~BufferCPUSampleKernel() override = default;
   void Init(const CNodePtr &kernel_node) {
@@ -38,18 +40,19 @@ class BufferCPUSampleKernel : public CPUKernel {
     capacity_ = AnfAlgo::GetNodeAttr<int64_t>(kernel_node, "capacity");
     seed_ = AnfAlgo::GetNodeAttr<int64_t>(kernel_node, "seed");
     unique_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, "unique");
+    if (AnfAlgo::HasNodeAttr("priority", kernel_node)) {
+      priority_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, "priority");
+    }
     batch_size_ = LongToSize(AnfAlgo::GetNodeAttr<int64_t>(kernel_node, "batch_size"));
     element_nums_ = shapes.size();
     for (size_t i = 0; i < element_nums_; i++) {
       exp_element_list.push_back(shapes[i] * UnitSizeInBytes(types[i]->type_id()));
     }
-    // init seed for random_shuffle and uniform distribution
+    // init seed for the sampling, the generator is owned by the kernel so that kernels run in parallel safely
     if (seed_ == 0) {
-      std::srand(time(nullptr));
-      generator_.seed(time(nullptr));
+      generator_.seed(std::random_device()());
     } else {
-      std::srand(seed_);
-      generator_.seed(seed_);
+      generator_.seed(LongToUlong(seed_));
     }
     // buffer size
     for (auto i : exp_element_list) {
@@ -60,6 +63,11 @@ class BufferCPUSampleKernel : public CPUKernel {
     // count and head
     input_size_list_.push_back(sizeof(int));
     input_size_list_.push_back(sizeof(int));
+    // the sum tree of the priorities, and the sampled indexes for updating their priorities
+    if (priority_) {
+      input_size_list_.push_back(2 * LongToSize(capacity_) * sizeof(float));
+      output_size_list_.push_back(batch_size_ * sizeof(int));
+    }
   }
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &,
@@ -73,21 +81,28 @@ class BufferCPUSampleKernel : public CPUKernel {
                     << std::min(capacity_, IntToLong(count_addr[0]));
     }
     // Generate random indexes
-    // If unique_ == true, use random_shuffle to guarantee the index in generated indexes is unique.
+    // If priority_ == true, sample the indexes in proportion to the priorities set by BufferAppend and
+    // BufferUpdatePriority, and output the indexes as well.
+    // If unique_ == true, use Floyd's algorithm to guarantee the index in generated indexes is unique.
     // If unique_ == false, use a uniform distribution to generate the indexes. Some of the indexes may be repeated.
-    // Case unique_ == false has a better perfomace than case unique_ ==  true.
+    // All of them cost O(batch_size) rather than O(capacity).
     std::vector<size_t> indexes;
-    if (unique_) {
-      for (size_t i = 0; i < IntToSize(count_addr[0]); ++i) {
-        (void)indexes.emplace_back(i);
+    if (priority_) {
+      if (!PrioritySample(inputs, &indexes)) {
+        return false;
       }
-#if !defined(__APPLE__)
-      random_shuffle(indexes.begin(), indexes.end(), [&](int i) { return std::rand() % i; });
-#else
-      std::shuffle(indexes.begin(), indexes.end(), generator_);
-#endif
+    } else if (unique_) {
+      if (batch_size_ > IntToSize(count_addr[0])) {
+        MS_LOG(ERROR) << "The unique batch size " << batch_size_ << " is larger than buffer count " << count_addr[0];
+        return false;
+      }
+      UniqueSample(IntToSize(count_addr[0]), &indexes);
     } else {
-      std::uniform_int_distribution<> distrib(0, count_addr[0]);
+      if (count_addr[0] <= 0) {
+        MS_LOG(ERROR) << "The buffer is empty, BufferAppend should be called first.";
+        return false;
+      }
+      std::uniform_int_distribution<> distrib(0, count_addr[0] - 1);
       for (size_t i = 0; i < batch_size_; ++i) {
         (void)indexes.emplace_back(distrib(generator_));
       }
@@ -109,6 +124,10 @@ class BufferCPUSampleKernel : public CPUKernel {
       }
     };
     ParallelLaunchAutoSearch(task, batch_size_, this, &parallel_search_info_);
+    if (priority_) {
+      auto indexes_addr = GetDeviceAddress<int>(outputs, element_nums_);
+      (void)std::transform(indexes.begin(), indexes.end(), indexes_addr, [](size_t index) { return SizeToInt(index); });
+    }
     return true;
   }
 
@@ -118,12 +137,44 @@ class BufferCPUSampleKernel : public CPUKernel {
   void InitSizeLists() { return; }
 
  private:
+  void UniqueSample(size_t count, std::vector<size_t> *indexes) {
+    // Floyd's algorithm: for each j in [count - batch_size, count), pick t in [0, j], and take j instead if t is
+    // already taken, so every subset of batch_size is equally likely.
+    std::unordered_set<size_t> selected;
+    for (size_t j = count - batch_size_; j < count; ++j) {
+      std::uniform_int_distribution<size_t> distrib(0, j);
+      size_t t = distrib(generator_);
+      size_t index = selected.insert(t).second ? t : j;
+      (void)selected.insert(index);
+      (void)indexes->emplace_back(index);
+    }
+    // The order of Floyd's algorithm is not random, j tends to be at the end.
+    std::shuffle(indexes->begin(), indexes->end(), generator_);
+  }
+
+  bool PrioritySample(const std::vector<AddressPtr> &inputs, std::vector<size_t> *indexes) {
+    SumTree sum_tree(GetDeviceAddress<float>(inputs, element_nums_ + 2), LongToSize(capacity_));
+    float total = sum_tree.Total();
+    if (total <= 0.0f) {
+      MS_LOG(ERROR) << "The priority buffer is empty, BufferAppend with priority should be called first.";
+      return false;
+    }
+    // Stratified sampling, one index from each of the batch_size equal segments of the total priority.
+    float segment = total / batch_size_;
+    std::uniform_real_distribution<float> distrib(0.0f, segment);
+    for (size_t i = 0; i < batch_size_; ++i) {
+      (void)indexes->emplace_back(sum_tree.Find(segment * i + distrib(generator_)));
+    }
+    return true;
+  }
+
   size_t element_nums_;
   int64_t capacity_;
   size_t batch_size_;
   int64_t exp_size_;
   int64_t seed_;
   bool unique_;
+  bool priority_;
   std::mt19937 generator_;
   std::vector<size_t> exp_element_list;
 };
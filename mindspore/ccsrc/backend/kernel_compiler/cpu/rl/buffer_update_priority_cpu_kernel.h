@@ -0,0 +1,68 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RL_BUFFER_UPDATE_PRIORITY_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RL_BUFFER_UPDATE_PRIORITY_CPU_KERNEL_H_
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/rl/priority_replay_buffer.h"
+
+namespace mindspore {
+namespace kernel {
+class BufferCPUUpdatePriorityKernel : public CPUKernel {
+ public:
+  BufferCPUUpdatePriorityKernel() : capacity_(0), batch_size_(0) {}
+
+  ~BufferCPUUpdatePriorityKernel() override = default;
+  void Init(const CNodePtr &kernel_node) {
+    capacity_ = AnfAlgo::GetNodeAttr<int64_t>(kernel_node, "capacity");
+    auto indexes_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 1);
+    batch_size_ = indexes_shape.empty() ? 1 : indexes_shape[0];
+    // the sum tree of the priorities, the indexes and their new priorities
+    input_size_list_.push_back(2 * LongToSize(capacity_) * sizeof(float));
+    input_size_list_.push_back(batch_size_ * sizeof(int));
+    input_size_list_.push_back(batch_size_ * sizeof(float));
+    output_size_list_.push_back(sizeof(int));
+  }
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &, const std::vector<AddressPtr> &) {
+    SumTree sum_tree(GetDeviceAddress<float>(inputs, 0), LongToSize(capacity_));
+    auto indexes_addr = GetDeviceAddress<int>(inputs, 1);
+    auto priorities_addr = GetDeviceAddress<float>(inputs, 2);
+    for (size_t i = 0; i < batch_size_; ++i) {
+      if (indexes_addr[i] < 0 || indexes_addr[i] >= capacity_) {
+        MS_LOG(ERROR) << "The index " << indexes_addr[i] << " is out of the capacity " << capacity_;
+        return false;
+      }
+      sum_tree.Update(IntToSize(indexes_addr[i]), priorities_addr[i]);
+    }
+    return true;
+  }
+
+  void InitKernel(const CNodePtr &kernel_node) { return; }
+
+ protected:
+  void InitSizeLists() { return; }
+
+ private:
+  int64_t capacity_;
+  size_t batch_size_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RL_BUFFER_UPDATE_PRIORITY_CPU_KERNEL_H_
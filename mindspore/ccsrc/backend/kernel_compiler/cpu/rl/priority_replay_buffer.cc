@@ -0,0 +1,63 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/kernel_compiler/cpu/rl/priority_replay_buffer.h"
+#include <algorithm>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+SumTree::SumTree(float *tree, size_t capacity) : tree_(tree), capacity_(capacity) {
+  if (tree == nullptr || capacity == 0) {
+    MS_LOG(EXCEPTION) << "The sum tree should have a positive capacity and its priorities.";
+  }
+}
+
+void SumTree::Update(size_t index, float priority) {
+  if (index >= capacity_) {
+    MS_LOG(EXCEPTION) << "The index " << index << " is out of the capacity " << capacity_;
+  }
+  if (priority < 0.0f) {
+    MS_LOG(EXCEPTION) << "The priority " << priority << " should not be negative.";
+  }
+  tree_[0] = std::max(tree_[0], priority);
+  size_t pos = capacity_ + index;
+  tree_[pos] = priority;
+  for (pos >>= 1; pos > 0; pos >>= 1) {
+    tree_[pos] = tree_[pos << 1] + tree_[(pos << 1) + 1];
+  }
+}
+
+float SumTree::Max() const { return std::max(tree_[0], 1.0f); }
+
+size_t SumTree::Find(float prefix_sum) const {
+  // Every node below capacity has two children, so the descent works for any capacity, the leaves are just met in
+  // a rotated order when it is not a power of two, which keeps the sampling in proportion to the priorities.
+  size_t pos = 1;
+  while (pos < capacity_) {
+    size_t left = pos << 1;
+    // Go left when the rounding error of the sums pushes the prefix sum into a subtree of zero priorities.
+    if (prefix_sum < tree_[left] || tree_[left + 1] <= 0.0f) {
+      pos = left;
+    } else {
+      prefix_sum -= tree_[left];
+      pos = left + 1;
+    }
+  }
+  return pos - capacity_;
+}
+}  // namespace kernel
+}  // namespace mindspore
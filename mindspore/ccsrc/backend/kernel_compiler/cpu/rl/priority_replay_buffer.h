@@ -0,0 +1,50 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RL_PRIORITY_REPLAY_BUFFER_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RL_PRIORITY_REPLAY_BUFFER_H_
+#include <cstddef>
+
+namespace mindspore {
+namespace kernel {
+// The priorities of the replay buffer slots, kept in the float tensor of 2 * capacity elements that BufferAppend,
+// BufferSample and BufferUpdatePriority share as an input. The leaves tree[capacity, 2 * capacity) are the priorities
+// of the slots, the inner node tree[i] is the sum of tree[2i] and tree[2i+1], the root tree[1] is the total and
+// tree[0] keeps the max priority ever set. Updating a priority and finding the slot of a prefix sum are both
+// O(log capacity).
+class SumTree {
+ public:
+  SumTree(float *tree, size_t capacity);
+  ~SumTree() = default;
+
+  void Update(size_t index, float priority);
+  float GetPriority(size_t index) const { return tree_[capacity_ + index]; }
+  float Total() const { return tree_[1]; }
+  // The max priority ever set and at least 1, which is given to the new experience so that it is sampled at least
+  // once.
+  float Max() const;
+  // Find the slot whose priority range contains the prefix sum, only the slots of positive priority are returned.
+  size_t Find(float prefix_sum) const;
+  size_t capacity() const { return capacity_; }
+
+ private:
+  float *tree_;
+  size_t capacity_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_RL_PRIORITY_REPLAY_BUFFER_H_
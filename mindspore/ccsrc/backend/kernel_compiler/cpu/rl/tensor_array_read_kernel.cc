@@ -22,7 +22,8 @@
 namespace mindspore {
 namespace kernel {
 using mindspore::device::TensorArrayMgr;
-using mindspore::device::TensorArrayPtr;
+using mindspore::device::cpu::CPUTensorArray;
+using mindspore::device::cpu::CPUTensorArrayPtr;
 TensorArrayCPUReadKernel::TensorArrayCPUReadKernel() : value_size_(0), type_(nullptr) {}
 
 const std::vector<size_t> &TensorArrayCPUReadKernel::GetInputSizeList() const { return input_size_list_; }
@@ -53,17 +54,16 @@ bool TensorArrayCPUReadKernel::Launch(const std::vector<AddressPtr> &inputs, con
   MS_EXCEPTION_IF_NULL(index);
   MS_EXCEPTION_IF_NULL(out_value);
   int64_t index_host = index[0];
-  TensorArrayPtr tensors_ = TensorArrayMgr::GetInstance().GetTensorArray(handle_addr[0]);
+  CPUTensorArrayPtr tensors_ =
+    std::dynamic_pointer_cast<CPUTensorArray>(TensorArrayMgr::GetInstance().GetTensorArray(handle_addr[0]));
   MS_ERROR_IF_NULL(tensors_);
   if (!tensors_->CheckReadIndexLogical(index_host)) {
     MS_LOG(EXCEPTION) << "Invalid index " << index_host << " for read.";
   }
-  auto value_addr = tensors_->Read(index_host);
   MS_LOG(DEBUG) << "Read value index:" << index_host;
-  auto out_value_size = value_size_;
-  auto ret = memcpy_s(out_value, out_value_size, value_addr->addr, value_size_);
-  if (ret != EOK) {
-    MS_LOG(EXCEPTION) << "Memcpy failed, errorno(" << ret << ")";
+  // Copy under the lock of the TensorArray, which may be appended by the parallel writers.
+  if (!tensors_->ReadValue(index_host, out_value, value_size_)) {
+    MS_LOG(EXCEPTION) << "Failed to read the value of index " << index_host;
   }
   return true;
 }
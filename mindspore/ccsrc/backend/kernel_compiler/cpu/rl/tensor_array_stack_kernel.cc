@@ -24,6 +24,8 @@ namespace mindspore {
 namespace kernel {
 using mindspore::device::TensorArrayMgr;
 using mindspore::device::TensorArrayPtr;
+using mindspore::device::cpu::CPUTensorArray;
+using mindspore::device::cpu::CPUTensorArrayPtr;
 TensorArrayCPUStackKernel::TensorArrayCPUStackKernel() : handle_(0), value_size_(0), ele_size_(0), type_(nullptr) {
   ResetResource();
 }
@@ -79,19 +81,17 @@ bool TensorArrayCPUStackKernel::Launch(const std::vector<AddressPtr> &inputs, co
   MS_EXCEPTION_IF_NULL(out_value);
   MS_EXCEPTION_IF_NULL(handle_addr);
   handle_ = handle_addr[0];
-  TensorArrayPtr tensors_ = TensorArrayMgr::GetInstance().GetTensorArray(handle_);
+  CPUTensorArrayPtr tensors_ =
+    std::dynamic_pointer_cast<CPUTensorArray>(TensorArrayMgr::GetInstance().GetTensorArray(handle_));
   MS_EXCEPTION_IF_NULL(tensors_);
-  if (tensors_->GetValidSize() > tensors_->GetRealSize()) {
-    MS_LOG(EXCEPTION) << "Invalid TensorArray size, maybe should Clear() TensorArray before next usage.";
+  if (tensors_->element_size() != ele_size_) {
+    MS_LOG(EXCEPTION) << "The element size " << tensors_->element_size() << " of the TensorArray is not equal to "
+                      << ele_size_;
   }
-  for (size_t i = 0; i < tensors_->GetValidSize(); i++) {
-    auto out_ele_size = ele_size_;
-    auto src_addr = tensors_->GetTensorAddr(i);
-    MS_EXCEPTION_IF_NULL(src_addr);
-    auto ret = memcpy_s(out_value + ele_size_ * i, out_ele_size, src_addr, ele_size_);
-    if (ret != EOK) {
-      MS_LOG(EXCEPTION) << "Memcpy failed, errorno(" << ret << ")";
-    }
+  // The valid elements lie one after another in the chunks of the TensorArray, so they are stacked by one copy per
+  // chunk.
+  if (!tensors_->StackValues(out_value, outputs[0]->size)) {
+    MS_LOG(EXCEPTION) << "Failed to stack the TensorArray.";
   }
   PostExecute();
   return true;
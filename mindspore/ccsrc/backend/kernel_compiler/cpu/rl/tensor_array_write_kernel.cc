@@ -18,7 +18,6 @@
 #include "backend/kernel_compiler/common_utils.h"
 #include "runtime/device/cpu/cpu_tensor_array.h"
 #include "runtime/device/tensor_array_manager.h"
-#include "runtime/hardware/cpu/cpu_memory_pool.h"
 namespace mindspore {
 namespace kernel {
 constexpr size_t kSecondInputIndex = 2;
@@ -62,22 +61,8 @@ bool TensorArrayCPUWriteKernel::Launch(const std::vector<AddressPtr> &inputs, co
   if (!tensors_->CheckValue(type_, shapes_)) {
     MS_LOG(EXCEPTION) << "Invalid input data for tensor array write op.";
   }
-  // Manage the value : create/reuse a device memory, and copy the input value to it.
-  AddressPtr dev_addr = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(dev_addr);
-  if (tensors_->GetRealSize() > LongToSize(index_host)) {
-    dev_addr->addr = tensors_->Read(index_host)->addr;
-  } else {
-    dev_addr->addr = mindspore::device::cpu::CPUMemoryPool::GetInstance().AllocTensorMem(value_size_);
-    MS_LOG(DEBUG) << "Create tensor " << dev_addr->addr << ", size " << value_size_;
-  }
-  MS_EXCEPTION_IF_NULL(dev_addr->addr);
-  dev_addr->size = value_size_;
-  auto ret = memcpy_s(dev_addr->addr, dev_addr->size, value, value_size_);
-  if (ret != EOK) {
-    MS_LOG(EXCEPTION) << "Memcpy failed, errorno(" << ret << ")";
-  }
-  if (tensors_->Write(index_host, dev_addr)) {
+  // The value is copied into the preallocated chunks of the TensorArray, no memory is allocated per write.
+  if (tensors_->WriteValue(index_host, value, value_size_)) {
     MS_LOG(DEBUG) << "Write to tensorarry succeed, index " << index_host;
   } else {
     MS_LOG(EXCEPTION) << "Failed to write.";
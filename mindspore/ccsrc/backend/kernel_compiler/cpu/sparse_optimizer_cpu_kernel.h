@@ -19,14 +19,19 @@
 
 #include <vector>
 #include <memory>
-#include <unordered_map>
 #include <algorithm>
 #include <utility>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/nnacl/fp32/add_fp32.h"
 #include "common/thread_pool.h"
 namespace mindspore {
 namespace kernel {
+// Use the direct mapped table rather than the hash table to reduce a bucket if the table is at most this times of the
+// bucket size, which is the case of dense indices with many duplicates.
+constexpr size_t kDirectMapTableRatio = 4;
+// The hash table is at least this times of the bucket size to keep the probe sequences short.
+constexpr size_t kHashTableLoadRatio = 2;
 template <typename T>
 struct SparseGradient {
   float *value_{nullptr};
@@ -329,10 +334,67 @@ class SparseOptimizerCPUKernel : public CPUKernel {
       }
       last_index = index;
     }
-    reduced_bucket->indices_size_ = unique_indices_size;
+    reduced_bucket->indices_size_ = sorted_indices.empty() ? 0 : unique_indices_size + 1;
     MS_LOG(DEBUG) << "End";
   }
 
+  static void AccumulateValue(float *reduced_value, const float *value, size_t value_stride) {
+    if (ElementAdd(reduced_value, value, reduced_value, SizeToInt(value_stride)) != NNACL_OK) {
+      MS_LOG(EXCEPTION) << "For 'SparseOptimizer', failed to accumulate the value.";
+    }
+  }
+
+  // Map each index of the bucket to the position of its reduced value, the table is reused by the thread across
+  // buckets and steps.
+  template <typename T>
+  class BucketIndexTable {
+   public:
+    BucketIndexTable(size_t max_index, size_t bucket_num, size_t bucket_size) : bucket_num_(bucket_num) {
+      static thread_local std::vector<size_t> positions;
+      static thread_local std::vector<T> keys;
+      positions_ = &positions;
+      keys_ = &keys;
+      // All the indices of a bucket are congruent modulo bucket_num.
+      size_t direct_map_size = max_index / bucket_num + 1;
+      direct_map_ = direct_map_size <= kDirectMapTableRatio * bucket_size;
+      size_t table_size = direct_map_size;
+      if (!direct_map_) {
+        table_size = 1;
+        while (table_size < kHashTableLoadRatio * bucket_size) {
+          table_size <<= 1;
+        }
+        mask_ = table_size - 1;
+        keys_->assign(table_size, T(-1));
+      }
+      positions_->assign(table_size, SIZE_MAX);
+    }
+    ~BucketIndexTable() = default;
+
+    // Return the position of the index, which is inserted with the new position if it is not in the table yet.
+    size_t &FindOrInsert(T index) {
+      if (direct_map_) {
+        return (*positions_)[LongToSize(index) / bucket_num_];
+      }
+      auto &keys = *keys_;
+      // Fibonacci hashing spreads the consecutive and strided indices evenly.
+      constexpr uint64_t kGoldenRatio = 0x9E3779B97F4A7C15ULL;
+      size_t slot = static_cast<size_t>((static_cast<uint64_t>(index) * kGoldenRatio) >> kHashShift) & mask_;
+      while (keys[slot] != index && keys[slot] != T(-1)) {
+        slot = (slot + 1) & mask_;
+      }
+      keys[slot] = index;
+      return (*positions_)[slot];
+    }
+
+   private:
+    static constexpr size_t kHashShift = 32;
+    size_t bucket_num_;
+    bool direct_map_{false};
+    size_t mask_{0};
+    std::vector<size_t> *positions_{nullptr};
+    std::vector<T> *keys_{nullptr};
+  };
+
   template <typename T>
   static void ReduceBucketSparseGradient(const MultiThreadReduceSparseGradientParam<T> &param,
                                          const std::shared_ptr<BucketSparseGradient<T>> &bucket,
@@ -346,17 +408,16 @@ class SparseOptimizerCPUKernel : public CPUKernel {
     MS_EXCEPTION_IF_NULL(reduced_bucket->indices_);
 
     float *global_value = param.input_grad_->value_;
-    std::unordered_map<T, size_t> index_map;
+    BucketIndexTable<T> index_table(param.max_index_, param.thread_num_, bucket->indices_size_);
     size_t unique_indices_size = 0;
     size_t max_length = reduced_bucket->indices_size_ * param.value_stride_;
     for (size_t i = 0; i < bucket->indices_size_; ++i) {
       T index = bucket->indices_[i];
       T global_index = bucket->global_indices_[i];
-      auto iter = index_map.find(index);
-      if (iter == index_map.end()) {
+      auto &start_index = index_table.FindOrInsert(index);
+      if (start_index == SIZE_MAX) {
         reduced_bucket->indices_[unique_indices_size] = index;
-        size_t start_index = unique_indices_size * param.value_stride_;
-        index_map[index] = start_index;
+        start_index = unique_indices_size * param.value_stride_;
         auto ret_code =
           memcpy_s(reduced_bucket->value_ + start_index, (max_length - start_index) * sizeof(float),
                    global_value + global_index * param.value_stride_, param.value_stride_ * sizeof(float));
@@ -365,11 +426,8 @@ class SparseOptimizerCPUKernel : public CPUKernel {
         }
         unique_indices_size++;
       } else {
-        size_t start_index = iter->second;
-        size_t end_index = start_index + param.value_stride_;
-        for (size_t j = start_index, k = global_index * param.value_stride_; j < end_index; ++j, ++k) {
-          reduced_bucket->value_[j] += global_value[k];
-        }
+        AccumulateValue(reduced_bucket->value_ + start_index, global_value + global_index * param.value_stride_,
+                        param.value_stride_);
       }
     }
     reduced_bucket->indices_size_ = unique_indices_size;
@@ -0,0 +1,119 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/kernel_compiler/kernel_select_cache.h"
+#include <fstream>
+#include "nlohmann/json.hpp"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr char kInputFormats[] = "input_formats";
+constexpr char kInputTypes[] = "input_types";
+constexpr char kOutputFormats[] = "output_formats";
+constexpr char kOutputTypes[] = "output_types";
+
+std::vector<int> TypesToInts(const std::vector<TypeId> &types) {
+  std::vector<int> ints;
+  for (auto type : types) {
+    (void)ints.emplace_back(static_cast<int>(type));
+  }
+  return ints;
+}
+
+std::vector<TypeId> IntsToTypes(const std::vector<int> &ints) {
+  std::vector<TypeId> types;
+  for (auto value : ints) {
+    (void)types.emplace_back(static_cast<TypeId>(value));
+  }
+  return types;
+}
+}  // namespace
+
+bool KernelSelectCache::Find(const std::string &key, KernelSelectInfo *info) const {
+  MS_EXCEPTION_IF_NULL(info);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = infos_.find(key);
+  if (iter == infos_.end()) {
+    return false;
+  }
+  *info = iter->second;
+  return true;
+}
+
+void KernelSelectCache::Insert(const std::string &key, const KernelSelectInfo &info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (infos_.emplace(key, info).second) {
+    changed_ = true;
+  }
+}
+
+bool KernelSelectCache::Load(const std::string &file_path) {
+  std::ifstream fin(file_path);
+  if (!fin.is_open()) {
+    MS_LOG(WARNING) << "Open the kernel selection cache file " << file_path << " failed. The file may not exist.";
+    return false;
+  }
+  nlohmann::json js;
+  std::lock_guard<std::mutex> lock(mutex_);
+  try {
+    fin >> js;
+    for (const auto &item : js.items()) {
+      const auto &value = item.value();
+      KernelSelectInfo info{value.at(kInputFormats).get<std::vector<std::string>>(),
+                            IntsToTypes(value.at(kInputTypes).get<std::vector<int>>()),
+                            value.at(kOutputFormats).get<std::vector<std::string>>(),
+                            IntsToTypes(value.at(kOutputTypes).get<std::vector<int>>())};
+      (void)infos_.emplace(item.key(), std::move(info));
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Parse the kernel selection cache file " << file_path << " failed: " << e.what();
+    fin.close();
+    return false;
+  }
+  fin.close();
+  MS_LOG(INFO) << "Load " << infos_.size() << " kernel selections from " << file_path;
+  return true;
+}
+
+bool KernelSelectCache::Save(const std::string &file_path) {
+  nlohmann::json js;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!changed_) {
+      return true;
+    }
+    for (const auto &item : infos_) {
+      const auto &info = item.second;
+      js[item.first] = {{kInputFormats, info.input_formats},
+                        {kInputTypes, TypesToInts(info.input_types)},
+                        {kOutputFormats, info.output_formats},
+                        {kOutputTypes, TypesToInts(info.output_types)}};
+    }
+    changed_ = false;
+  }
+  std::ofstream fout(file_path);
+  if (!fout.is_open()) {
+    MS_LOG(ERROR) << "Open the kernel selection cache file " << file_path << " failed.";
+    return false;
+  }
+  fout << js.dump();
+  fout.close();
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,67 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_KERNEL_SELECT_CACHE_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_KERNEL_SELECT_CACHE_H_
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include "utils/hash_map.h"
+#include "utils/ms_utils.h"
+#include "ir/dtype/type_id.h"
+
+namespace mindspore {
+namespace kernel {
+// The formats and data types of the kernel build info selected for a kernel.
+struct KernelSelectInfo {
+  std::vector<std::string> input_formats;
+  std::vector<TypeId> input_types;
+  std::vector<std::string> output_formats;
+  std::vector<TypeId> output_types;
+};
+
+// Cache the kernel build info selected for the kernels, keyed by what decides the selection, such as the operator name
+// and the data types of the inputs and outputs. The cache is saved with the compilation cache of the graphs and loaded
+// when the compilation cache is valid, so the kernels are not selected again in the warm start.
+class KernelSelectCache {
+ public:
+  static KernelSelectCache &GetInstance() noexcept {
+    static KernelSelectCache instance;
+    return instance;
+  }
+
+  bool Find(const std::string &key, KernelSelectInfo *info) const;
+  void Insert(const std::string &key, const KernelSelectInfo &info);
+
+  // Load the selections saved by the former run from the json file.
+  bool Load(const std::string &file_path);
+  // Save the selections to the json file if any selection is inserted after the last loading or saving.
+  bool Save(const std::string &file_path);
+
+ private:
+  KernelSelectCache() = default;
+  ~KernelSelectCache() = default;
+  DISABLE_COPY_AND_ASSIGN(KernelSelectCache);
+
+  mindspore::HashMap<std::string, KernelSelectInfo> infos_;
+  bool changed_{false};
+  mutable std::mutex mutex_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_KERNEL_SELECT_CACHE_H_
@@ -29,19 +29,114 @@ constexpr size_t kGBToByte = 1024 << 20;
 // The smallest memory request size, if it is smaller than this size, the device memory request may fail
 // Set experience value to 10M
 const size_t kMinimumAllocMem = 10 << 20;
+constexpr size_t kThreadCacheClassNum = DYNAMIC_MEM_THREAD_CACHE_MAX_SIZE / DYNAMIC_MEM_ALIGN_SIZE;
+// The memory one size class and all the size classes of a thread cache may hold.
+constexpr size_t kThreadCacheClassMaxBytes = 256 << 10;
+constexpr size_t kThreadCacheMaxBytes = 4 << 20;
+constexpr size_t kThreadCacheClassMinCount = 2;
+// The extra idle memory buf taken into an empty size class under the same lock.
+constexpr size_t kThreadCacheRefillCount = 3;
+
+// Thread cache epochs are unique across the pools, so a pool created at the address of a destroyed one is not mixed up.
+std::atomic<uint64_t> thread_cache_epoch_counter{1};
+
+size_t ThreadCacheClassIndex(size_t align_size) { return (align_size - 1) / DYNAMIC_MEM_ALIGN_SIZE; }
+
+size_t ThreadCacheClassSize(size_t class_index) { return (class_index + 1) * DYNAMIC_MEM_ALIGN_SIZE; }
+
+size_t ThreadCacheClassCapacity(size_t class_size) {
+  return std::max(kThreadCacheClassMinCount, kThreadCacheClassMaxBytes / class_size);
+}
+
+class DynamicMemPoolBestFit::ThreadMemCache {
+ public:
+  ThreadMemCache() : bins_(kThreadCacheClassNum) {}
+  ~ThreadMemCache() {
+    // Give the memory back when the thread exits, unless the pool is gone or released its memory meanwhile.
+    auto owner = owner_.lock();
+    if (owner == nullptr) {
+      return;
+    }
+    std::lock_guard<std::mutex> owner_locker(owner->mutex_);
+    auto pool = owner->pool_;
+    if (pool == nullptr || pool->thread_cache_epoch_ != epoch_) {
+      return;
+    }
+    std::lock_guard<std::mutex> locker(pool->mutex_);
+    (void)pool->thread_caches_.erase(this);
+    std::vector<DeviceMemPtr> device_addrs;
+    {
+      std::lock_guard<std::mutex> cache_locker(mutex_);
+      device_addrs = TakeAll();
+    }
+    pool->ReturnCachedBufNoLock(device_addrs);
+  }
+
+  void Reset(const std::shared_ptr<ThreadCacheOwner> &owner, uint64_t epoch) {
+    owner_ = owner;
+    epoch_ = epoch;
+    cached_size_ = 0;
+    for (auto &bin : bins_) {
+      bin.clear();
+    }
+  }
+
+  // The cache lock must be held.
+  std::vector<DeviceMemPtr> TakeAll() {
+    std::vector<DeviceMemPtr> device_addrs;
+    for (auto &bin : bins_) {
+      device_addrs.insert(device_addrs.end(), bin.begin(), bin.end());
+      bin.clear();
+    }
+    cached_size_ = 0;
+    return device_addrs;
+  }
+
+ private:
+  friend class DynamicMemPoolBestFit;
+
+  std::weak_ptr<ThreadCacheOwner> owner_;
+  // Taken by the owner thread and by the pool flushing all the thread caches, never before the pool lock.
+  std::mutex mutex_;
+  uint64_t epoch_{0};
+  size_t cached_size_{0};
+  std::vector<std::vector<DeviceMemPtr>> bins_;
+};
+
+DynamicMemPoolBestFit::DynamicMemPoolBestFit()
+    : persistent_mem_(std::make_shared<MemStatusManager>()),
+      common_mem_(std::make_shared<MemStatusManager>()),
+      thread_cache_epoch_(thread_cache_epoch_counter++),
+      thread_cache_owner_(std::make_shared<ThreadCacheOwner>()) {
+  thread_cache_owner_->pool_ = this;
+}
 
 DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
+  {
+    std::lock_guard<std::mutex> owner_locker(thread_cache_owner_->mutex_);
+    thread_cache_owner_->pool_ = nullptr;
+  }
   persistent_mem_->clear();
   common_mem_->clear();
 }
 
 DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persistent_mem) {
   size_t align_size = AlignMemorySize(size);
+  if (thread_cache_enabled_ && !from_persistent_mem && align_size <= DYNAMIC_MEM_THREAD_CACHE_MAX_SIZE) {
+    return AllocFromThreadCache(align_size);
+  }
   std::lock_guard<std::mutex> locker(mutex_);
+  return AllocTensorMemNoLock(align_size, from_persistent_mem);
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMemNoLock(size_t size, bool from_persistent_mem) {
   // Find the idle memory buf by tensor size, if not find, then add new memory block and memory buf.
-  DeviceMemPtr device_addr = FindIdleMemBuf(align_size, from_persistent_mem);
+  DeviceMemPtr device_addr = FindIdleMemBuf(size, from_persistent_mem);
   if (!device_addr) {
-    device_addr = AddMemBlockAndMemBuf(align_size, from_persistent_mem);
+    device_addr = AddMemBlockAndMemBuf(size, from_persistent_mem);
+  }
+  if (!device_addr && FlushThreadCachesNoLock()) {
+    device_addr = FindIdleMemBuf(size, from_persistent_mem);
   }
   if (!device_addr) {
     DumpDynamicMemPoolInfo();
@@ -49,15 +144,141 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, bool from_persis
   return device_addr;
 }
 
+DynamicMemPoolBestFit::ThreadMemCache &DynamicMemPoolBestFit::LocalThreadCache() {
+  static thread_local std::unordered_map<const DynamicMemPoolBestFit *, ThreadMemCache> thread_caches;
+  static thread_local const DynamicMemPoolBestFit *last_pool = nullptr;
+  static thread_local ThreadMemCache *last_cache = nullptr;
+  ThreadMemCache *cache = last_cache;
+  if (last_pool != this) {
+    cache = &thread_caches[this];
+    last_pool = this;
+    last_cache = cache;
+  }
+  // A released pool invalidates all cached memory.
+  if (cache->epoch_ != thread_cache_epoch_) {
+    std::lock_guard<std::mutex> locker(mutex_);
+    cache->Reset(thread_cache_owner_, thread_cache_epoch_);
+    (void)thread_caches_.insert(cache);
+  }
+  return *cache;
+}
+
+bool DynamicMemPoolBestFit::FlushThreadCachesNoLock() {
+  std::vector<DeviceMemPtr> device_addrs;
+  for (auto cache : thread_caches_) {
+    std::lock_guard<std::mutex> cache_locker(cache->mutex_);
+    auto cached_addrs = cache->TakeAll();
+    device_addrs.insert(device_addrs.end(), cached_addrs.begin(), cached_addrs.end());
+  }
+  ReturnCachedBufNoLock(device_addrs);
+  return !device_addrs.empty();
+}
+
+DynamicMemPoolBestFit::CachedBufShard &DynamicMemPoolBestFit::GetCachedBufShard(const DeviceMemPtr &device_addr) {
+  auto index = (reinterpret_cast<uintptr_t>(device_addr) / DYNAMIC_MEM_ALIGN_SIZE) % kCachedBufShardNum;
+  return cached_buf_shards_[index];
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocFromThreadCache(size_t size) {
+  auto class_index = ThreadCacheClassIndex(size);
+  auto class_size = ThreadCacheClassSize(class_index);
+  auto &cache = LocalThreadCache();
+  {
+    std::lock_guard<std::mutex> cache_locker(cache.mutex_);
+    auto &bin = cache.bins_[class_index];
+    if (!bin.empty()) {
+      auto device_addr = bin.back();
+      bin.pop_back();
+      cache.cached_size_ -= class_size;
+      return device_addr;
+    }
+  }
+  std::vector<DeviceMemPtr> device_addrs;
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    // The memory held by all the thread caches may be combined into a big enough memory buf.
+    auto device_addr = AllocTensorMemNoLock(class_size, false);
+    if (device_addr == nullptr) {
+      return nullptr;
+    }
+    device_addrs.emplace_back(device_addr);
+    // Refill only from the idle memory, never extend the pool for the cache. The cached size only changes under the
+    // pool lock besides the owner thread.
+    size_t refill_count = std::min(kThreadCacheRefillCount, ThreadCacheClassCapacity(class_size) - 1);
+    for (size_t i = 0; i < refill_count && cache.cached_size_ + (i + 1) * class_size <= kThreadCacheMaxBytes; ++i) {
+      device_addr = FindIdleMemBuf(class_size, false);
+      if (device_addr == nullptr) {
+        break;
+      }
+      device_addrs.emplace_back(device_addr);
+    }
+  }
+  for (const auto &device_addr : device_addrs) {
+    auto &shard = GetCachedBufShard(device_addr);
+    std::lock_guard<std::mutex> shard_locker(shard.mutex_);
+    shard.bufs_[device_addr] = class_index;
+  }
+  // The first memory buf goes to the caller, the refilled ones to the cache.
+  std::lock_guard<std::mutex> cache_locker(cache.mutex_);
+  auto &bin = cache.bins_[class_index];
+  bin.insert(bin.end(), device_addrs.rbegin(), device_addrs.rend() - 1);
+  cache.cached_size_ += (device_addrs.size() - 1) * class_size;
+  return device_addrs.front();
+}
+
+bool DynamicMemPoolBestFit::FreeToThreadCache(const DeviceMemPtr &device_addr) {
+  size_t class_index = 0;
+  {
+    auto &shard = GetCachedBufShard(device_addr);
+    std::lock_guard<std::mutex> shard_locker(shard.mutex_);
+    const auto &iter = shard.bufs_.find(device_addr);
+    if (iter == shard.bufs_.end()) {
+      return false;
+    }
+    class_index = iter->second;
+  }
+  auto class_size = ThreadCacheClassSize(class_index);
+  auto &cache = LocalThreadCache();
+  std::vector<DeviceMemPtr> device_addrs = {device_addr};
+  {
+    std::lock_guard<std::mutex> cache_locker(cache.mutex_);
+    auto &bin = cache.bins_[class_index];
+    if (bin.size() < ThreadCacheClassCapacity(class_size) && cache.cached_size_ + class_size <= kThreadCacheMaxBytes) {
+      bin.emplace_back(device_addr);
+      cache.cached_size_ += class_size;
+      return true;
+    }
+    // Return the memory buf with the older half of its size class in one batch.
+    size_t keep_count = bin.size() / 2;
+    device_addrs.insert(device_addrs.end(), bin.begin(), bin.begin() + SizeToLong(bin.size() - keep_count));
+    (void)bin.erase(bin.begin(), bin.begin() + SizeToLong(bin.size() - keep_count));
+    cache.cached_size_ -= (device_addrs.size() - 1) * class_size;
+  }
+  std::lock_guard<std::mutex> locker(mutex_);
+  ReturnCachedBufNoLock(device_addrs);
+  return true;
+}
+
+void DynamicMemPoolBestFit::ReturnCachedBufNoLock(const std::vector<DeviceMemPtr> &device_addrs) {
+  for (const auto &device_addr : device_addrs) {
+    {
+      auto &shard = GetCachedBufShard(device_addr);
+      std::lock_guard<std::mutex> shard_locker(shard.mutex_);
+      (void)shard.bufs_.erase(device_addr);
+    }
+    FreeTensorMemNoLock(device_addr);
+  }
+}
+
 std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(size_t total_size,
                                                                           const std::vector<size_t> &size_list) {
   std::vector<DeviceMemPtr> device_addr_list;
-  // Pre-alloc the one whole piece memory.
-  auto device_addr = AllocTensorMem(total_size, false);
+  std::lock_guard<std::mutex> locker(mutex_);
+  // Pre-alloc the one whole piece memory, it is split below so must not come from the thread cache.
+  auto device_addr = AllocTensorMemNoLock(AlignMemorySize(total_size), false);
   if (!device_addr) {
     return device_addr_list;
   }
-  std::lock_guard<std::mutex> locker(mutex_);
   // Remove the pre-alloc memory.
   auto mem_block = FindMemBlock(device_addr, common_mem_);
   if (mem_block == nullptr) {
@@ -282,7 +503,31 @@ DynamicMemBlockPtr DynamicMemPoolBestFit::FindMemBlock(const DeviceMemPtr &devic
 
 void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
   MS_EXCEPTION_IF_NULL(device_addr);
+  if (thread_cache_enabled_ && FreeToThreadCache(device_addr)) {
+    return;
+  }
+  std::lock_guard<std::mutex> locker(mutex_);
+  FreeTensorMemNoLock(device_addr);
+}
+
+void DynamicMemPoolBestFit::FreeTensorMems(const std::vector<DeviceMemPtr> &device_addrs) {
+  std::vector<DeviceMemPtr> uncached_addrs;
+  for (const auto &device_addr : device_addrs) {
+    MS_EXCEPTION_IF_NULL(device_addr);
+    if (!thread_cache_enabled_ || !FreeToThreadCache(device_addr)) {
+      uncached_addrs.emplace_back(device_addr);
+    }
+  }
+  if (uncached_addrs.empty()) {
+    return;
+  }
   std::lock_guard<std::mutex> locker(mutex_);
+  for (const auto &device_addr : uncached_addrs) {
+    FreeTensorMemNoLock(device_addr);
+  }
+}
+
+void DynamicMemPoolBestFit::FreeTensorMemNoLock(const DeviceMemPtr &device_addr) {
   auto fn = [this](const MemStatusManagerPtr &mem_mng, const DeviceMemPtr &device_addr) -> DynamicMemBlockPtr {
     auto mem_block = FindMemBlock(device_addr, mem_mng);
     if (mem_block != nullptr) {
@@ -378,6 +623,13 @@ void DynamicMemPoolBestFit::EraseIdleMemBuf(size_t size, const DeviceMemPtr &dev
 
 void DynamicMemPoolBestFit::ReleaseDeviceRes() {
   std::lock_guard<std::mutex> locker(mutex_);
+  // The memory held by the thread caches is freed with the blocks below.
+  thread_cache_epoch_ = thread_cache_epoch_counter++;
+  thread_caches_.clear();
+  for (auto &shard : cached_buf_shards_) {
+    std::lock_guard<std::mutex> shard_locker(shard.mutex_);
+    shard.bufs_.clear();
+  }
   auto fn = [this](const MemStatusManagerPtr &mem_mng) {
     for (auto &iter : mem_mng->mem_block_list_) {
       auto &device_addr = iter->device_addr_base_;
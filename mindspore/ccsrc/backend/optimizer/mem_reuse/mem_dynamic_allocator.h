@@ -19,11 +19,15 @@
 
 #include <memory>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include <array>
 #include <algorithm>
 #include <utility>
 #include <thread>
 #include <mutex>
+#include <atomic>
 
 namespace mindspore {
 namespace device {
@@ -38,6 +42,9 @@ static const size_t DYNAMIC_MEM_ALIGN_SIZE = 512;
 // The minimum unit size (1G) of memory block used for dynamic extend.
 static const size_t DYNAMIC_MEM_ALLOC_UNIT_SIZE = 1024 << 20;
 
+// The maximum aligned size (64K) served by the thread cache, one size class per DYNAMIC_MEM_ALIGN_SIZE.
+static const size_t DYNAMIC_MEM_THREAD_CACHE_MAX_SIZE = 64 << 10;
+
 // The Comparator of device address from small to large.
 struct DeviceAddrCmp {
   bool operator()(const DeviceMemPtr &addr1, const DeviceMemPtr &addr2) const { return addr1 < addr2; }
@@ -103,8 +110,7 @@ using MemStatusManagerPtr = std::shared_ptr<MemStatusManager>;
 // The main class of dynamic memory pool.
 class DynamicMemPoolBestFit {
  public:
-  DynamicMemPoolBestFit()
-      : persistent_mem_(std::make_shared<MemStatusManager>()), common_mem_(std::make_shared<MemStatusManager>()) {}
+  DynamicMemPoolBestFit();
   virtual ~DynamicMemPoolBestFit();
 
   // The main program entry of memory alloc.
@@ -113,6 +119,8 @@ class DynamicMemPoolBestFit {
   std::vector<DeviceMemPtr> AllocContinuousTensorMem(size_t total_size, const std::vector<size_t> &size_list);
   // The main program entry of memory free.
   void FreeTensorMem(const DeviceMemPtr &device_addr);
+  // Free a batch of memory under one lock.
+  void FreeTensorMems(const std::vector<DeviceMemPtr> &device_addrs);
 
   // Release the real device memory.
   void ReleaseDeviceRes();
@@ -145,8 +153,39 @@ class DynamicMemPoolBestFit {
   virtual size_t AlignMemorySize(size_t size) const;
   // Calculate memory block required alloc size when adding the memory block.
   virtual size_t CalMemBlockAllocSize(size_t size, bool from_persistent_mem);
+  // Serve the small common memory by size classes from per-thread free caches, which skips the pool lock and the best
+  // fit search for the memory freed and allocated again by the same thread. The memory held by the thread caches is
+  // counted as used, and it is given back to the pool when its thread exits or when an alloc would fail otherwise.
+  // Must be called before the first memory alloc.
+  void EnableThreadCache() { thread_cache_enabled_ = true; }
 
  private:
+  // The free memory buf of the size classes held by one thread for one pool.
+  class ThreadMemCache;
+  // Lets the thread caches find out whether the pool is still alive when the thread exits.
+  struct ThreadCacheOwner {
+    std::mutex mutex_;
+    DynamicMemPoolBestFit *pool_{nullptr};
+  };
+  // The size class of the memory buf owned by the thread caches, sharded by device address.
+  static const size_t kCachedBufShardNum = 64;
+  struct CachedBufShard {
+    std::mutex mutex_;
+    std::unordered_map<DeviceMemPtr, size_t> bufs_;
+  };
+
+  DeviceMemPtr AllocTensorMemNoLock(size_t size, bool from_persistent_mem);
+  void FreeTensorMemNoLock(const DeviceMemPtr &device_addr);
+  // The thread cache of the calling thread for this pool.
+  ThreadMemCache &LocalThreadCache();
+  DeviceMemPtr AllocFromThreadCache(size_t size);
+  // Return false if the memory buf is not owned by the thread caches.
+  bool FreeToThreadCache(const DeviceMemPtr &device_addr);
+  // Give the memory buf of the thread caches back to the pool, the pool lock must be held.
+  void ReturnCachedBufNoLock(const std::vector<DeviceMemPtr> &device_addrs);
+  // Give the memory of all the thread caches back to the pool, return false if there is none.
+  bool FlushThreadCachesNoLock();
+  CachedBufShard &GetCachedBufShard(const DeviceMemPtr &device_addr);
   // Find the idle memory buf by aligned size when memory alloc.
   DeviceMemPtr FindIdleMemBuf(size_t size, bool from_persistent_mem);
   // Add the memory block and memory buf when memory alloc not find the idle memory buf.
@@ -174,6 +213,14 @@ class DynamicMemPoolBestFit {
   // In the graph mode, the unit size set in the context will be modified through the FetchMemUnitSize function, so it
   // needs to be changed back after that
   size_t config_unit_size_{DYNAMIC_MEM_ALLOC_UNIT_SIZE};
+
+  bool thread_cache_enabled_{false};
+  // Renewed when the device memory is released, the thread caches of another epoch are dropped.
+  std::atomic<uint64_t> thread_cache_epoch_{0};
+  std::shared_ptr<ThreadCacheOwner> thread_cache_owner_{nullptr};
+  // The thread caches of the current epoch, guarded by the pool lock.
+  std::unordered_set<ThreadMemCache *> thread_caches_;
+  std::array<CachedBufShard, kCachedBufShardNum> cached_buf_shards_;
 };
 }  // namespace device
 }  // namespace mindspore
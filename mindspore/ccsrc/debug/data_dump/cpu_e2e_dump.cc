@@ -18,6 +18,7 @@
 #include <map>
 #include "backend/session/anf_runtime_algorithm.h"
 #include "debug/anf_ir_utils.h"
+#include "debug/data_dump/tensor_dump_writer.h"
 #include "debug/common.h"
 
 namespace mindspore {
@@ -65,6 +66,8 @@ void CPUE2eDump::DumpRunIter(const KernelGraphPtr &graph, uint32_t rank_id) {
   ChangeFileMode(file_name, S_IRUSR);
 }
 
+void CPUE2eDump::FlushDumpData() { TensorDumpWriter::GetInstance().Flush(); }
+
 void CPUE2eDump::DumpCNodeInputs(const CNodePtr &node, const std::string &dump_path) {
   MS_EXCEPTION_IF_NULL(node);
   std::string kernel_name = GetKernelNodeName(node);
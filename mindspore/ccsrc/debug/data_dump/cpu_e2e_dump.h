@@ -41,6 +41,9 @@ class CPUE2eDump {
 
   static void DumpRunIter(const KernelGraphPtr &graph_ptr, uint32_t rank_id = 0);
 
+  // The tensors are written in the background, wait for them at the end of the step.
+  static void FlushDumpData();
+
  private:
   static void DumpCNodeInputs(const CNodePtr &node, const std::string &dump_path);
 
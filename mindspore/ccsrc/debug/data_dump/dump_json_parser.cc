@@ -15,12 +15,14 @@
  */
 #include "debug/data_dump/dump_json_parser.h"
 #include <fstream>
+#include <utility>
 #include "utils/log_adapter.h"
 #include "debug/common.h"
 #include "utils/ms_context.h"
 #include "utils/convert_utils_base.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "debug/data_dump/npy_header.h"
+#include "debug/data_dump/tensor_dump_writer.h"
 #include "debug/anf_ir_utils.h"
 #include "utils/comm_manager.h"
 
@@ -206,7 +208,7 @@ bool DumpJsonParser::DumpEnabledForIter() const {
 }
 
 bool DumpJsonParser::DumpToFile(const std::string &filename, const void *data, size_t len, const ShapeVector &shape,
-                                TypeId type) {
+                                TypeId type, bool async) {
   if (filename.empty() || data == nullptr || len == 0) {
     MS_LOG(ERROR) << "Incorrect parameter.";
     return false;
@@ -218,6 +220,17 @@ bool DumpJsonParser::DumpToFile(const std::string &filename, const void *data, s
     return false;
   }
   const std::string file_path_str = file_path.value();
+  if (async) {
+    std::string npy_header = GenerateNpyHeader(shape, type);
+    if (npy_header.empty()) {
+      return true;
+    }
+    std::string content;
+    content.reserve(npy_header.size() + len);
+    content.append(npy_header).append(reinterpret_cast<const char *>(data), len);
+    TensorDumpWriter::GetInstance().Write(file_path_str, std::move(content));
+    return true;
+  }
   ChangeFileMode(file_path_str, S_IWUSR);
   std::ofstream fd(file_path_str, std::ios::out | std::ios::trunc | std::ios::binary);
   if (!fd.is_open()) {
@@ -34,8 +34,9 @@ class DumpJsonParser {
   }
 
   void Parse();
+  // With async, the data is copied and written by TensorDumpWriter, which needs to be flushed at the end of the step.
   static bool DumpToFile(const std::string &filename, const void *data, size_t len, const ShapeVector &shape,
-                         TypeId type);
+                         TypeId type, bool async = false);
   void CopyDumpJsonToDir(uint32_t rank_id);
   void CopyHcclJsonToDir(uint32_t rank_id);
   void CopyMSCfgJsonToDir(uint32_t rank_id);
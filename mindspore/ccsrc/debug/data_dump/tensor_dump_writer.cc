@@ -0,0 +1,108 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "debug/data_dump/tensor_dump_writer.h"
+#include <fstream>
+#include <utility>
+#include "utils/utils.h"
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+#include "debug/common.h"
+
+namespace mindspore {
+namespace {
+constexpr size_t kWriterThreadNum = 2;
+constexpr size_t kMaxPendingBytes = 512 << 20;
+}  // namespace
+
+TensorDumpWriter::TensorDumpWriter() {
+  for (size_t i = 0; i < kWriterThreadNum; ++i) {
+    (void)workers_.emplace_back(&TensorDumpWriter::Run, this);
+  }
+}
+
+TensorDumpWriter::~TensorDumpWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  task_cv_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void TensorDumpWriter::Write(const std::string &file_path, std::string &&content) {
+  size_t size = content.size();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // A snapshot larger than the bound is queued once the others are written, or it would wait forever.
+    done_cv_.wait(lock, [this, size]() { return pending_bytes_ == 0 || pending_bytes_ + size <= kMaxPendingBytes; });
+    pending_bytes_ += size;
+    tasks_.push({file_path, std::move(content)});
+  }
+  task_cv_.notify_one();
+}
+
+void TensorDumpWriter::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this]() { return tasks_.empty() && running_num_ == 0; });
+}
+
+void TensorDumpWriter::Run() {
+  while (true) {
+    WriteTask task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      // The tasks left are written before exiting, so no dump file is lost.
+      task_cv_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+      ++running_num_;
+    }
+    WriteFile(task);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_bytes_ -= task.content.size();
+      --running_num_;
+    }
+    done_cv_.notify_all();
+  }
+}
+
+void TensorDumpWriter::WriteFile(const WriteTask &task) {
+  // The exceptions can't be thrown out of the writer threads, so the failures are only logged.
+  ChangeFileMode(task.file_path, S_IWUSR);
+  std::ofstream fd(task.file_path, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!fd.is_open()) {
+    MS_LOG(ERROR) << "Open file " << task.file_path << " failed." << ErrnoToString(errno);
+    return;
+  }
+  (void)fd.write(task.content.data(), SizeToLong(task.content.size()));
+  if (fd.bad()) {
+    fd.close();
+    MS_LOG(ERROR) << "Write mem to file " << task.file_path << " failed.";
+    return;
+  }
+  fd.close();
+  ChangeFileMode(task.file_path, S_IRUSR);
+}
+}  // namespace mindspore
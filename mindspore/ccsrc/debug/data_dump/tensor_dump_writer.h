@@ -0,0 +1,67 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_MINDSPORE_CCSRC_DEBUG_DATA_DUMP_TENSOR_DUMP_WRITER_H_
+#define MINDSPORE_MINDSPORE_CCSRC_DEBUG_DATA_DUMP_TENSOR_DUMP_WRITER_H_
+
+#include <string>
+#include <queue>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+// Write the dump files in the background so that the kernels don't wait for the disk. The caller snapshots the
+// tensor into the content, and the snapshots pending are bounded by kMaxPendingBytes, beyond which the caller blocks
+// until the writers catch up.
+class TensorDumpWriter {
+ public:
+  static TensorDumpWriter &GetInstance() {
+    static TensorDumpWriter instance;
+    return instance;
+  }
+  ~TensorDumpWriter();
+  DISABLE_COPY_AND_ASSIGN(TensorDumpWriter)
+
+  // The file_path is the real path, and the file is read only after written.
+  void Write(const std::string &file_path, std::string &&content);
+  // Wait until all the files written before are on the disk, e.g. at the end of the step.
+  void Flush();
+
+ private:
+  struct WriteTask {
+    std::string file_path;
+    std::string content;
+  };
+
+  TensorDumpWriter();
+  void Run();
+  static void WriteFile(const WriteTask &task);
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable task_cv_;
+  std::condition_variable done_cv_;
+  std::queue<WriteTask> tasks_;
+  // The bytes of the tasks queued or being written.
+  size_t pending_bytes_{0};
+  size_t running_num_{0};
+  bool stop_{false};
+};
+}  // namespace mindspore
+#endif  // MINDSPORE_MINDSPORE_CCSRC_DEBUG_DATA_DUMP_TENSOR_DUMP_WRITER_H_
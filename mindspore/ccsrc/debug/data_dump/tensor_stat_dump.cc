@@ -83,9 +83,9 @@ void CsvWriter::CloseFile() {
 template <typename T>
 void CsvWriter::WriteToCsv(const T &val, bool end_line) {
   file_ << val;
+  // The rows are flushed when the file is closed, flushing every row stalls the dump on the disk.
   if (end_line) {
     file_ << kEndLine;
-    file_.flush();
   } else {
     file_ << kSeparator;
   }
@@ -18,6 +18,7 @@
 #define MIINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_DATA_H_
 
 #include <map>
+#include <future>
 #include <memory>
 #include <vector>
 #include <string>
@@ -79,6 +80,10 @@ class PersistentData : public Data<T> {
   // In disaster recovery mode, memory of tensor need to be saved into disk file periodically.
   void Persist(const storage::DirtyInfo &dirty_info) const;
 
+  // Persist the memory of tensor in the background, the memory can be modified once this returns, and the returned
+  // future gets ready when the data is saved into disk file.
+  std::shared_future<void> PersistAsync(const storage::DirtyInfo &dirty_info) const;
+
   // In disaster recovery mode, server node or worker node need to restore persistent data when restart.
   void Restore() const;
 
@@ -103,6 +108,14 @@ void PersistentData<T>::Persist(const storage::DirtyInfo &dirty_info) const {
   storage_->Write(input, dirty_info);
 }
 
+template <typename T>
+std::shared_future<void> PersistentData<T>::PersistAsync(const storage::DirtyInfo &dirty_info) const {
+  MS_EXCEPTION_IF_NULL(storage_);
+  std::vector<storage::InputData> inputs = {
+    std::make_tuple(*Data<T>::shape_, Data<T>::data(), Data<T>::size() * sizeof(T))};
+  return storage_->WriteAsync(inputs, dirty_info);
+}
+
 template <typename T>
 void PersistentData<T>::Restore() const {
   storage::OutputData output = std::make_pair(Data<T>::data(), Data<T>::size() * sizeof(T));
@@ -28,6 +28,12 @@ void Block::GenSha256Seq() const {
   block_meta_->Insert(kHashSeq, sha256_cal);
 }
 
+void Block::GenSha256Seq(const std::string &content) const {
+  std::string sha256_cal = system::sha256::GetHashFromString(content);
+  MS_EXCEPTION_IF_NULL(block_meta_);
+  block_meta_->Insert(kHashSeq, sha256_cal);
+}
+
 bool Block::CheckSha256Seq() const {
   MS_EXCEPTION_IF_NULL(block_meta_);
   std::string sha256_gen = block_meta_->Get<std::string>(kHashSeq);
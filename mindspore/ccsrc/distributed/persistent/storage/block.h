@@ -41,6 +41,8 @@ class Block {
   // The following two methods are used to file integrity check.
   // Generate sha256 hash sequence.
   void GenSha256Seq() const;
+  // Generate sha256 hash sequence from the content written to the block file, without reading the file back.
+  void GenSha256Seq(const std::string &content) const;
 
   // Check sha256 hash sequence.
   bool CheckSha256Seq() const;
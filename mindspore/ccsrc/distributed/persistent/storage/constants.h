@@ -33,6 +33,9 @@ constexpr char kBlockMetaFilePrefix[] = "block_meta_";
 constexpr char kJsonSuffix[] = ".json";
 constexpr size_t JSON_SUFFIX_LENS = 5;
 
+// The maximum number of threads writing the block files of a persistence.
+constexpr size_t kMaxPersistThreadNum = 8;
+
 // Storage config related.
 constexpr char kFileStoragePath[] = "file_storage_path";
 constexpr char kMaxBlockLength[] = "max_block_length";
@@ -17,6 +17,7 @@
 #include "distributed/persistent/storage/file_io_utils.h"
 
 #include <dirent.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <fstream>
 
@@ -117,6 +118,25 @@ bool FileIOUtils::Read(const std::string &file_name, const std::vector<std::pair
   return true;
 }
 
+bool FileIOUtils::Sync(const std::vector<std::string> &file_names) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (const auto &file_name : file_names) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(ERROR) << "Open file failed, file name: " << file_name << ", errno: " << errno;
+      return false;
+    }
+    int ret = fsync(fd);
+    (void)close(fd);
+    if (ret != 0) {
+      MS_LOG(ERROR) << "Sync file failed, file name: " << file_name << ", errno: " << errno;
+      return false;
+    }
+  }
+#endif
+  return true;
+}
+
 bool FileIOUtils::IsFileOrDirExist(const std::string &path) {
   if (path.empty()) {
     MS_LOG(EXCEPTION) << "The path name is empty";
@@ -34,6 +34,9 @@ class FileIOUtils {
   // Read file and load the context into memory buffer, return false if the file is not exist.
   static bool Read(const std::string &file_name, const std::vector<std::pair<void *, size_t>> &outputs);
 
+  // Flush the data of the files to disk, return false if any file fails.
+  static bool Sync(const std::vector<std::string> &file_names);
+
   // Judeg whether a file exists.
   static bool IsFileOrDirExist(const std::string &file);
 
@@ -44,6 +44,9 @@ class JsonUtils {
   template <typename T>
   void Insert(const std::string &key, const T &value);
 
+  // Get the json file path.
+  const std::string &file_name() const { return file_name_; }
+
  private:
   // Json object.
   nlohmann::json js_;
@@ -19,7 +19,9 @@
 #include <dirent.h>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
 #include <numeric>
+#include <thread>
 #include <tuple>
 #include <utility>
 
@@ -32,29 +34,57 @@
 namespace mindspore {
 namespace distributed {
 namespace storage {
+LocalFile::~LocalFile() {
+  try {
+    WaitPersist();
+  } catch (const std::exception &e) {
+    MS_LOG(ERROR) << "Persist to [" << file_path_ << "] failed: " << e.what();
+  }
+}
+
 void LocalFile::Write(const InputData &input, const DirtyInfo &dirty_info) {
   std::vector<InputData> inputs = {input};
   Write(inputs, dirty_info);
 }
 
 void LocalFile::Write(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info) {
+  WriteAsync(inputs, dirty_info).get();
+}
+
+std::shared_future<void> LocalFile::WriteAsync(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info) {
   if (inputs.empty()) {
     MS_LOG(EXCEPTION) << "The inputs is empty";
   }
+  WaitPersist();
 
-  // The block file has been created, only the blocks related to the dirty information need to be rewritten.
+  std::vector<int> block_indices;
   if (finish_create_block_files_) {
-    std::vector<int> block_indices;
+    // The block file has been created, only the blocks related to the dirty information need to be rewritten.
     TransformDirtyInfoToBlockIndices(dirty_info, &block_indices);
+    std::sort(block_indices.begin(), block_indices.end());
+    block_indices.erase(std::unique(block_indices.begin(), block_indices.end()), block_indices.end());
+  } else {
+    // Create block files and write inputs_data to block files.
+    CreateBlockFiles(inputs);
+    block_indices.resize(block_list_.size());
+    std::iota(block_indices.begin(), block_indices.end(), 0);
+  }
 
-    for (const auto &block_index : block_indices) {
-      WriteOneBlockFile(block_index, inputs);
-    }
-    return;
+  // Only the blocks to be rewritten are copied, so the inputs can be modified during the persistence.
+  auto snapshots = std::make_shared<std::vector<std::pair<size_t, std::string>>>();
+  for (auto block_index : block_indices) {
+    (void)snapshots->emplace_back(IntToSize(block_index), SnapshotBlock(IntToSize(block_index), inputs));
   }
+  persist_future_ = std::async(std::launch::async, [this, snapshots]() { WriteBlockFiles(*snapshots); }).share();
+  return persist_future_;
+}
 
-  // Create block files and write inputs_data to block files.
-  WriteBlockFiles(inputs);
+void LocalFile::WaitPersist() {
+  if (!persist_future_.valid()) {
+    return;
+  }
+  auto persist_future = std::move(persist_future_);
+  persist_future.get();
 }
 
 void LocalFile::TransformDirtyInfoToBlockIndices(const DirtyInfo &dirty_info, std::vector<int> *block_indices) const {
@@ -95,7 +125,7 @@ void LocalFile::TransformDirtyInfoToBlockIndices(const DirtyInfo &dirty_info, st
   }
 }
 
-void LocalFile::WriteBlockFiles(const std::vector<InputData> &inputs) {
+void LocalFile::CreateBlockFiles(const std::vector<InputData> &inputs) {
   if (inputs.empty()) {
     MS_LOG(EXCEPTION) << "The inputs is empty";
   }
@@ -148,29 +178,69 @@ void LocalFile::WriteBlockFiles(const std::vector<InputData> &inputs) {
   }
 
   finish_create_block_files_ = true;
-
-  // Write inputs_data to block files and Gen Sha256 seq.
-  for (size_t block_index = 0; block_index < block_num; ++block_index) {
-    WriteOneBlockFile(block_index, inputs);
-  }
 }
 
-void LocalFile::WriteOneBlockFile(size_t block_index, const std::vector<InputData> &inputs) const {
+std::string LocalFile::SnapshotBlock(size_t block_index, const std::vector<InputData> &inputs) const {
   const auto &block_meta_ptr = block_meta_list_.at(block_index);
   MS_EXCEPTION_IF_NULL(block_meta_ptr);
   size_t field_size = block_meta_ptr->Get<size_t>(kFieldsLength);
   size_t offset = block_meta_ptr->Get<size_t>(kOffset);
-  std::vector<std::pair<const void *, size_t>> block_inputs_data;
+  std::string snapshot;
+  snapshot.reserve(field_size * inputs.size());
 
   for (size_t input_index = 0; input_index < inputs.size(); ++input_index) {
-    const void *data_ptr = reinterpret_cast<const char *>(std::get<1>(inputs.at(input_index))) + offset;
-    size_t data_size = field_size;
-    block_inputs_data.emplace_back(data_ptr, data_size);
+    const char *data_ptr = reinterpret_cast<const char *>(std::get<1>(inputs.at(input_index))) + offset;
+    (void)snapshot.append(data_ptr, field_size);
+  }
+  return snapshot;
+}
+
+void LocalFile::WriteBlockFiles(const std::vector<std::pair<size_t, std::string>> &snapshots) const {
+  size_t thread_num = std::min({snapshots.size(), kMaxPersistThreadNum,
+                                std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t(1))});
+  std::atomic<size_t> next_index{0};
+  std::atomic<bool> success{true};
+  auto write_task = [this, &snapshots, &next_index, &success]() {
+    for (size_t i = next_index++; i < snapshots.size(); i = next_index++) {
+      try {
+        WriteOneBlockFile(snapshots[i].first, snapshots[i].second);
+      } catch (const std::exception &e) {
+        MS_LOG(ERROR) << e.what();
+        success = false;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_num; ++i) {
+    (void)threads.emplace_back(write_task);
+  }
+  write_task();
+  for (auto &thread : threads) {
+    thread.join();
   }
+  if (!success) {
+    MS_LOG(EXCEPTION) << "Write block files to [" << file_path_ << "] failed.";
+  }
+
+  // Sync all the block files of this persistence once, instead of waiting for the disk after every block. The block
+  // meta files holding the ranges and hashes are synced in the same batch, so they match the synced blocks.
+  std::vector<std::string> file_names;
+  for (const auto &snapshot : snapshots) {
+    (void)file_names.emplace_back(block_list_.at(snapshot.first)->block_file_name());
+    const auto &block_meta_ptr = block_meta_list_.at(snapshot.first);
+    MS_EXCEPTION_IF_NULL(block_meta_ptr);
+    (void)file_names.emplace_back(block_meta_ptr->file_name());
+  }
+  if (!FileIOUtils::Sync(file_names)) {
+    MS_LOG(EXCEPTION) << "Sync block files and block meta files to [" << file_path_ << "] failed.";
+  }
+}
 
+void LocalFile::WriteOneBlockFile(size_t block_index, const std::string &snapshot) const {
   const auto &block_ptr = block_list_.at(block_index);
   MS_EXCEPTION_IF_NULL(block_ptr);
   // Rewrite the current block file.
+  std::vector<std::pair<const void *, size_t>> block_inputs_data = {{snapshot.data(), snapshot.size()}};
   if (!FileIOUtils::Write(block_ptr->block_file_name(), block_inputs_data)) {
     MS_LOG(EXCEPTION) << "Write to block file[" << block_ptr->block_file_name() << "] failed.";
   }
@@ -178,7 +248,7 @@ void LocalFile::WriteOneBlockFile(size_t block_index, const std::vector<InputDat
   ChangeFileMode(block_ptr->block_file_name(), S_IRWXU | S_IRWXG | S_IRWXO);
 
   // Generate sha256 hash sequence.
-  block_ptr->GenSha256Seq();
+  block_ptr->GenSha256Seq(snapshot);
 }
 
 void LocalFile::Read(const OutputData &output) {
@@ -187,6 +257,7 @@ void LocalFile::Read(const OutputData &output) {
 }
 
 void LocalFile::Read(const std::vector<OutputData> &outputs) {
+  WaitPersist();
   if (block_list_.empty() || block_meta_list_.empty()) {
     // Load file list info of block files and block meta files in the current folder to block list and block meta list.
     if (!LoadBlocksInfo()) {
@@ -18,8 +18,10 @@
 #define MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_LOCAL_FILE_H_
 
 #include <map>
+#include <future>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "distributed/persistent/storage/storage.h"
@@ -49,7 +51,7 @@ class LocalFile : public StorageBase {
     }
   }
 
-  ~LocalFile() override = default;
+  ~LocalFile() override;
 
   // The following two methods are override version function for Write:
   // 1. Create blocks and block metas.
@@ -59,6 +61,11 @@ class LocalFile : public StorageBase {
   // Write the entire blob data composed of multiple tensors to the block files on disk:
   void Write(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info = {}) override;
 
+  // Copy the data of the blocks to be rewritten from the inputs, then write the copies to the block files and generate
+  // sha256 in parallel in the background, and sync the block and meta files in a batch at last. The next persistence
+  // waits for the former one, so a block file is written by one thread at a time.
+  std::shared_future<void> WriteAsync(const std::vector<InputData> &inputs, const DirtyInfo &dirty_info = {}) override;
+
   // The following two methods are override version function for Read:
   // 1.Tamper proof check.
   // 2.Read all block files and merge them into contiguous memory.
@@ -68,11 +75,20 @@ class LocalFile : public StorageBase {
   void Read(const std::vector<OutputData> &outputs) override;
 
  private:
-  // Create blocks and block metas and write input data to block files.
-  void WriteBlockFiles(const std::vector<InputData> &inputs);
+  // Create blocks and block metas.
+  void CreateBlockFiles(const std::vector<InputData> &inputs);
+
+  // Copy the shardding data of one specific block from the inputs, which is the content of the block file.
+  std::string SnapshotBlock(size_t block_index, const std::vector<InputData> &inputs) const;
+
+  // Write the copied data of the blocks to the block files in parallel and sync them with their meta files to disk.
+  void WriteBlockFiles(const std::vector<std::pair<size_t, std::string>> &snapshots) const;
 
-  // Write shardding data to one specific block file by block index and generate sha256.
-  void WriteOneBlockFile(size_t block_index, const std::vector<InputData> &inputs) const;
+  // Write the copied data to one specific block file by block index and generate sha256.
+  void WriteOneBlockFile(size_t block_index, const std::string &snapshot) const;
+
+  // Wait for the persistence running in the background.
+  void WaitPersist();
 
   // Obtain the corresponding file block index according to dirty info, only need to rewrite these file blocks, and
   // dirty info needs to be sorted in ascending order.
@@ -96,6 +112,9 @@ class LocalFile : public StorageBase {
 
   // Indicates whether block files has been created.
   bool finish_create_block_files_{false};
+
+  // The persistence running in the background.
+  std::shared_future<void> persist_future_;
 };
 }  // namespace storage
 }  // namespace distributed
@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_DISTRIBUTED_PERSISTENT_STORAGE_STORAGE_H_
 
 #include <map>
+#include <future>
 #include <string>
 #include <vector>
 #include <tuple>
@@ -53,6 +54,15 @@ class StorageBase {
   // The parameter dirty_info is optional, indicating that the part of the Tensor that needs to be rewritten to storage.
   virtual void Write(const std::vector<InputData> &input, const DirtyInfo &dirty_info = {}) {}
 
+  // Write input to storage medium or memory buffer in the background. The input can be modified once this returns,
+  // and the returned future gets ready when the input has been persisted.
+  virtual std::shared_future<void> WriteAsync(const std::vector<InputData> &input, const DirtyInfo &dirty_info = {}) {
+    Write(input, dirty_info);
+    std::promise<void> promise;
+    promise.set_value();
+    return promise.get_future().share();
+  }
+
   // Read data from the storage medium or memory buffer and merge them into contiguous memory.
   virtual void Read(const OutputData &output) {}
 
@@ -25,8 +25,6 @@
 namespace mindspore {
 namespace distributed {
 namespace rpc {
-std::mutex Connection::conn_mutex;
-
 // Handle socket events like read/write.
 void SocketEventHandler(int fd, uint32_t events, void *context) {
   Connection *conn = reinterpret_cast<Connection *>(context);
@@ -116,6 +114,7 @@ Connection::Connection()
       state(kInit),
       send_event_loop(nullptr),
       recv_event_loop(nullptr),
+      conn_pool(nullptr),
       send_metrics(new SendMetrics()),
       send_message(nullptr),
       recv_message(nullptr),
@@ -254,11 +253,19 @@ int Connection::ReceiveMessage(IOMgr::MessageHandler msgHandler) {
       destination = fromUrl.substr(index + 1);
       MS_LOG(INFO) << "Create new connection fd: " << socket_fd << " to: " << destination.c_str();
 
-      Connection::conn_mutex.lock();
-      ConnectionPool::GetConnectionPool()->SetConnPriority(destination, false, ConnectionPriority::kPriorityLow);
+      MS_EXCEPTION_IF_NULL(conn_pool);
+      std::lock_guard<std::mutex> lock(conn_pool->mutex_);
       state = ConnectionState::kConnected;
-      ConnectionPool::GetConnectionPool()->AddConnection(this);
-      Connection::conn_mutex.unlock();
+      // This connection is handled by the event loop of the peer host. If the peer advertises another host, e.g. of
+      // another network card, keep it out of the pool which is operated by the event loop of that host, and only
+      // receive messages from it.
+      if (ConnectionPool::GetConnectionPool(destination) == conn_pool) {
+        conn_pool->SetConnPriority(destination, false, ConnectionPriority::kPriorityLow);
+        conn_pool->AddConnection(this);
+      } else {
+        MS_LOG(INFO) << "Receive only connection fd: " << socket_fd << ", peer: " << peer << ", to: " << destination;
+        deleted = true;
+      }
     }
   }
   std::unique_ptr<MessageBase> msg(recv_message);
@@ -274,7 +281,8 @@ int Connection::ReceiveMessage(IOMgr::MessageHandler msgHandler) {
 }
 
 void Connection::CheckMessageType() {
-  std::lock_guard<std::mutex> lock(Connection::conn_mutex);
+  MS_EXCEPTION_IF_NULL(conn_pool);
+  std::lock_guard<std::mutex> lock(conn_pool->mutex_);
   if (recv_message_type != ParseType::kUnknown) {
     return;
   }
@@ -98,6 +98,8 @@ struct SendMetrics {
 /*
  * Represents a TCP or SSL connection.
  */
+class ConnectionPool;
+
 struct Connection {
  public:
   Connection();
@@ -163,6 +165,10 @@ struct Connection {
   EventLoop *send_event_loop;
   EventLoop *recv_event_loop;
 
+  // The pool of the event loops above, whose mutex guards this connection. It is set when the connection is created
+  // or accepted, since the destination of an accepted connection is unknown until its first message arrives.
+  ConnectionPool *conn_pool;
+
   // Collects data sending metrics.
   SendMetrics *send_metrics;
 
@@ -209,8 +215,6 @@ struct Connection {
   // The error code when sending or receiving messages.
   int error_code;
 
-  static std::mutex conn_mutex;
-
  private:
   // Add handler for socket connect event.
   int AddConnnectEventHandler();
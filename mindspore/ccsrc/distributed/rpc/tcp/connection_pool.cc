@@ -15,13 +15,14 @@
  */
 
 #include <mutex>
+#include <cstdlib>
+#include <algorithm>
+#include <functional>
 #include "distributed/rpc/tcp/connection_pool.h"
 
 namespace mindspore {
 namespace distributed {
 namespace rpc {
-ConnectionPool *ConnectionPool::conn_pool = new ConnectionPool();
-
 void ConnectionPool::SetLinkPattern(bool linkPattern) { double_link_ = linkPattern; }
 
 void ConnectionPool::CloseConnection(Connection *conn) {
@@ -36,10 +37,11 @@ void ConnectionPool::CloseConnection(Connection *conn) {
   }
 
   if (!conn->destination.empty()) {
-    if (conn->is_remote) {
-      remote_conns_.erase(conn->destination);
-    } else {
-      local_conns_.erase(conn->destination);
+    // The connection which is not kept in this pool shouldn't remove the one to the same destination.
+    auto &conns = conn->is_remote ? remote_conns_ : local_conns_;
+    auto iter = conns.find(conn->destination);
+    if (iter != conns.end() && iter->second == conn) {
+      (void)conns.erase(iter);
     }
   }
   conn->Close();
@@ -300,7 +302,52 @@ ConnectionPool::~ConnectionPool() {
   }
 }
 
-ConnectionPool *ConnectionPool::GetConnectionPool() { return ConnectionPool::conn_pool; }
+size_t ConnectionPool::GetPoolNum() {
+  static const size_t pool_num = []() {
+    int pool_num = EVLOOP_NUM_DEFAULT;
+    char *env = getenv("LITERPC_EVLOOP_NUM");
+    if (env != nullptr) {
+      try {
+        pool_num = std::stoi(env);
+      } catch (const std::exception &e) {
+        MS_LOG(WARNING) << "Invalid LITERPC_EVLOOP_NUM: " << env << ", use the default " << EVLOOP_NUM_DEFAULT;
+      }
+    }
+    return static_cast<size_t>(std::min(std::max(pool_num, 1), EVLOOP_NUM_MAX));
+  }();
+  return pool_num;
+}
+
+size_t ConnectionPool::GetPoolIndex(const std::string &url) {
+  // The url is in the format of [tcp://]ip:port, both the accepted connection from a peer and the connection to the
+  // server of the peer are in the pool of the peer host.
+  std::string host = url;
+  size_t index = host.find(URL_PROTOCOL_IP_SEPARATOR);
+  if (index != std::string::npos) {
+    host = host.substr(index + sizeof(URL_PROTOCOL_IP_SEPARATOR) - 1);
+  }
+  index = host.rfind(URL_IP_PORT_SEPARATOR);
+  if (index != std::string::npos) {
+    host = host.substr(0, index);
+  }
+  return std::hash<std::string>()(host) % GetPoolNum();
+}
+
+const std::vector<ConnectionPool *> &ConnectionPool::GetConnectionPools() {
+  // The pools live until the process exits, as the connections may be closed by the event loops till then.
+  static const std::vector<ConnectionPool *> conn_pools = []() {
+    std::vector<ConnectionPool *> pools;
+    for (size_t i = 0; i < GetPoolNum(); ++i) {
+      pools.push_back(new ConnectionPool());
+    }
+    return pools;
+  }();
+  return conn_pools;
+}
+
+ConnectionPool *ConnectionPool::GetConnectionPool(const std::string &to) {
+  return GetConnectionPools()[GetPoolIndex(to)];
+}
 }  // namespace rpc
 }  // namespace distributed
 }  // namespace mindspore
@@ -20,6 +20,8 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
+#include <mutex>
 
 #include "distributed/rpc/tcp/constants.h"
 #include "distributed/rpc/tcp/connection.h"
@@ -36,14 +38,20 @@ struct ConnectionInfo {
 
 /*
  * Maintains a collection of reusable connections.
+ * The connections are sharded to several pools by the host of the destination, each pool is guarded by its own
+ * mutex and served by its own event loops, so the connections to different hosts are operated in parallel.
  */
 class ConnectionPool {
  public:
   ConnectionPool() : double_link_(false) {}
   ~ConnectionPool();
 
-  // Get the singleton instance of ConnectionPool.
-  static ConnectionPool *GetConnectionPool();
+  // Get the pool keeping the connections to the destination.
+  static ConnectionPool *GetConnectionPool(const std::string &to);
+  static const std::vector<ConnectionPool *> &GetConnectionPools();
+  // The index of the pool for the url, which is hashed by the host in it.
+  static size_t GetPoolIndex(const std::string &url);
+  static size_t GetPoolNum();
 
   /*
    * Operations for ConnectionInfo.
@@ -95,7 +103,8 @@ class ConnectionPool {
   // each to_url has two fds at most, and each fd has multiple linkinfos
   std::map<int, std::set<ConnectionInfo *>> conn_infos_;
 
-  static ConnectionPool *conn_pool;
+  // Guard the connections in this pool and their sending states.
+  std::mutex mutex_;
 
   friend class Connection;
   friend class TCPComm;
@@ -70,8 +70,13 @@ static const int SOCKET_KEEPCOUNT = 3;
 static const char RPC_MAGICID[] = "BUS0";
 static const char URL_PROTOCOL_IP_SEPARATOR[] = "://";
 static const char URL_IP_PORT_SEPARATOR[] = ":";
-static const char TCP_RECV_EVLOOP_THREADNAME[] = "RECV_EVENT_LOOP";
-static const char TCP_SEND_EVLOOP_THREADNAME[] = "SEND_EVENT_LOOP";
+// The thread names are suffixed by the index of the event loop, in 15 characters at most.
+static const char TCP_RECV_EVLOOP_THREADNAME[] = "RECV_EVLOOP_";
+static const char TCP_SEND_EVLOOP_THREADNAME[] = "SEND_EVLOOP_";
+
+// The number of the read and write event loop pairs, which can be set by the env LITERPC_EVLOOP_NUM.
+constexpr int EVLOOP_NUM_DEFAULT = 4;
+constexpr int EVLOOP_NUM_MAX = 64;
 
 constexpr int RPC_ERROR = -1;
 constexpr int RPC_OK = 0;
@@ -19,6 +19,7 @@
 #include <mutex>
 #include <utility>
 #include <memory>
+#include <string>
 
 #include "actor/aid.h"
 #include "actor/msg.h"
@@ -31,7 +32,7 @@ namespace distributed {
 namespace rpc {
 bool TCPComm::is_http_msg_ = false;
 std::vector<char> TCPComm::advertise_url_;
-uint64_t TCPComm::output_buf_size_ = 0;
+std::atomic<uint64_t> TCPComm::output_buf_size_{0};
 
 IOMgr::MessageHandler TCPComm::message_handler_;
 
@@ -100,7 +101,7 @@ void OnAccept(int server, uint32_t events, void *arg) {
     return;
   }
   TCPComm *tcpmgr = reinterpret_cast<TCPComm *>(arg);
-  if (tcpmgr->recv_event_loop_ == nullptr) {
+  if (tcpmgr->recv_event_loops_.empty()) {
     MS_LOG(ERROR) << "EventLoop is null, server fd: " << server << ", events: " << events;
     return;
   }
@@ -137,8 +138,11 @@ void OnAccept(int server, uint32_t events, void *arg) {
   conn->peer = SocketOperation::GetPeer(acceptFd);
 
   conn->is_remote = true;
-  conn->recv_event_loop = tcpmgr->recv_event_loop_;
-  conn->send_event_loop = tcpmgr->send_event_loop_;
+  // The peer is unknown until its first message arrives, so hash the connection by the peer host, the same as the
+  // connection to the server of the peer.
+  conn->recv_event_loop = tcpmgr->GetRecvEventLoop(conn->peer);
+  conn->send_event_loop = tcpmgr->GetSendEventLoop(conn->peer);
+  conn->conn_pool = ConnectionPool::GetConnectionPool(conn->peer);
 
   conn->event_callback = TCPComm::EventCallBack;
   conn->write_callback = TCPComm::WriteCallBack;
@@ -210,40 +214,40 @@ void TCPComm::SendExitMsg(const std::string &from, const std::string &to) {
 void TCPComm::SetMessageHandler(IOMgr::MessageHandler handler) { message_handler_ = handler; }
 
 bool TCPComm::Initialize() {
-  if (ConnectionPool::GetConnectionPool() == nullptr) {
+  if (ConnectionPool::GetConnectionPools().empty()) {
     MS_LOG(ERROR) << "Failed to create connection pool.";
     return false;
   }
-  recv_event_loop_ = new (std::nothrow) EventLoop();
-  if (recv_event_loop_ == nullptr) {
-    MS_LOG(ERROR) << "Failed to create recv evLoop.";
-    return false;
-  }
-
-  bool ok = recv_event_loop_->Initialize(TCP_RECV_EVLOOP_THREADNAME);
-  if (!ok) {
-    MS_LOG(ERROR) << "Failed to init recv evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    return false;
-  }
+  for (size_t i = 0; i < ConnectionPool::GetPoolNum(); ++i) {
+    auto recv_event_loop = new (std::nothrow) EventLoop();
+    if (recv_event_loop == nullptr) {
+      MS_LOG(ERROR) << "Failed to create recv evLoop.";
+      Finalize();
+      return false;
+    }
+    if (!recv_event_loop->Initialize(TCP_RECV_EVLOOP_THREADNAME + std::to_string(i))) {
+      MS_LOG(ERROR) << "Failed to init recv evLoop";
+      delete recv_event_loop;
+      Finalize();
+      return false;
+    }
+    recv_event_loops_.push_back(recv_event_loop);
 
-  send_event_loop_ = new (std::nothrow) EventLoop();
-  if (send_event_loop_ == nullptr) {
-    MS_LOG(ERROR) << "Failed to create send evLoop.";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    return false;
-  }
-  ok = send_event_loop_->Initialize(TCP_SEND_EVLOOP_THREADNAME);
-  if (!ok) {
-    MS_LOG(ERROR) << "Failed to init send evLoop";
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
-    return false;
+    auto send_event_loop = new (std::nothrow) EventLoop();
+    if (send_event_loop == nullptr) {
+      MS_LOG(ERROR) << "Failed to create send evLoop.";
+      Finalize();
+      return false;
+    }
+    if (!send_event_loop->Initialize(TCP_SEND_EVLOOP_THREADNAME + std::to_string(i))) {
+      MS_LOG(ERROR) << "Failed to init send evLoop";
+      delete send_event_loop;
+      Finalize();
+      return false;
+    }
+    send_event_loops_.push_back(send_event_loop);
   }
+  MS_LOG(INFO) << "Create " << recv_event_loops_.size() << " pairs of recv and send evLoops.";
 
   if (g_httpKmsgEnable < 0) {
     char *httpKmsgEnv = getenv("LITERPC_HTTPKMSG_ENABLED");
@@ -256,7 +260,9 @@ bool TCPComm::Initialize() {
     is_http_msg_ = (g_httpKmsgEnable == 0) ? false : true;
   }
 
-  ConnectionPool::GetConnectionPool()->SetLinkPattern(is_http_msg_);
+  for (auto conn_pool : ConnectionPool::GetConnectionPools()) {
+    conn_pool->SetLinkPattern(is_http_msg_);
+  }
   return true;
 }
 
@@ -292,9 +298,9 @@ bool TCPComm::StartServerSocket(const std::string &url, const std::string &aAdve
     advertise_url_.assign(tmp_url.begin(), tmp_url.end());
   }
 
-  // Register read event callback for server socket
-  int retval = recv_event_loop_->SetEventHandler(server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
-                                                 reinterpret_cast<void *>(this));
+  // Register read event callback for server socket, the accepted connections are spread over the recv evLoops.
+  int retval = recv_event_loops_[0]->SetEventHandler(server_fd_, EPOLLIN | EPOLLHUP | EPOLLERR, OnAccept,
+                                                     reinterpret_cast<void *>(this));
   if (retval != RPC_OK) {
     MS_LOG(ERROR) << "Failed to add server event, url: " << url.c_str()
                   << ", advertise_url_: " << advertise_url_.data();
@@ -320,25 +326,24 @@ void TCPComm::ReadCallBack(void *context) {
 
 void TCPComm::EventCallBack(void *context) {
   Connection *conn = reinterpret_cast<Connection *>(context);
-
+  auto conn_pool = conn->conn_pool;
+  MS_EXCEPTION_IF_NULL(conn_pool);
   if (conn->state == ConnectionState::kConnected) {
-    Connection::conn_mutex.lock();
+    std::lock_guard<std::mutex> lock(conn_pool->mutex_);
     DoSend(conn);
-    Connection::conn_mutex.unlock();
   } else if (conn->state == ConnectionState::kDisconnecting) {
-    Connection::conn_mutex.lock();
+    std::lock_guard<std::mutex> lock(conn_pool->mutex_);
     output_buf_size_ -= conn->output_buffer_size;
-    ConnectionPool::GetConnectionPool()->CloseConnection(conn);
-    Connection::conn_mutex.unlock();
+    conn_pool->CloseConnection(conn);
   }
 }
 
 void TCPComm::WriteCallBack(void *context) {
   Connection *conn = reinterpret_cast<Connection *>(context);
   if (conn->state == ConnectionState::kConnected) {
-    Connection::conn_mutex.lock();
+    MS_EXCEPTION_IF_NULL(conn->conn_pool);
+    std::lock_guard<std::mutex> lock(conn->conn_pool->mutex_);
     DoSend(conn);
-    Connection::conn_mutex.unlock();
   }
 }
 
@@ -408,8 +413,9 @@ int TCPComm::Connect(Connection *conn, const struct sockaddr *sa, socklen_t saLe
 }
 
 void TCPComm::Send(MessageBase *msg, const TCPComm *tcpmgr, bool remoteLink, bool isExactNotRemote) {
-  std::lock_guard<std::mutex> lock(Connection::conn_mutex);
-  Connection *conn = ConnectionPool::GetConnectionPool()->FindConnection(msg->to.Url(), remoteLink, isExactNotRemote);
+  auto conn_pool = ConnectionPool::GetConnectionPool(msg->to.Url());
+  std::lock_guard<std::mutex> lock(conn_pool->mutex_);
+  Connection *conn = conn_pool->FindConnection(msg->to.Url(), remoteLink, isExactNotRemote);
 
   // Create a new connection if the connection to target of the message does not existed.
   if (conn == nullptr) {
@@ -428,8 +434,9 @@ void TCPComm::Send(MessageBase *msg, const TCPComm *tcpmgr, bool remoteLink, boo
     }
     conn->source = advertise_url_.data();
     conn->destination = msg->to.Url();
-    conn->recv_event_loop = tcpmgr->recv_event_loop_;
-    conn->send_event_loop = tcpmgr->send_event_loop_;
+    conn->recv_event_loop = tcpmgr->GetRecvEventLoop(conn->destination);
+    conn->send_event_loop = tcpmgr->GetSendEventLoop(conn->destination);
+    conn->conn_pool = conn_pool;
     conn->InitSocketOperation();
 
     int ret = DoConnect(msg->to.Url(), conn, TCPComm::EventCallBack, TCPComm::WriteCallBack, TCPComm::ReadCallBack);
@@ -444,11 +451,11 @@ void TCPComm::Send(MessageBase *msg, const TCPComm *tcpmgr, bool remoteLink, boo
       delete msg;
       return;
     }
-    ConnectionPool::GetConnectionPool()->AddConnection(conn);
+    conn_pool->AddConnection(conn);
   }
 
   if (!conn->is_remote && !isExactNotRemote && conn->priority == ConnectionPriority::kPriorityLow) {
-    Connection *remoteConn = ConnectionPool::GetConnectionPool()->ExactFindConnection(msg->to.Url(), true);
+    Connection *remoteConn = conn_pool->ExactFindConnection(msg->to.Url(), true);
     if (remoteConn != nullptr && remoteConn->state == ConnectionState::kConnected) {
       conn = remoteConn;
     }
@@ -468,16 +475,17 @@ void TCPComm::Send(MessageBase *msg, const TCPComm *tcpmgr, bool remoteLink, boo
 }
 
 void TCPComm::SendByRecvLoop(MessageBase *msg, const TCPComm *tcpmgr, bool remoteLink, bool isExactNotRemote) {
-  recv_event_loop_->AddTask(
+  GetRecvEventLoop(msg->to.Url())->AddTask(
     [msg, tcpmgr, remoteLink, isExactNotRemote] { TCPComm::Send(msg, tcpmgr, remoteLink, isExactNotRemote); });
 }
 
 int TCPComm::Send(MessageBase *msg, bool remoteLink, bool isExactNotRemote) {
-  return send_event_loop_->AddTask([msg, this, remoteLink, isExactNotRemote] {
-    std::lock_guard<std::mutex> lock(Connection::conn_mutex);
+  return GetSendEventLoop(msg->to.Url())->AddTask([msg, this, remoteLink, isExactNotRemote] {
+    auto conn_pool = ConnectionPool::GetConnectionPool(msg->to.Url());
+    std::lock_guard<std::mutex> lock(conn_pool->mutex_);
     // Search connection by the target address
     bool exactNotRemote = is_http_msg_ || isExactNotRemote;
-    Connection *conn = ConnectionPool::GetConnectionPool()->FindConnection(msg->to.Url(), remoteLink, exactNotRemote);
+    Connection *conn = conn_pool->FindConnection(msg->to.Url(), remoteLink, exactNotRemote);
     if (conn == nullptr) {
       if (remoteLink && (!exactNotRemote)) {
         MS_LOG(ERROR) << "Can not found remote link and send fail name: " << msg->name.c_str()
@@ -508,7 +516,7 @@ int TCPComm::Send(MessageBase *msg, bool remoteLink, bool isExactNotRemote) {
     }
 
     if (!conn->is_remote && !exactNotRemote && conn->priority == ConnectionPriority::kPriorityLow) {
-      Connection *remoteConn = ConnectionPool::GetConnectionPool()->ExactFindConnection(msg->to.Url(), true);
+      Connection *remoteConn = conn_pool->ExactFindConnection(msg->to.Url(), true);
       if (remoteConn != nullptr && remoteConn->state == ConnectionState::kConnected) {
         conn = remoteConn;
       }
@@ -528,38 +536,41 @@ int TCPComm::Send(MessageBase *msg, bool remoteLink, bool isExactNotRemote) {
 }
 
 void TCPComm::CollectMetrics() {
-  send_event_loop_->AddTask([this] {
-    Connection::conn_mutex.lock();
-    Connection *maxConn = ConnectionPool::GetConnectionPool()->FindMaxConnection();
-    Connection *fastConn = ConnectionPool::GetConnectionPool()->FindFastConnection();
-
-    if (message_handler_ != nullptr) {
-      IntTypeMetrics intMetrics;
-      StringTypeMetrics stringMetrics;
-
-      if (maxConn != nullptr) {
-        intMetrics.push(maxConn->socket_fd);
-        intMetrics.push(maxConn->error_code);
-        intMetrics.push(maxConn->send_metrics->accum_msg_count);
-        intMetrics.push(maxConn->send_metrics->max_msg_size);
-        stringMetrics.push(maxConn->destination);
-        stringMetrics.push(maxConn->send_metrics->last_succ_msg_name);
-        stringMetrics.push(maxConn->send_metrics->last_fail_msg_name);
-      }
-      if (fastConn != nullptr && fastConn->IsSame(maxConn)) {
-        intMetrics.push(fastConn->socket_fd);
-        intMetrics.push(fastConn->error_code);
-        intMetrics.push(fastConn->send_metrics->accum_msg_count);
-        intMetrics.push(fastConn->send_metrics->max_msg_size);
-        stringMetrics.push(fastConn->destination);
-        stringMetrics.push(fastConn->send_metrics->last_succ_msg_name);
-        stringMetrics.push(fastConn->send_metrics->last_fail_msg_name);
+  // The metrics of each connection pool are collected by its own send evLoop.
+  for (size_t i = 0; i < send_event_loops_.size(); ++i) {
+    send_event_loops_[i]->AddTask([i] {
+      auto conn_pool = ConnectionPool::GetConnectionPools()[i];
+      std::lock_guard<std::mutex> lock(conn_pool->mutex_);
+      Connection *maxConn = conn_pool->FindMaxConnection();
+      Connection *fastConn = conn_pool->FindFastConnection();
+
+      if (message_handler_ != nullptr) {
+        IntTypeMetrics intMetrics;
+        StringTypeMetrics stringMetrics;
+
+        if (maxConn != nullptr) {
+          intMetrics.push(maxConn->socket_fd);
+          intMetrics.push(maxConn->error_code);
+          intMetrics.push(maxConn->send_metrics->accum_msg_count);
+          intMetrics.push(maxConn->send_metrics->max_msg_size);
+          stringMetrics.push(maxConn->destination);
+          stringMetrics.push(maxConn->send_metrics->last_succ_msg_name);
+          stringMetrics.push(maxConn->send_metrics->last_fail_msg_name);
+        }
+        if (fastConn != nullptr && fastConn->IsSame(maxConn)) {
+          intMetrics.push(fastConn->socket_fd);
+          intMetrics.push(fastConn->error_code);
+          intMetrics.push(fastConn->send_metrics->accum_msg_count);
+          intMetrics.push(fastConn->send_metrics->max_msg_size);
+          stringMetrics.push(fastConn->destination);
+          stringMetrics.push(fastConn->send_metrics->last_succ_msg_name);
+          stringMetrics.push(fastConn->send_metrics->last_fail_msg_name);
+        }
       }
-    }
 
-    ConnectionPool::GetConnectionPool()->ResetAllConnMetrics();
-    Connection::conn_mutex.unlock();
-  });
+      conn_pool->ResetAllConnMetrics();
+    });
+  }
 }
 
 int TCPComm::Send(std::unique_ptr<MessageBase> &&msg, bool remoteLink, bool isExactNotRemote) {
@@ -567,12 +578,13 @@ int TCPComm::Send(std::unique_ptr<MessageBase> &&msg, bool remoteLink, bool isEx
 }
 
 void TCPComm::Link(const AID &source, const AID &destination) {
-  recv_event_loop_->AddTask([source, destination, this] {
+  GetRecvEventLoop(destination.Url())->AddTask([source, destination, this] {
     std::string to = destination.Url();
-    std::lock_guard<std::mutex> lock(Connection::conn_mutex);
+    auto conn_pool = ConnectionPool::GetConnectionPool(to);
+    std::lock_guard<std::mutex> lock(conn_pool->mutex_);
 
     // Search connection by the target address
-    Connection *conn = ConnectionPool::GetConnectionPool()->FindConnection(to, false, is_http_msg_);
+    Connection *conn = conn_pool->FindConnection(to, false, is_http_msg_);
 
     if (conn == nullptr) {
       MS_LOG(INFO) << "Can not found link source: " << std::string(source).c_str()
@@ -587,8 +599,9 @@ void TCPComm::Link(const AID &source, const AID &destination) {
       conn->source = advertise_url_.data();
       conn->destination = to;
 
-      conn->recv_event_loop = this->recv_event_loop_;
-      conn->send_event_loop = this->send_event_loop_;
+      conn->recv_event_loop = GetRecvEventLoop(to);
+      conn->send_event_loop = GetSendEventLoop(to);
+      conn->conn_pool = conn_pool;
       conn->InitSocketOperation();
 
       int ret = DoConnect(to, conn, TCPComm::EventCallBack, TCPComm::WriteCallBack, TCPComm::ReadCallBack);
@@ -603,35 +616,37 @@ void TCPComm::Link(const AID &source, const AID &destination) {
         delete conn;
         return;
       }
-      ConnectionPool::GetConnectionPool()->AddConnection(conn);
+      conn_pool->AddConnection(conn);
     }
-    ConnectionPool::GetConnectionPool()->AddConnInfo(conn->socket_fd, source, destination, SendExitMsg);
+    conn_pool->AddConnInfo(conn->socket_fd, source, destination, SendExitMsg);
     MS_LOG(INFO) << "Link fd: " << conn->socket_fd << ", source: " << std::string(source).c_str()
                  << ", destination: " << std::string(destination).c_str() << ", remote: " << conn->is_remote;
   });
 }
 
 void TCPComm::UnLink(const AID &destination) {
-  recv_event_loop_->AddTask([destination] {
+  GetRecvEventLoop(destination.Url())->AddTask([destination] {
     std::string to = destination.Url();
-    std::lock_guard<std::mutex> lock(Connection::conn_mutex);
+    auto conn_pool = ConnectionPool::GetConnectionPool(to);
+    std::lock_guard<std::mutex> lock(conn_pool->mutex_);
     if (is_http_msg_) {
       // When application has set 'LITERPC_HTTPKMSG_ENABLED',it means sending-link is in links map
       // while accepting-link is differently in remoteLinks map. So we only need to delete link in exact links.
-      ConnectionPool::GetConnectionPool()->ExactDeleteConnection(to, false);
+      conn_pool->ExactDeleteConnection(to, false);
     } else {
       // When application hasn't set 'LITERPC_HTTPKMSG_ENABLED',it means sending-link and accepting-link is
       // shared
       // So we need to delete link in both links map and remote-links map.
-      ConnectionPool::GetConnectionPool()->ExactDeleteConnection(to, false);
-      ConnectionPool::GetConnectionPool()->ExactDeleteConnection(to, true);
+      conn_pool->ExactDeleteConnection(to, false);
+      conn_pool->ExactDeleteConnection(to, true);
     }
   });
 }
 
 void TCPComm::DoReConnectConn(Connection *conn, std::string to, const AID &source, const AID &destination, int *oldFd) {
   if (!is_http_msg_ && !conn->is_remote) {
-    Connection *remoteConn = ConnectionPool::GetConnectionPool()->ExactFindConnection(to, true);
+    auto conn_pool = ConnectionPool::GetConnectionPool(to);
+    Connection *remoteConn = conn_pool->ExactFindConnection(to, true);
     // We will close remote link in rare cases where sending-link and accepting link coexists
     // simultaneously.
     if (remoteConn != nullptr) {
@@ -639,7 +654,7 @@ void TCPComm::DoReConnectConn(Connection *conn, std::string to, const AID &sourc
                    << ", source: " << std::string(source).c_str()
                    << ", destination: " << std::string(destination).c_str() << ", remote: " << remoteConn->is_remote
                    << ", state: " << remoteConn->state;
-      ConnectionPool::GetConnectionPool()->CloseConnection(remoteConn);
+      conn_pool->CloseConnection(remoteConn);
     }
   }
 
@@ -681,26 +696,29 @@ Connection *TCPComm::CreateDefaultConn(std::string to) {
   }
   conn->source = advertise_url_.data();
   conn->destination = to;
-  conn->recv_event_loop = this->recv_event_loop_;
-  conn->send_event_loop = this->send_event_loop_;
+  conn->recv_event_loop = GetRecvEventLoop(to);
+  conn->send_event_loop = GetSendEventLoop(to);
+  conn->conn_pool = ConnectionPool::GetConnectionPool(to);
   conn->InitSocketOperation();
   return conn;
 }
 
 void TCPComm::Reconnect(const AID &source, const AID &destination) {
-  send_event_loop_->AddTask([source, destination, this] {
+  GetSendEventLoop(destination.Url())->AddTask([source, destination, this] {
     std::string to = destination.Url();
-    std::lock_guard<std::mutex> lock(Connection::conn_mutex);
-    Connection *conn = ConnectionPool::GetConnectionPool()->FindConnection(to, false, is_http_msg_);
+    auto conn_pool = ConnectionPool::GetConnectionPool(to);
+    std::lock_guard<std::mutex> lock(conn_pool->mutex_);
+    Connection *conn = conn_pool->FindConnection(to, false, is_http_msg_);
     if (conn != nullptr) {
       conn->state = ConnectionState::kClose;
     }
 
-    recv_event_loop_->AddTask([source, destination, this] {
+    GetRecvEventLoop(to)->AddTask([source, destination, this] {
       std::string to = destination.Url();
       int oldFd = -1;
-      std::lock_guard<std::mutex> lock(Connection::conn_mutex);
-      Connection *conn = ConnectionPool::GetConnectionPool()->FindConnection(to, false, is_http_msg_);
+      auto conn_pool = ConnectionPool::GetConnectionPool(to);
+      std::lock_guard<std::mutex> lock(conn_pool->mutex_);
+      Connection *conn = conn_pool->FindConnection(to, false, is_http_msg_);
       if (conn != nullptr) {
         // connection already exist
         DoReConnectConn(conn, to, source, destination, &oldFd);
@@ -722,17 +740,17 @@ void TCPComm::Reconnect(const AID &source, const AID &destination) {
         }
         MS_LOG(ERROR) << "Failed to connect and reconnect fail source: " << std::string(source).c_str()
                       << ", destination: " << std::string(destination).c_str();
-        ConnectionPool::GetConnectionPool()->CloseConnection(conn);
+        conn_pool->CloseConnection(conn);
         return;
       }
       if (oldFd != -1) {
-        if (!ConnectionPool::GetConnectionPool()->ReverseConnInfo(oldFd, conn->socket_fd)) {
+        if (!conn_pool->ReverseConnInfo(oldFd, conn->socket_fd)) {
           MS_LOG(ERROR) << "Failed to swap socket for " << oldFd << " and " << conn->socket_fd;
         }
       } else {
-        ConnectionPool::GetConnectionPool()->AddConnection(conn);
+        conn_pool->AddConnection(conn);
       }
-      ConnectionPool::GetConnectionPool()->AddConnInfo(conn->socket_fd, source, destination, SendExitMsg);
+      conn_pool->AddConnInfo(conn->socket_fd, source, destination, SendExitMsg);
       MS_LOG(INFO) << "Reconnect fd: " << conn->socket_fd << ", source: " << std::string(source).c_str()
                    << ", destination: " << std::string(destination).c_str();
     });
@@ -740,19 +758,19 @@ void TCPComm::Reconnect(const AID &source, const AID &destination) {
 }
 
 void TCPComm::Finalize() {
-  if (send_event_loop_ != nullptr) {
+  for (auto send_event_loop : send_event_loops_) {
     MS_LOG(INFO) << "Delete send event loop";
-    send_event_loop_->Finalize();
-    delete send_event_loop_;
-    send_event_loop_ = nullptr;
+    send_event_loop->Finalize();
+    delete send_event_loop;
   }
+  send_event_loops_.clear();
 
-  if (recv_event_loop_ != nullptr) {
+  for (auto recv_event_loop : recv_event_loops_) {
     MS_LOG(INFO) << "Delete recv event loop";
-    recv_event_loop_->Finalize();
-    delete recv_event_loop_;
-    recv_event_loop_ = nullptr;
+    recv_event_loop->Finalize();
+    delete recv_event_loop;
   }
+  recv_event_loops_.clear();
 
   if (server_fd_ > 0) {
     close(server_fd_);
@@ -766,6 +784,14 @@ uint64_t TCPComm::GetInBufSize() { return 1; }
 uint64_t TCPComm::GetOutBufSize() { return output_buf_size_; }
 
 bool TCPComm::IsHttpMsg() { return is_http_msg_; }
+
+EventLoop *TCPComm::GetRecvEventLoop(const std::string &to) const {
+  return recv_event_loops_[ConnectionPool::GetPoolIndex(to)];
+}
+
+EventLoop *TCPComm::GetSendEventLoop(const std::string &to) const {
+  return send_event_loops_[ConnectionPool::GetPoolIndex(to)];
+}
 }  // namespace rpc
 }  // namespace distributed
 }  // namespace mindspore
@@ -20,6 +20,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <atomic>
 
 #include "actor/iomgr.h"
 #include "distributed/rpc/tcp/connection.h"
@@ -44,12 +45,12 @@ void ConnectedEventHandler(int fd, uint32_t events, void *context);
 
 class TCPComm : public IOMgr {
  public:
-  TCPComm() : server_fd_(-1), recv_event_loop_(nullptr), send_event_loop_(nullptr) {}
+  TCPComm() : server_fd_(-1) {}
   TCPComm(const TCPComm &) = delete;
   TCPComm &operator=(const TCPComm &) = delete;
   ~TCPComm();
 
-  // Init the event loop for reading and writing.
+  // Init the event loops for reading and writing.
   bool Initialize() override;
 
   // Destroy all the resources.
@@ -91,6 +92,11 @@ class TCPComm : public IOMgr {
 
   static bool IsHttpMsg();
 
+  // The connections to a destination are handled by the event loops of the same index as its connection pool, so
+  // they are closed and reconnected by only one thread and the messages to it are sent in order.
+  EventLoop *GetRecvEventLoop(const std::string &to) const;
+  EventLoop *GetSendEventLoop(const std::string &to) const;
+
   // Read and write events.
   static void ReadCallBack(void *context);
   static void WriteCallBack(void *context);
@@ -104,7 +110,7 @@ class TCPComm : public IOMgr {
   int server_fd_;
 
   // The message size waiting to be sent.
-  static uint64_t output_buf_size_;
+  static std::atomic<uint64_t> output_buf_size_;
 
   // User defined handler for Handling received messages.
   static MessageHandler message_handler_;
@@ -114,9 +120,10 @@ class TCPComm : public IOMgr {
 
   static bool is_http_msg_;
 
-  // All the connections share the same read and write event loop objects.
-  EventLoop *recv_event_loop_;
-  EventLoop *send_event_loop_;
+  // The connections are hashed by the peer host over several pairs of read and write event loops, so the messages
+  // of different peers are parsed and sent in parallel.
+  std::vector<EventLoop *> recv_event_loops_;
+  std::vector<EventLoop *> send_event_loops_;
 
   friend void OnAccept(int server, uint32_t events, void *arg);
   friend void DoSend(Connection *conn);
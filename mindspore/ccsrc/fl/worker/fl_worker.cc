@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 #include <utility>
+#include <numeric>
 #include "fl/worker/fl_worker.h"
 #include "fl/armour/secure_protocol/key_agreement.h"
 #include "utils/ms_exception.h"
@@ -152,6 +153,80 @@ bool FLWorker::SendToServer(uint32_t server_rank, const void *data, size_t size,
   return true;
 }
 
+bool FLWorker::SendToServers(const std::vector<uint32_t> &server_ranks, const std::vector<const void *> &data,
+                             const std::vector<size_t> &sizes, ps::core::TcpUserCommand command,
+                             std::vector<std::shared_ptr<std::vector<unsigned char>>> *outputs) {
+  MS_EXCEPTION_IF_NULL(outputs);
+  if (server_ranks.size() != data.size() || server_ranks.size() != sizes.size()) {
+    MS_LOG(ERROR) << "The number of server ranks " << server_ranks.size() << ", data " << data.size() << " and sizes "
+                  << sizes.size() << " should be equal.";
+    return false;
+  }
+  // If the worker is in safemode, do not communicate with server.
+  while (safemode_.load()) {
+    std::this_thread::yield();
+  }
+
+  std::vector<ps::core::AbstractNode::DataPtr> messages;
+  for (size_t i = 0; i < data.size(); i++) {
+    MS_EXCEPTION_IF_NULL(data[i]);
+#ifdef __APPLE__
+    std::shared_ptr<unsigned char> message(new unsigned char[sizes[i]], std::default_delete<unsigned char[]>());
+#else
+    std::shared_ptr<unsigned char[]> message = std::make_unique<unsigned char[]>(sizes[i]);
+#endif
+    MS_EXCEPTION_IF_NULL(message);
+    int ret = memcpy_s(message.get(), sizes[i], data[i], sizes[i]);
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+    messages.push_back(message);
+  }
+
+  outputs->assign(server_ranks.size(), nullptr);
+  // The indices of the messages to be sent, the ones rejected by the servers in safemode are sent again.
+  std::vector<size_t> pending(server_ranks.size());
+  std::iota(pending.begin(), pending.end(), 0);
+  while (!pending.empty()) {
+    std::vector<uint32_t> ranks;
+    std::vector<ps::core::AbstractNode::DataPtr> pending_messages;
+    std::vector<size_t> lens;
+    for (size_t i : pending) {
+      ranks.push_back(server_ranks[i]);
+      pending_messages.push_back(messages[i]);
+      lens.push_back(sizes[i]);
+    }
+    std::vector<std::shared_ptr<std::vector<unsigned char>>> responses;
+    if (!worker_node_->Send(ps::core::NodeRole::SERVER, ranks, pending_messages, lens, static_cast<int>(command),
+                            &responses, kWorkerTimeout) ||
+        responses.size() != pending.size()) {
+      MS_LOG(ERROR) << "Sending messages to servers " << ranks << " failed.";
+      return false;
+    }
+
+    std::vector<size_t> rejected;
+    for (size_t i = 0; i < pending.size(); i++) {
+      if (responses[i] == nullptr) {
+        MS_LOG(WARNING) << "Response from server " << ranks[i] << " is empty.";
+        return false;
+      }
+      std::string response_str = std::string(reinterpret_cast<char *>(responses[i]->data()), responses[i]->size());
+      if (response_str == ps::kClusterSafeMode || response_str == ps::kJobNotAvailable) {
+        MS_LOG(INFO) << "The server " << ranks[i] << " is in safemode or finished.";
+        rejected.push_back(pending[i]);
+        continue;
+      }
+      (*outputs)[pending[i]] = responses[i];
+    }
+    if (!rejected.empty()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(kWorkerRetryDurationForSafeMode));
+    }
+    pending = std::move(rejected);
+  }
+  return true;
+}
+
 uint32_t FLWorker::server_num() const { return server_num_; }
 
 uint32_t FLWorker::worker_num() const { return worker_num_; }
@@ -77,6 +77,11 @@ class FLWorker {
   void Finalize();
   bool SendToServer(uint32_t server_rank, const void *data, size_t size, ps::core::TcpUserCommand command,
                     std::shared_ptr<std::vector<unsigned char>> *output = nullptr);
+  // Send the messages to the distinct servers concurrently and wait for all the responses, which are in the order of
+  // server_ranks.
+  bool SendToServers(const std::vector<uint32_t> &server_ranks, const std::vector<const void *> &data,
+                     const std::vector<size_t> &sizes, ps::core::TcpUserCommand command,
+                     std::vector<std::shared_ptr<std::vector<unsigned char>>> *outputs);
 
   uint32_t server_num() const;
   uint32_t worker_num() const;
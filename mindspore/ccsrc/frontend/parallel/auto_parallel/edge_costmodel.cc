@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <sstream>
 #include <utility>
 #include "frontend/parallel/auto_parallel/costmodel.h"
 #include "frontend/parallel/auto_parallel/graph_costmodel.h"
@@ -27,6 +28,8 @@
 
 namespace mindspore {
 namespace parallel {
+std::map<std::string, RedistributionCost> Edge::redistribution_cost_cache_;
+
 Status Edge::InitEdgeCost() {
   bool has_available_cost = false;
   pre_op_output_.clear();
@@ -117,22 +120,13 @@ Status Edge::GetRedistributionCost(const TensorLayout &prev_op_output_layout, co
   MS_EXCEPTION_IF_NULL(prev_op_);
   MS_EXCEPTION_IF_NULL(cost);
   RankList dev_list = prev_op_->stage_device_list();
-  TensorRedistribution tensor_redistribution(false);
-
-  // Init TensorRedistribution
-  if (tensor_redistribution.Init(prev_op_output_layout, next_op_input_layout, dev_list) == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution init failed.";
-  }
+  const auto &redistribution_cost = ComputeRedistributionCost(prev_op_output_layout, next_op_input_layout, dev_list);
 
-  if (tensor_redistribution.ComputeCost() == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
-  }
-
-  double comm_cost = tensor_redistribution.comm_cost();
-  double forward_comm_cost = tensor_redistribution.forward_comm_cost();
-  double backward_comm_cost = tensor_redistribution.backward_comm_cost();
-  double computation_cost = tensor_redistribution.computation_cost();
-  double mem_cost = tensor_redistribution.memory_cost();
+  double comm_cost = redistribution_cost.comm_cost;
+  double forward_comm_cost = redistribution_cost.forward_comm_cost;
+  double backward_comm_cost = redistribution_cost.backward_comm_cost;
+  double computation_cost = redistribution_cost.computation_cost;
+  double mem_cost = redistribution_cost.memory_cost;
   const auto gamma = CostModelContext::GetInstance()->costmodel_gamma();
 
   // Now AllGather, ReduceScatter, AlltoAll don't support bool type
@@ -153,6 +147,35 @@ Status Edge::GetRedistributionCost(const TensorLayout &prev_op_output_layout, co
   return Status::SUCCESS;
 }
 
+const RedistributionCost &Edge::ComputeRedistributionCost(const TensorLayout &prev_op_output_layout,
+                                                          const TensorLayout &next_op_input_layout,
+                                                          const RankList &dev_list) {
+  std::ostringstream key;
+  key << prev_op_output_layout.ToString() << std::endl << "to" << next_op_input_layout.ToString() << std::endl << "on";
+  for (auto dev : dev_list) {
+    key << " " << dev;
+  }
+  auto iter = redistribution_cost_cache_.find(key.str());
+  if (iter != redistribution_cost_cache_.end()) {
+    return iter->second;
+  }
+
+  TensorRedistribution tensor_redistribution(false);
+  // Init TensorRedistribution
+  if (tensor_redistribution.Init(prev_op_output_layout, next_op_input_layout, dev_list) == FAILED) {
+    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution init failed.";
+  }
+
+  if (tensor_redistribution.ComputeCost() == FAILED) {
+    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
+  }
+  RedistributionCost redistribution_cost = {
+    tensor_redistribution.comm_cost(), tensor_redistribution.forward_comm_cost(),
+    tensor_redistribution.backward_comm_cost(), tensor_redistribution.computation_cost(),
+    tensor_redistribution.memory_cost()};
+  return redistribution_cost_cache_.emplace(key.str(), redistribution_cost).first->second;
+}
+
 CostPtrList Edge::GetCostList(StrategyPtr output_str, StrategyPtr input_str) {
   CostPtrKey ck = {output_str, input_str};
   CostPtrList result;
@@ -34,6 +34,15 @@ using CostPtrKey = std::pair<StrategyPtr, StrategyPtr>;
 using OperatorInfoPtr = std::shared_ptr<mindspore::parallel::OperatorInfo>;
 using EdgePtr = std::shared_ptr<mindspore::parallel::Edge>;
 
+// The costs of redistributing a tensor from one layout to another, which only depend on the layouts and the devices.
+struct RedistributionCost {
+  double comm_cost;
+  double forward_comm_cost;
+  double backward_comm_cost;
+  double computation_cost;
+  double memory_cost;
+};
+
 struct OpsPtrCompare {
   bool operator()(const OperatorInfoPtr &a, const OperatorInfoPtr &b) const { return a->name().compare(b->name()) < 0; }
 };
@@ -101,6 +110,10 @@ class Edge {
   // and the op_list to carry out the redistribution.
   Status GetRedistributionCost(const TensorLayout &prev_op_output_layout, const TensorLayout &next_op_input_layout,
                                size_t, const TypePtr &type, CostPtr *cost);
+  // The structurally identical layers of a deep network have the same layouts on their edges, so the redistribution
+  // costs are cached by the layouts and the devices, and cleared when the cost graph is initialized.
+  static void ClearRedistributionCostCache() { redistribution_cost_cache_.clear(); }
+  static size_t RedistributionCostCacheSize() { return redistribution_cost_cache_.size(); }
 
   void set_pre_op_output(const std::vector<std::pair<std::shared_ptr<Strategy>, std::vector<TensorInfo>>> &output_set) {
     pre_op_output_ = output_set;
@@ -158,6 +171,11 @@ class Edge {
   bool CheckStrategyCostPossibility() const;
 
  private:
+  static const RedistributionCost &ComputeRedistributionCost(const TensorLayout &prev_op_output_layout,
+                                                            const TensorLayout &next_op_input_layout,
+                                                            const RankList &dev_list);
+
+  static std::map<std::string, RedistributionCost> redistribution_cost_cache_;
   std::string edge_name_;
   std::shared_ptr<OperatorInfo> prev_op_, next_op_;
   std::map<CostPtrKey, CostPtrList> cost_map_;
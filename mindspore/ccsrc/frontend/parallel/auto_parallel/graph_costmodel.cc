@@ -38,6 +38,7 @@ void CostGraph::Init() {
   connected_compoents_.clear();
   out_edges_.clear();
   in_edges_.clear();
+  Edge::ClearRedistributionCostCache();
 }
 
 void CostGraph::RemoveOperator(const OperatorInfoPtr &op) {
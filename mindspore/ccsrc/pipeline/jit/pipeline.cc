@@ -56,6 +56,7 @@
 #include "load_mindir/load_model.h"
 #include "vm/segment_runner.h"
 #include "backend/session/executor_manager.h"
+#include "backend/kernel_compiler/kernel_select_cache.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "runtime/device/kernel_runtime_manager.h"
 #include "utils/system/sha256.h"
@@ -129,6 +130,7 @@ constexpr char kCompileCacheSubDir[] = "graph_cache";
 constexpr char kCompileCacheFileName[] = "compile_cache";
 constexpr char kCompileCacheFileSuffix[] = ".mindir";
 constexpr char kDepFilesHashPath[] = "compile_dependency.hash";
+constexpr char kKernelSelectCacheFileName[] = "kernel_select.json";
 
 #ifdef ENABLE_DUMP_IR
 std::string GetBaseNameForIR(int64_t stage_idx, const std::string &action_name) {
@@ -239,6 +241,11 @@ std::string GetDepFilesHashPath() {
   return dep_files_hash_path;
 }
 
+std::string GetKernelSelectCachePath() {
+  static const std::string kernel_select_cache_path = GetCompileCacheDir() + "/" + kKernelSelectCacheFileName;
+  return kernel_select_cache_path;
+}
+
 size_t GetCompileCacheGraphId() {
   static size_t idx = 0;
   return idx++;
@@ -431,6 +438,39 @@ bool ExportDepFilesHash(const ResourcePtr &resource) {
   return true;
 }
 
+// The kernel selections are loaded along with the cached func graph, so they are validated by the dependency files hash.
+void LoadKernelSelectCache() {
+  static bool loaded = false;
+  if (loaded) {
+    return;
+  }
+  loaded = true;
+  std::string kernel_select_cache_path = GetKernelSelectCachePath();
+  auto realpath = Common::CreatePrefixPath(kernel_select_cache_path, true);
+  if (!realpath.has_value()) {
+    MS_LOG(ERROR) << "Get real path of file " << kernel_select_cache_path << " failed.";
+    return;
+  }
+  if (!kernel::KernelSelectCache::GetInstance().Load(realpath.value())) {
+    MS_LOG(WARNING) << "Failed to load the kernel selection cache file. Select the kernels again.";
+  }
+}
+
+void CacheKernelSelect() {
+  std::string kernel_select_cache_path = GetKernelSelectCachePath();
+  auto realpath = Common::CreatePrefixPath(kernel_select_cache_path, true);
+  if (!realpath.has_value()) {
+    MS_LOG(ERROR) << "Get real path of file " << kernel_select_cache_path << " failed.";
+    return;
+  }
+
+  ChangeFileMode(realpath.value(), S_IRWXU);
+  if (!kernel::KernelSelectCache::GetInstance().Save(realpath.value())) {
+    MS_LOG(ERROR) << "Failed to cache the kernel selections.";
+  }
+  ChangeFileMode(realpath.value(), S_IRUSR);
+}
+
 void CacheFuncGraph(const ResourcePtr &resource) {
   MS_EXCEPTION_IF_NULL(resource);
   auto fg = resource->func_graph();
@@ -1001,6 +1041,9 @@ bool GraphExecutorPy::CompileInner(const py::object &source_obj, const py::tuple
     resource->set_compile_cache_id(GetCompileCacheGraphId());
     resource->set_compile_cache_dep_files_hash(GetCompileDepFilesHash(compile_cache_dep_files_));
     resource->set_func_graph(GetCachedFuncGraph(resource, weights_, queue_name_));
+    if (resource->func_graph() != nullptr) {
+      LoadKernelSelectCache();
+    }
 #ifdef ENABLE_PROFILE
     double t2 = GetTime();
     MsProfile::StatTime("LoadCachedFuncGraph", t2 - t1);
@@ -1045,6 +1088,10 @@ bool GraphExecutorPy::CompileInner(const py::object &source_obj, const py::tuple
   executor_info->resource = resource;
   info_[phase] = executor_info;
   pip->Run(phase);
+  // The kernels are selected in the backend actions, after the func graph is cached.
+  if (resource->enable_compile_cache()) {
+    CacheKernelSelect();
+  }
 
   // Save the compiled graph to MsPipeLine.
   SaveCompiledGraph(phase);
@@ -65,6 +65,8 @@ struct OpExecInfo {
 #endif
   std::vector<int64_t> inputs_mask;
   bool lazy_build = false;
+  // The key of the op in the PyNative infer cache, which is empty if the op isn't cached.
+  std::string infer_cache_key;
 };
 using OpExecInfoPtr = std::shared_ptr<OpExecInfo>;
 
@@ -55,6 +55,7 @@
 #include "pipeline/jit/pipeline.h"
 #include "pipeline/jit/resource.h"
 #include "pipeline/pynative/base.h"
+#include "pipeline/pynative/pynative_infer_cache.h"
 #include "backend/session/session_factory.h"
 #include "backend/optimizer/common/const_input_to_attr_registry.h"
 #include "backend/optimizer/common/helper.h"
@@ -1190,6 +1191,18 @@ void ForwardExecutor::GetOpOutputAbstract(const OpExecInfoPtr &op_exec_info,
     }
   }
 
+  // Look up the abstract inferred by the former runs, which are only cached without the evaluate added attributes.
+  // The key is kept to save the abstract inferred below, so it is built once for the op missing the memory cache.
+  auto &infer_cache = PynativeInferCache::GetInstance();
+  if (op_exec_info->abstract == nullptr && infer_cache.enable() &&
+      force_infer_prim.find(op_name) == force_infer_prim.end() && PynativeInferCache::IsCacheable(prim)) {
+    op_exec_info->infer_cache_key = PynativeInferCache::GetKey(prim, args_spec_list);
+    if (!op_exec_info->infer_cache_key.empty()) {
+      op_exec_info->abstract = infer_cache.Find(prim, op_exec_info->infer_cache_key);
+      MS_LOG(DEBUG) << "Match prim in infer cache " << op_name << " " << (op_exec_info->abstract != nullptr);
+    }
+  }
+
   if (op_exec_info->abstract == nullptr || force_infer_prim.find(op_name) != force_infer_prim.end()) {
     // Use python infer method
     if (ignore_infer_prim.find(op_name) == ignore_infer_prim.end()) {
@@ -1249,6 +1262,9 @@ void ForwardExecutor::GetOpOutput(const OpExecInfoPtr &op_exec_info,
     auto &out = prim_abs_list_[key];
     out[args_spec_list].abs = op_exec_info->abstract;
     out[args_spec_list].attrs = prim->evaluate_added_attrs();
+    if (!op_exec_info->infer_cache_key.empty() && prim->evaluate_added_attrs().empty()) {
+      PynativeInferCache::GetInstance().Insert(op_exec_info->infer_cache_key, op_exec_info->abstract);
+    }
   }
 
   // Run op with selected backend, nop is no need run backend
@@ -2206,6 +2222,7 @@ py::object ForwardExecutor::RunOpInMs(const OpExecInfoPtr &op_exec_info, Pynativ
 
 void ForwardExecutor::ClearRes() {
   MS_LOG(DEBUG) << "Clear forward res";
+  PynativeInferCache::GetInstance().Save();
   lazy_build_ = false;
   implicit_cast_map_.clear();
   prim_abs_list_.clear();
@@ -0,0 +1,286 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/pynative/pynative_infer_cache.h"
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include "nlohmann/json.hpp"
+#include "abstract/primitive_infer_map.h"
+#include "utils/file_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace pynative {
+namespace {
+constexpr char kInferCachePathEnv[] = "MS_DEV_PYNATIVE_INFER_CACHE_PATH";
+// The file is named by the version, because the infer implementations may change between the versions.
+constexpr char kInferCacheFileName[] = "pynative_infer_cache_" MSVERSION ".json";
+constexpr char kIsTuple[] = "is_tuple";
+constexpr char kTypes[] = "types";
+constexpr char kShapes[] = "shapes";
+
+bool IsStaticTensor(const abstract::AbstractBasePtr &abs) {
+  MS_EXCEPTION_IF_NULL(abs);
+  auto tensor_abs = abs->cast<abstract::AbstractTensorPtr>();
+  if (tensor_abs == nullptr || tensor_abs->element() == nullptr) {
+    return false;
+  }
+  // The tensor with value is folded by the infer, so it is inferred again in each step.
+  auto value = abs->GetValueTrack();
+  if (value == nullptr || !value->isa<AnyValue>()) {
+    return false;
+  }
+  auto shape = abs->BuildShape();
+  return shape != nullptr && shape->isa<abstract::Shape>() && !shape->IsDynamic();
+}
+
+bool AppendArgKey(const abstract::AbstractBasePtr &abs, std::ostringstream *buf) {
+  MS_EXCEPTION_IF_NULL(abs);
+  MS_EXCEPTION_IF_NULL(buf);
+  if (abs->isa<abstract::AbstractTensor>()) {
+    if (!IsStaticTensor(abs)) {
+      return false;
+    }
+    auto tensor_abs = abs->cast<abstract::AbstractTensorPtr>();
+    *buf << (abs->isa<abstract::AbstractRef>() ? "R" : "T") << tensor_abs->element()->BuildType()->type_id()
+         << abs->BuildShape()->ToString();
+    return true;
+  }
+  if (abs->isa<abstract::AbstractScalar>() || abs->isa<abstract::AbstractType>() ||
+      abs->isa<abstract::AbstractNone>()) {
+    auto value = abs->BuildValue();
+    MS_EXCEPTION_IF_NULL(value);
+    *buf << "S" << abs->BuildType()->ToString() << ":" << value->ToString();
+    return true;
+  }
+  if (abs->isa<abstract::AbstractSequence>()) {
+    *buf << (abs->isa<abstract::AbstractList>() ? "[" : "(");
+    for (const auto &element : abs->cast<abstract::AbstractSequencePtr>()->elements()) {
+      if (!AppendArgKey(element, buf)) {
+        return false;
+      }
+      *buf << ",";
+    }
+    *buf << (abs->isa<abstract::AbstractList>() ? "]" : ")");
+    return true;
+  }
+  return false;
+}
+
+bool AbstractToInfo(const abstract::AbstractBasePtr &abs, InferOutputInfo *info) {
+  MS_EXCEPTION_IF_NULL(abs);
+  MS_EXCEPTION_IF_NULL(info);
+  abstract::AbstractBasePtrList elements{abs};
+  if (abs->isa<abstract::AbstractTuple>()) {
+    info->is_tuple = true;
+    elements = abs->cast<abstract::AbstractTuplePtr>()->elements();
+  }
+  for (const auto &element : elements) {
+    if (element->isa<abstract::AbstractRef>() || !IsStaticTensor(element)) {
+      return false;
+    }
+    auto tensor_abs = element->cast<abstract::AbstractTensorPtr>();
+    (void)info->types.emplace_back(tensor_abs->element()->BuildType()->type_id());
+    (void)info->shapes.emplace_back(element->BuildShape()->cast<abstract::ShapePtr>()->shape());
+  }
+  return true;
+}
+
+abstract::AbstractBasePtr InfoToAbstract(const InferOutputInfo &info) {
+  abstract::AbstractBasePtrList elements;
+  for (size_t i = 0; i < info.types.size(); ++i) {
+    (void)elements.emplace_back(
+      std::make_shared<abstract::AbstractTensor>(TypeIdToType(info.types[i]), info.shapes[i]));
+  }
+  if (info.is_tuple) {
+    return std::make_shared<abstract::AbstractTuple>(elements);
+  }
+  return elements.empty() ? nullptr : elements[0];
+}
+}  // namespace
+
+PynativeInferCache::PynativeInferCache() {
+  auto dir = common::GetEnv(kInferCachePathEnv);
+  if (!dir.empty()) {
+    file_path_ = dir + "/" + kInferCacheFileName;
+  }
+}
+
+bool PynativeInferCache::IsCacheable(const PrimitivePtr &prim) {
+  MS_EXCEPTION_IF_NULL(prim);
+  // Only the operators inferred by the C++ implementations of this version are cached. The python infer, e.g. that of
+  // the custom operators or the primitives defined by the users, may change between the runs.
+  return abstract::GetPrimitiveInferImpl(prim).infer_shape_impl_ != nullptr;
+}
+
+std::string PynativeInferCache::GetKey(const PrimitivePtr &prim, const abstract::AbstractBasePtrList &args_spec_list) {
+  if (!IsCacheable(prim)) {
+    return "";
+  }
+  std::ostringstream buf;
+  buf << prim->name() << "{";
+  // Sort the attributes so that the key doesn't depend on the order of the hash map.
+  std::map<std::string, std::string> attrs;
+  for (const auto &attr : prim->attrs()) {
+    MS_EXCEPTION_IF_NULL(attr.second);
+    attrs[attr.first] = attr.second->ToString();
+  }
+  for (const auto &attr : attrs) {
+    buf << attr.first << "=" << attr.second << ",";
+  }
+  buf << "}";
+  for (const auto &arg : args_spec_list) {
+    if (!AppendArgKey(arg, &buf)) {
+      return "";
+    }
+    buf << ";";
+  }
+  return buf.str();
+}
+
+void PynativeInferCache::LoadOnce() {
+  std::call_once(load_flag_, [this]() {
+    if (enable()) {
+      (void)Load(file_path_);
+    }
+  });
+}
+
+abstract::AbstractBasePtr PynativeInferCache::Find(const std::string &key) {
+  LoadOnce();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = infos_.find(key);
+  if (iter == infos_.end()) {
+    return nullptr;
+  }
+  return InfoToAbstract(iter->second);
+}
+
+abstract::AbstractBasePtr PynativeInferCache::Find(const PrimitivePtr &prim, const std::string &key) {
+  MS_EXCEPTION_IF_NULL(prim);
+  auto abs = Find(key);
+  if (abs != nullptr) {
+    prim->BeginRecordAddAttr();
+    prim->EndRecordAddAttr();
+  }
+  return abs;
+}
+
+void PynativeInferCache::Insert(const std::string &key, const abstract::AbstractBasePtr &abs) {
+  InferOutputInfo info;
+  if (!AbstractToInfo(abs, &info)) {
+    return;
+  }
+  LoadOnce();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (infos_.emplace(key, std::move(info)).second) {
+    changed_ = true;
+  }
+}
+
+bool PynativeInferCache::Load(const std::string &file_path) {
+  std::ifstream fin(file_path);
+  if (!fin.is_open()) {
+    MS_LOG(INFO) << "Open the PyNative infer cache file " << file_path << " failed. The file may not exist.";
+    return false;
+  }
+  nlohmann::json js;
+  std::lock_guard<std::mutex> lock(mutex_);
+  try {
+    fin >> js;
+    for (const auto &item : js.items()) {
+      const auto &value = item.value();
+      InferOutputInfo info;
+      info.is_tuple = value.at(kIsTuple).get<bool>();
+      for (auto type : value.at(kTypes).get<std::vector<int>>()) {
+        (void)info.types.emplace_back(static_cast<TypeId>(type));
+      }
+      info.shapes = value.at(kShapes).get<std::vector<ShapeVector>>();
+      if (info.types.size() != info.shapes.size()) {
+        MS_LOG(WARNING) << "The size of types " << info.types.size() << " is not equal to the size of shapes "
+                        << info.shapes.size() << " for " << item.key();
+        continue;
+      }
+      (void)infos_.emplace(item.key(), std::move(info));
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Parse the PyNative infer cache file " << file_path << " failed: " << e.what();
+    fin.close();
+    return false;
+  }
+  fin.close();
+  MS_LOG(INFO) << "Load " << infos_.size() << " infer results from " << file_path;
+  return true;
+}
+
+bool PynativeInferCache::Save(const std::string &file_path) {
+  nlohmann::json js;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!changed_) {
+      return true;
+    }
+    for (const auto &item : infos_) {
+      const auto &info = item.second;
+      std::vector<int> types;
+      for (auto type : info.types) {
+        (void)types.emplace_back(static_cast<int>(type));
+      }
+      js[item.first] = {{kIsTuple, info.is_tuple}, {kTypes, types}, {kShapes, info.shapes}};
+    }
+    changed_ = false;
+  }
+  // Write to a temporary file and rename it, so the processes loading the file never see it half written.
+  auto temp_path = file_path + "." + std::to_string(getpid());
+  std::ofstream fout(temp_path);
+  if (!fout.is_open()) {
+    MS_LOG(ERROR) << "Open the PyNative infer cache file " << temp_path << " failed.";
+    return false;
+  }
+  fout << js.dump();
+  fout.close();
+  if (std::rename(temp_path.c_str(), file_path.c_str()) != 0) {
+    MS_LOG(ERROR) << "Rename " << temp_path << " to " << file_path << " failed.";
+    (void)std::remove(temp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+void PynativeInferCache::Save() {
+  if (!enable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!changed_) {
+      return;
+    }
+  }
+  auto dir = common::GetEnv(kInferCachePathEnv);
+  if (!FileUtils::CreateNotExistDirs(dir, true).has_value()) {
+    MS_LOG(ERROR) << "Create the PyNative infer cache directory " << dir << " failed.";
+    return;
+  }
+  // Merge the results saved by the other processes after this one loaded the file.
+  (void)Load(file_path_);
+  (void)Save(file_path_);
+}
+}  // namespace pynative
+}  // namespace mindspore
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_PYNATIVE_PYNATIVE_INFER_CACHE_H_
+#define MINDSPORE_CCSRC_PIPELINE_PYNATIVE_PYNATIVE_INFER_CACHE_H_
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include "utils/hash_map.h"
+#include "utils/ms_utils.h"
+#include "ir/primitive.h"
+#include "abstract/abstract_value.h"
+
+namespace mindspore {
+namespace pynative {
+// The data types and shapes of the output tensors inferred for an operator.
+struct InferOutputInfo {
+  bool is_tuple{false};
+  std::vector<TypeId> types;
+  std::vector<ShapeVector> shapes;
+};
+
+// Persist the output abstracts inferred for the operators in PyNative mode across the processes, keyed by the
+// primitive name, the attributes and the abstracts of the inputs, so the python infer of the operators is skipped in
+// the warm start. It is enabled by setting the env MS_DEV_PYNATIVE_INFER_CACHE_PATH to a directory, loaded when first
+// used and saved when the forward executor is cleared, in a file named by the MindSpore version. Only the operators
+// with C++ infer implementations, whose inputs and outputs are static shape tensors or constant scalars, are cached.
+class PynativeInferCache {
+ public:
+  static PynativeInferCache &GetInstance() noexcept {
+    static PynativeInferCache instance;
+    return instance;
+  }
+
+  bool enable() const { return !file_path_.empty(); }
+
+  // Only the operators inferred by the C++ implementations are cached, which is checked before building the key.
+  static bool IsCacheable(const PrimitivePtr &prim);
+  // Return an empty key if the operator can't be cached.
+  static std::string GetKey(const PrimitivePtr &prim, const abstract::AbstractBasePtrList &args_spec_list);
+
+  // Return nullptr if the key is not found.
+  abstract::AbstractBasePtr Find(const std::string &key);
+  // Find the abstract inferred for the primitive by the former runs. The abstracts are only cached when the infer adds
+  // no attributes, so on a hit the attributes recorded by the former infer of the primitive are cleared, as the infer
+  // would do.
+  abstract::AbstractBasePtr Find(const PrimitivePtr &prim, const std::string &key);
+  // The abstracts other than the static shape tensors and the tuples of them are ignored.
+  void Insert(const std::string &key, const abstract::AbstractBasePtr &abs);
+
+  // Load the abstracts saved by the former runs from the json file, the abstracts inserted already are kept.
+  bool Load(const std::string &file_path);
+  // Save the abstracts to the json file if any abstract is inserted after the last loading or saving.
+  bool Save(const std::string &file_path);
+  // Save to the file in the directory of MS_DEV_PYNATIVE_INFER_CACHE_PATH, merged with the file saved by the others.
+  void Save();
+
+ private:
+  PynativeInferCache();
+  ~PynativeInferCache() = default;
+  DISABLE_COPY_AND_ASSIGN(PynativeInferCache);
+
+  void LoadOnce();
+
+  std::string file_path_;
+  std::once_flag load_flag_;
+  mindspore::HashMap<std::string, InferOutputInfo> infos_;
+  bool changed_{false};
+  std::mutex mutex_;
+};
+}  // namespace pynative
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_PYNATIVE_PYNATIVE_INFER_CACHE_H_
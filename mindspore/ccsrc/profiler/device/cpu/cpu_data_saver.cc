@@ -15,7 +15,10 @@
  */
 #include "profiler/device/cpu/cpu_data_saver.h"
 #include <fstream>
+#include <iomanip>
+#include <iterator>
 #include <numeric>
+#include "nlohmann/json.hpp"
 #include "sys/stat.h"
 #include "utils/log_adapter.h"
 #include "utils/ms_utils.h"
@@ -56,6 +59,47 @@ void CpuDataSaver::WriteFile(const std::string out_path_dir) {
   WriteOpDetail(out_path_dir);
   WriteOpType(out_path_dir);
   WriteOpTimestamp(out_path_dir);
+  WriteChromeTrace(out_path_dir);
+}
+
+void CpuDataSaver::ParseOpEvents(const std::vector<CPUOpEvent> &events, const std::vector<std::string> &op_names) {
+  op_events_ = events;
+  op_names_ = op_names;
+}
+
+void CpuDataSaver::WriteChromeTrace(const std::string &saver_base_dir) const {
+  if (op_events_.empty()) {
+    return;
+  }
+  std::string file_path = saver_base_dir + "/" + op_side_ + "_op_trace_" + device_id_ + ".json";
+  std::ofstream ofs(file_path);
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+    return;
+  }
+  // The names are escaped once, and the timestamps of the Chrome trace are in microseconds.
+  std::vector<std::string> names;
+  (void)std::transform(op_names_.begin(), op_names_.end(), std::back_inserter(names),
+                       [](const std::string &name) { return nlohmann::json(name).dump(); });
+  constexpr double kNanosecondToMicrosecond = 1000.0;
+  try {
+    ofs << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+    for (size_t i = 0; i < op_events_.size(); ++i) {
+      const auto &event = op_events_[i];
+      if (event.op_id >= names.size()) {
+        continue;
+      }
+      ofs << (i == 0 ? "" : ",") << "\n{\"name\":" << names[event.op_id] << ",\"ph\":\"X\",\"ts\":"
+          << event.start / kNanosecondToMicrosecond
+          << ",\"dur\":" << (event.end - event.start) / kNanosecondToMicrosecond << ",\"pid\":" << event.pid
+          << ",\"tid\":" << event.tid << "}";
+    }
+    ofs << "\n]}" << std::endl;
+  } catch (const std::exception &e) {
+    MS_LOG(ERROR) << "Write " << file_path << "failed: " << e.what();
+  }
+  ofs.close();
+  ChangeFileMode(file_path);
 }
 
 OpTimestampInfo &CpuDataSaver::GetOpTimeStampInfo() { return op_timestamps_map_; }
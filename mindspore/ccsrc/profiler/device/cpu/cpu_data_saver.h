@@ -43,8 +43,15 @@ class CpuDataSaver : public DataSaver {
 
   void WriteFile(const std::string out_path);
 
+  // Keep the op events of all the threads to write them in the Chrome trace format.
+  void ParseOpEvents(const std::vector<CPUOpEvent> &events, const std::vector<std::string> &op_names);
+
  private:
+  void WriteChromeTrace(const std::string &saver_base_dir) const;
+
   static std::shared_ptr<CpuDataSaver> cpu_data_saver_inst_;
+  std::vector<CPUOpEvent> op_events_;
+  std::vector<std::string> op_names_;
 };
 }  // namespace cpu
 }  // namespace profiler
@@ -55,14 +55,46 @@ void CPUProfiler::SetRunTimeData(const std::string &op_name, const uint32_t pid)
     op_info.op_count = 1;
     op_info_map_[op_name] = op_info;
   }
-  op_name_ = op_name;
-  pid_ = pid;
+}
+
+CPUThreadEvents *CPUProfiler::GetThreadEvents() {
+  // The profiler is a singleton, so the events of a thread are created once and kept by thread_events_.
+  thread_local std::shared_ptr<CPUThreadEvents> thread_events = nullptr;
+  if (thread_events == nullptr) {
+    thread_events = std::make_shared<CPUThreadEvents>();
+    std::lock_guard<std::mutex> locker(thread_events_mutex_);
+    thread_events->tid = static_cast<uint32_t>(thread_events_.size());
+    thread_events_.push_back(thread_events);
+  }
+  return thread_events.get();
+}
+
+uint32_t CPUProfiler::GetOpId(CPUThreadEvents *thread_events, const std::string &op_name) {
+  auto iter = thread_events->op_ids.find(op_name);
+  if (iter == thread_events->op_ids.end()) {
+    uint32_t op_id = 0;
+    {
+      std::lock_guard<std::mutex> locker(op_names_mutex_);
+      auto id_iter = op_name_ids_.find(op_name);
+      if (id_iter == op_name_ids_.end()) {
+        op_id = static_cast<uint32_t>(op_names_.size());
+        op_names_.push_back(op_name);
+        (void)op_name_ids_.emplace(op_name, op_id);
+      } else {
+        op_id = id_iter->second;
+      }
+    }
+    iter = thread_events->op_ids.emplace(op_name, op_id).first;
+  }
+  thread_events->current_op_name = &(iter->first);
+  return iter->second;
 }
 
 void CPUProfiler::OpDataProducerBegin(const std::string op_name, const uint32_t pid) {
-  op_time_start_ = GetHostMonoTimeStamp();
-  op_time_mono_start_ = GetHostMonoTimeStamp();
-  SetRunTimeData(op_name, pid);
+  auto thread_events = GetThreadEvents();
+  MS_EXCEPTION_IF_NULL(thread_events);
+  auto op_id = GetOpId(thread_events, op_name);
+  thread_events->current = {op_id, pid, thread_events->tid, GetHostMonoTimeStamp(), 0};
 
 #if ENABLE_GPU
   if (MsContext::GetInstance()->get_param<bool>(MS_CTX_ENABLE_MINDRT)) {
@@ -77,12 +109,37 @@ void CPUProfiler::OpDataProducerBegin(const std::string op_name, const uint32_t
 }
 
 void CPUProfiler::OpDataProducerEnd() {
-  float op_time_elapsed = 0;
-  op_time_stop_ = GetHostMonoTimeStamp();
-  op_time_elapsed = (op_time_stop_ - op_time_start_) / kNanosecondToMillisecond;
-  MS_LOG(DEBUG) << "Host Time Elapsed(ms)," << op_name_ << "," << op_time_elapsed;
-  Profiler::SetRunTimeData(op_name_, op_time_elapsed);
-  Profiler::SetRunTimeData(op_name_, op_time_mono_start_, op_time_elapsed);
+  auto thread_events = GetThreadEvents();
+  MS_EXCEPTION_IF_NULL(thread_events);
+  MS_EXCEPTION_IF_NULL(thread_events->current_op_name);
+  auto &event = thread_events->current;
+  event.end = GetHostMonoTimeStamp();
+  MS_LOG(DEBUG) << "Host Time Elapsed(ms)," << *(thread_events->current_op_name) << ","
+                << (event.end - event.start) / kNanosecondToMillisecond;
+  std::lock_guard<std::mutex> locker(thread_events->mutex);
+  thread_events->events.push_back(event);
+}
+
+std::vector<CPUOpEvent> CPUProfiler::MergeEvents() {
+  std::vector<CPUOpEvent> events;
+  {
+    std::lock_guard<std::mutex> locker(thread_events_mutex_);
+    for (const auto &thread_events : thread_events_) {
+      std::lock_guard<std::mutex> events_locker(thread_events->mutex);
+      (void)events.insert(events.end(), thread_events->events.begin(), thread_events->events.end());
+    }
+  }
+  std::sort(events.begin(), events.end(),
+            [](const CPUOpEvent &a, const CPUOpEvent &b) { return a.start < b.start; });
+  std::lock_guard<std::mutex> locker(op_names_mutex_);
+  for (const auto &event : events) {
+    const auto &op_name = op_names_[event.op_id];
+    float op_time_elapsed = (event.end - event.start) / kNanosecondToMillisecond;
+    SetRunTimeData(op_name, event.pid);
+    Profiler::SetRunTimeData(op_name, op_time_elapsed);
+    Profiler::SetRunTimeData(op_name, event.start, op_time_elapsed);
+  }
+  return events;
 }
 
 void CPUProfiler::Stop() {
@@ -97,12 +154,24 @@ void CPUProfiler::SaveProfileData() {
   } else {
     auto cpu_data_saver_inst = profiler::cpu::CpuDataSaver::GetInstance();
     MS_EXCEPTION_IF_NULL(cpu_data_saver_inst);
+    auto events = MergeEvents();
     cpu_data_saver_inst->ParseOpInfo(op_info_map_);
+    {
+      std::lock_guard<std::mutex> locker(op_names_mutex_);
+      cpu_data_saver_inst->ParseOpEvents(events, op_names_);
+    }
     cpu_data_saver_inst->WriteFile(profile_data_path_);
   }
 }
 
-void CPUProfiler::ClearInst() { op_info_map_.clear(); }
+void CPUProfiler::ClearInst() {
+  op_info_map_.clear();
+  std::lock_guard<std::mutex> locker(thread_events_mutex_);
+  for (const auto &thread_events : thread_events_) {
+    std::lock_guard<std::mutex> events_locker(thread_events->mutex);
+    thread_events->events.clear();
+  }
+}
 
 REGISTER_PYBIND_DEFINE(CPUProfiler_, ([](const py::module *m) {
                          (void)py::class_<CPUProfiler, std::shared_ptr<CPUProfiler>>(*m, "CPUProfiler")
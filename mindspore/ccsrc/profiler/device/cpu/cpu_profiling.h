@@ -23,6 +23,8 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
+#include <mutex>
 #include "profiler/device/profiling.h"
 #if ENABLE_GPU
 #include "profiler/device/gpu/gpu_profiling.h"
@@ -33,6 +35,27 @@ namespace profiler {
 namespace cpu {
 const float kNanosecondToMillisecond = 1000000;
 
+struct CPUOpEvent {
+  uint32_t op_id;
+  uint32_t pid;
+  uint32_t tid;
+  uint64_t start;
+  uint64_t end;
+};
+
+// The ops launched by a thread, which only the thread appends to, so the lock is taken by others only when saving.
+struct CPUThreadEvents {
+  std::mutex mutex;
+  uint32_t tid{0};
+  std::vector<CPUOpEvent> events;
+  CPUOpEvent current{};
+  const std::string *current_op_name{nullptr};
+  // The op ids found by the thread, to look up the shared op names only once per op.
+  std::unordered_map<std::string, uint32_t> op_ids;
+};
+
+// The kernels are launched by several actor threads at the same time, so each thread records its ops into its own
+// events, which are merged when saving the profile data.
 class CPUProfiler : public Profiler {
  public:
   static std::shared_ptr<CPUProfiler> &GetInstance();
@@ -51,15 +74,19 @@ class CPUProfiler : public Profiler {
   void SetRunTimeData(const std::string &op_name, const uint32_t pid);
   void SaveProfileData() override;
   void ClearInst() override;
+  CPUThreadEvents *GetThreadEvents();
+  uint32_t GetOpId(CPUThreadEvents *thread_events, const std::string &op_name);
+  // Merge the events of all the threads into op_info_map_ in the order of the start time.
+  std::vector<CPUOpEvent> MergeEvents();
 
   static std::shared_ptr<CPUProfiler> profiler_inst_;
   uint64_t base_time_;
-  std::string op_name_;
-  uint32_t pid_;
 
-  uint64_t op_time_start_;
-  uint64_t op_time_mono_start_;
-  uint64_t op_time_stop_;
+  std::mutex op_names_mutex_;
+  std::vector<std::string> op_names_;
+  std::unordered_map<std::string, uint32_t> op_name_ids_;
+  std::mutex thread_events_mutex_;
+  std::vector<std::shared_ptr<CPUThreadEvents>> thread_events_;
 };
 }  // namespace cpu
 }  // namespace profiler
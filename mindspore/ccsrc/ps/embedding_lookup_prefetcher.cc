@@ -0,0 +1,191 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/embedding_lookup_prefetcher.h"
+#include <utility>
+#include "utils/hash_set.h"
+#include "securec/include/securec.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+EmbeddingLookupPrefetcher::EmbeddingLookupPrefetcher(size_t row_size, size_t max_staleness, LookupFunc lookup_func)
+    : row_size_(row_size), max_staleness_(max_staleness), lookup_func_(std::move(lookup_func)) {
+  MS_EXCEPTION_IF_NULL(lookup_func_);
+  if (row_size_ == 0) {
+    MS_LOG(EXCEPTION) << "The row size of the embedding table should be positive.";
+  }
+  worker_ = std::thread(&EmbeddingLookupPrefetcher::Run, this);
+}
+
+EmbeddingLookupPrefetcher::~EmbeddingLookupPrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void EmbeddingLookupPrefetcher::Run() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return stop_ || requested_; });
+      if (stop_) {
+        return;
+      }
+      requested_ = false;
+    }
+    // prefetch_ids_ is not touched by the caller until pending_ is reset.
+    std::vector<float> rows(prefetch_ids_.size() * row_size_, 0);
+    bool ok = lookup_func_(prefetch_ids_, &rows);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      prefetch_rows_ = std::move(rows);
+      prefetch_ok_ = ok;
+      pending_ = false;
+    }
+    cv_.notify_all();
+  }
+}
+
+void EmbeddingLookupPrefetcher::WaitPrefetch() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return !pending_; });
+  }
+  if (prefetch_ids_.empty()) {
+    return;
+  }
+  if (prefetch_ok_) {
+    Insert(prefetch_ids_, prefetch_rows_, prefetch_step_);
+  } else {
+    MS_LOG(WARNING) << "Prefetch the embedding lookup failed, the ids are looked up again when used.";
+  }
+  prefetch_ids_.clear();
+  prefetch_rows_.clear();
+}
+
+void EmbeddingLookupPrefetcher::Prefetch(const std::vector<int> &ids) {
+  WaitPrefetch();
+  // The rows prefetched now may miss the gradients pushed in the current step.
+  size_t step = step_ == 0 ? 0 : step_ - 1;
+  mindspore::HashSet<int> requested;
+  for (auto id : ids) {
+    auto iter = rows_.find(id);
+    if ((iter == rows_.end() || iter->second.step < step) && requested.insert(id).second) {
+      prefetch_ids_.push_back(id);
+    }
+  }
+  if (prefetch_ids_.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    prefetch_step_ = step;
+    requested_ = true;
+    pending_ = true;
+  }
+  cv_.notify_all();
+}
+
+bool EmbeddingLookupPrefetcher::Lookup(const std::vector<int> &ids, float *result, size_t result_size) {
+  MS_EXCEPTION_IF_NULL(result);
+  if (result_size < ids.size() * row_size_) {
+    MS_LOG(ERROR) << "The result size " << result_size << " is less than " << ids.size() << " rows of " << row_size_;
+    return false;
+  }
+  WaitPrefetch();
+  std::vector<int> miss_ids;
+  mindspore::HashSet<int> requested;
+  for (auto id : ids) {
+    auto iter = rows_.find(id);
+    if (iter != rows_.end() && step_ - iter->second.step <= max_staleness_) {
+      ++hit_num_;
+      continue;
+    }
+    ++miss_num_;
+    if (requested.insert(id).second) {
+      miss_ids.push_back(id);
+    }
+  }
+  if (!miss_ids.empty()) {
+    std::vector<float> miss_rows(miss_ids.size() * row_size_, 0);
+    if (!lookup_func_(miss_ids, &miss_rows)) {
+      MS_LOG(ERROR) << "Look up " << miss_ids.size() << " embedding rows failed.";
+      return false;
+    }
+    Insert(miss_ids, miss_rows, step_);
+  }
+
+  size_t row_bytes = row_size_ * sizeof(float);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    const auto &row = rows_[ids[i]];
+    auto ret = memcpy_s(result + i * row_size_, (result_size - i * row_size_) * sizeof(float),
+                        values_.data() + row.offset, row_bytes);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Copy the embedding row failed, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  ++step_;
+  EvictStaleRows();
+  return true;
+}
+
+void EmbeddingLookupPrefetcher::Insert(const std::vector<int> &ids, const std::vector<float> &rows, size_t step) {
+  size_t row_bytes = row_size_ * sizeof(float);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    auto iter = rows_.find(ids[i]);
+    if (iter == rows_.end()) {
+      size_t offset = values_.size();
+      if (!free_offsets_.empty()) {
+        offset = free_offsets_.back();
+        free_offsets_.pop_back();
+      } else {
+        values_.resize(values_.size() + row_size_);
+      }
+      iter = rows_.emplace(ids[i], Row{offset, step}).first;
+    } else if (iter->second.step > step) {
+      continue;
+    }
+    iter->second.step = step;
+    auto ret = memcpy_s(values_.data() + iter->second.offset, row_bytes, rows.data() + i * row_size_, row_bytes);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Copy the embedding row failed, errorno(" << ret << ")";
+    }
+  }
+}
+
+void EmbeddingLookupPrefetcher::EvictStaleRows() {
+  // Rows get stale only every max_staleness steps, so scanning them then keeps the cost per step constant.
+  if (step_ % (max_staleness_ + 1) != 0) {
+    return;
+  }
+  for (auto iter = rows_.begin(); iter != rows_.end();) {
+    if (step_ - iter->second.step > max_staleness_) {
+      free_offsets_.push_back(iter->second.offset);
+      iter = rows_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_EMBEDDING_LOOKUP_PREFETCHER_H_
+#define MINDSPORE_CCSRC_PS_EMBEDDING_LOOKUP_PREFETCHER_H_
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "utils/hash_map.h"
+
+namespace mindspore {
+namespace ps {
+// Overlap the embedding lookup of the next step with the compute and the gradient push of the current step.
+// The rows prefetched in the background are used for at most max_staleness steps, during which they miss the
+// gradients pushed by this worker and others, and the rows not prefetched are looked up synchronously.
+class EmbeddingLookupPrefetcher {
+ public:
+  // Look up the rows of the unique ids from the servers.
+  using LookupFunc = std::function<bool(const std::vector<int> &ids, std::vector<float> *rows)>;
+
+  EmbeddingLookupPrefetcher(size_t row_size, size_t max_staleness, LookupFunc lookup_func);
+  ~EmbeddingLookupPrefetcher();
+
+  // Start looking up the ids expected in the next steps, e.g. the ids of the current step or of the next batch.
+  void Prefetch(const std::vector<int> &ids);
+  // Fill the rows of the ids of the current step to the result, and move to the next step.
+  bool Lookup(const std::vector<int> &ids, float *result, size_t result_size);
+
+  size_t hit_num() const { return hit_num_; }
+  size_t miss_num() const { return miss_num_; }
+
+ private:
+  struct Row {
+    size_t offset;
+    size_t step;
+  };
+
+  void Run();
+  void WaitPrefetch();
+  void Insert(const std::vector<int> &ids, const std::vector<float> &rows, size_t step);
+  void EvictStaleRows();
+
+  size_t row_size_;
+  size_t max_staleness_;
+  LookupFunc lookup_func_;
+  size_t step_{0};
+
+  // The rows are packed in values_, and the slots of the evicted rows are reused.
+  mindspore::HashMap<int, Row> rows_;
+  std::vector<float> values_;
+  std::vector<size_t> free_offsets_;
+
+  // The prefetch running in worker_, at most one at a time.
+  std::thread worker_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_{false};
+  bool requested_{false};
+  bool pending_{false};
+  bool prefetch_ok_{true};
+  size_t prefetch_step_{0};
+  std::vector<int> prefetch_ids_;
+  std::vector<float> prefetch_rows_;
+
+  size_t hit_num_{0};
+  size_t miss_num_{0};
+};
+using EmbeddingLookupPrefetcherPtr = std::shared_ptr<EmbeddingLookupPrefetcher>;
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_EMBEDDING_LOOKUP_PREFETCHER_H_
@@ -808,27 +808,34 @@ void ParameterServer::PersistParameters() {
   }
 
   auto do_persist_task = [this]() {
-    std::unique_lock<std::mutex> locker(access_weight_mutex_);
-
-    set_persistent_state(core::PersistentState::PERSISTING);
+    std::vector<std::shared_future<void>> persist_futures;
+    {
+      // Only the dirty blocks are copied with the weights locked, and they are written to disk in the background.
+      std::unique_lock<std::mutex> locker(access_weight_mutex_);
+
+      set_persistent_state(core::PersistentState::PERSISTING);
+
+      for (const auto &weight_key_pair : weights_) {
+        const WeightPtr &weight = weight_key_pair.second;
+        auto persistent_weight = std::dynamic_pointer_cast<PersistentWeight>(weight);
+        MS_EXCEPTION_IF_NULL(persistent_weight);
+
+        Key key = weight_key_pair.first;
+        auto iter = weights_dirty_info_.find(key);
+        if (iter == weights_dirty_info_.end()) {
+          MS_LOG(EXCEPTION) << "Cannot find dirty info for weight, key: " << key;
+        }
 
-    for (const auto &weight_key_pair : weights_) {
-      const WeightPtr &weight = weight_key_pair.second;
-      auto persistent_weight = std::dynamic_pointer_cast<PersistentWeight>(weight);
-      MS_EXCEPTION_IF_NULL(persistent_weight);
+        distributed::storage::DirtyInfo &dirty_info = iter->second;
+        (void)persist_futures.emplace_back(persistent_weight->PersistAsync(dirty_info));
 
-      Key key = weight_key_pair.first;
-      auto iter = weights_dirty_info_.find(key);
-      if (iter == weights_dirty_info_.end()) {
-        MS_LOG(EXCEPTION) << "Cannot find dirty info for weight, key: " << key;
+        dirty_info.clear();
       }
-
-      distributed::storage::DirtyInfo &dirty_info = iter->second;
-      persistent_weight->Persist(dirty_info);
-
-      dirty_info.clear();
     }
 
+    for (const auto &persist_future : persist_futures) {
+      persist_future.get();
+    }
     set_persistent_state(core::PersistentState::FINISH_PERSIST);
     MS_LOG(INFO) << "Finish persist weights in parameter server";
   };
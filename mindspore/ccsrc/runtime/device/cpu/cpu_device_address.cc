@@ -47,7 +47,7 @@ bool CPUDeviceAddress::DumpMemToFile(const std::string &filepath, const std::str
   }
   std::string path = filepath + '.' + format_;
   MS_LOG(DEBUG) << "E2E Dump path is " << path;
-  ret = DumpJsonParser::DumpToFile(path, ptr_, size_, host_shape, host_type);
+  ret = DumpJsonParser::DumpToFile(path, ptr_, size_, host_shape, host_type, true);
 #endif
   return ret;
 }
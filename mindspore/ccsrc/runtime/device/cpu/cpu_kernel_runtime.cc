@@ -502,6 +502,7 @@ bool CPUKernelRuntime::Run(const session::KernelGraph &kernel_graph, bool) {
   if (iter_dump_flag) {
     CPUE2eDump::DumpParameters(&kernel_graph, graph_id);
     CPUE2eDump::DumpConstants(&kernel_graph, graph_id);
+    CPUE2eDump::FlushDumpData();
   }
   if (graph_id == 0) {
     dump_json_parser.UpdateDumpIter();
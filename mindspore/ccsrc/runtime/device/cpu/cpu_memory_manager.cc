@@ -94,7 +94,8 @@ void CPUMemoryManager::AssignMemory(const session::KernelGraph *graph) {
     }
     mem_ptr_ = MemMalloc(graph_mem_size);
     if (mem_ptr_ != nullptr) {
-      MS_LOG(INFO) << "Simple MemPlan GraphMemSize [" << graph_mem_size << "]";
+      MS_LOG(INFO) << "Simple MemPlan GraphMemSize [" << graph_mem_size << "], without reuse [" << mem_plan_.naive_size()
+                   << "]";
       mem_size_ = graph_mem_size;
       dynamic_malloc_ = false;
     } else {
@@ -50,6 +50,9 @@ class CPUMemoryManager : public MemoryManager {
     return CPUMemoryPool::GetInstance().AllocTensorMem(size, from_persistent_mem);
   }
   void FreeMemFromMemPool(void *device_ptr) override { CPUMemoryPool::GetInstance().FreeTensorMem(device_ptr); }
+  void FreeMemsFromMemPool(const std::vector<void *> &device_ptrs) override {
+    CPUMemoryPool::GetInstance().FreeTensorMems(device_ptrs);
+  }
   std::vector<void *> MallocContinuousMemFromMemPool(size_t total_size, std::vector<size_t> size_list) override {
     return CPUMemoryPool::GetInstance().AllocContinuousTensorMem(total_size, size_list);
   }
@@ -14,16 +14,63 @@
  * limitations under the License.
  */
 #include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
 #include "backend/session/anf_runtime_algorithm.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+namespace {
+constexpr size_t kMemAlignSize = 32;
+constexpr size_t kMemPlanReserveSize = 32;
+
+size_t AlignMemorySize(size_t size) { return (size + kMemAlignSize - 1) / kMemAlignSize * kMemAlignSize; }
+
+class MemBlockCollector {
+ public:
+  explicit MemBlockCollector(std::vector<CPUMemBlock> *blocks) : blocks_(blocks) {}
+
+  // address is used at step, blocks seen for the first time at a use are made live from the beginning because
+  // they are filled outside of the graph
+  void Use(DeviceAddress *address, size_t step, bool is_def, size_t size) {
+    auto iter = index_.find(address);
+    if (iter == index_.end()) {
+      CPUMemBlock block;
+      block.address_ = address;
+      block.size_ = size;
+      block.start_ = is_def ? step : 0;
+      block.end_ = step;
+      index_[address] = blocks_->size();
+      blocks_->push_back(block);
+      return;
+    }
+    auto &block = blocks_->at(iter->second);
+    block.end_ = std::max(block.end_, step);
+  }
+
+  void KeepAlive(const DeviceAddress *address, size_t last_step) {
+    auto iter = index_.find(address);
+    if (iter != index_.end()) {
+      blocks_->at(iter->second).end_ = last_step;
+    }
+  }
+
+ private:
+  std::vector<CPUMemBlock> *blocks_;
+  std::unordered_map<const DeviceAddress *, size_t> index_;
+};
+}  // namespace
+
+void CPUSimpleMemPlan::CollectMemBlocks(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
-  size_t total_mem_size = 32;
+  blocks_.clear();
+  naive_size_ = kMemPlanReserveSize;
+  MemBlockCollector collector(&blocks_);
   auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
+  for (size_t step = 0; step < kernels.size(); ++step) {
+    const auto &kernel = kernels[step];
     MS_EXCEPTION_IF_NULL(kernel);
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
@@ -32,19 +79,28 @@ size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
       if (kernel_with_index.first->isa<Parameter>()) {
         continue;
       }
-      auto address = AnfAlgo::GetOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
       MS_EXCEPTION_IF_NULL(address);
       if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
+        collector.Use(address.get(), step, false, address->size_);
       }
     }
 
     size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
     for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetOutputAddr(kernel, i);
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
       MS_EXCEPTION_IF_NULL(address);
       if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
+        collector.Use(address.get(), step, true, address->size_);
+      }
+      // a ref output aliases its origin, both are kept for the whole graph
+      session::AnfWithOutIndex out_pair(kernel, i);
+      if (graph->IsInRefOutputMap(out_pair)) {
+        auto origin = graph->GetRefCorrespondOutput(out_pair);
+        collector.KeepAlive(address.get(), kernels.size());
+        if (origin.first != nullptr && AnfAlgo::OutputAddrExist(origin.first, origin.second)) {
+          collector.KeepAlive(AnfAlgo::GetOutputAddr(origin.first, origin.second, true), kernels.size());
+        }
       }
     }
 
@@ -54,57 +110,104 @@ size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
       auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
       MS_EXCEPTION_IF_NULL(address);
       if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
+        collector.Use(address, step, true, address->size_);
       }
     }
   }
 
-  return total_mem_size;
+  // graph outputs and summary values are read after the last kernel
+  for (const auto &output : AnfAlgo::GetAllOutputWithIndex(graph->output())) {
+    if (output.first != nullptr && AnfAlgo::OutputAddrExist(output.first, output.second)) {
+      collector.KeepAlive(AnfAlgo::GetOutputAddr(output.first, output.second, true), kernels.size());
+    }
+  }
+  for (const auto &summary : graph->summary_nodes()) {
+    auto node = summary.second.first;
+    auto index = IntToSize(summary.second.second);
+    if (node != nullptr && AnfAlgo::OutputAddrExist(node, index)) {
+      collector.KeepAlive(AnfAlgo::GetOutputAddr(node, index, true), kernels.size());
+    }
+  }
+  for (const auto &block : blocks_) {
+    naive_size_ += block.size_;
+  }
 }
 
-void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
-  MS_EXCEPTION_IF_NULL(graph);
-  MS_EXCEPTION_IF_NULL(base_ptr);
-  uint8_t *mem_ptr = base_ptr;
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
-    MS_EXCEPTION_IF_NULL(kernel);
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto kernel_with_index = AnfAlgo::GetPrevNodeOutput(kernel, i);
-      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
-      if (kernel_with_index.first->isa<Parameter>()) {
+size_t CPUSimpleMemPlan::PlanOffsets(std::vector<CPUMemBlock> *blocks) {
+  MS_EXCEPTION_IF_NULL(blocks);
+  std::vector<size_t> order(blocks->size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [blocks](size_t a, size_t b) {
+    const auto &block_a = blocks->at(a);
+    const auto &block_b = blocks->at(b);
+    if (block_a.size_ != block_b.size_) {
+      return block_a.size_ > block_b.size_;
+    }
+    return block_a.start_ < block_b.start_;
+  });
+
+  size_t total_size = 0;
+  // placed blocks ordered by offset, so the gaps of each block are found in one pass without sorting again
+  std::vector<size_t> placed;
+  placed.reserve(order.size());
+  for (auto index : order) {
+    auto &block = blocks->at(index);
+    size_t size = AlignMemorySize(block.size_);
+    size_t best_offset = 0;
+    size_t best_gap = std::numeric_limits<size_t>::max();
+    size_t candidate = 0;
+    for (auto other_index : placed) {
+      const auto &other = blocks->at(other_index);
+      if (other.start_ > block.end_ || block.start_ > other.end_) {
         continue;
       }
-      auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
+      if (other.offset_ > candidate) {
+        size_t gap = other.offset_ - candidate;
+        if (gap >= size && gap < best_gap) {
+          best_gap = gap;
+          best_offset = candidate;
+        }
       }
+      candidate = std::max(candidate, other.offset_ + AlignMemorySize(other.size_));
     }
-
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+    if (best_gap == std::numeric_limits<size_t>::max()) {
+      best_offset = candidate;
     }
+    block.offset_ = best_offset;
+    total_size = std::max(total_size, best_offset + size);
+    auto pos = std::upper_bound(placed.begin(), placed.end(), best_offset, [blocks](size_t offset, size_t other) {
+      return offset < blocks->at(other).offset_;
+    });
+    (void)placed.insert(pos, index);
+  }
+  return total_size;
+}
 
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
-      }
+size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  CollectMemBlocks(graph);
+  planned_size_ = PlanOffsets(&blocks_) + kMemPlanReserveSize;
+  planned_graph_ = graph;
+  MS_LOG(INFO) << "CPU MemPlan of graph " << graph->graph_id() << ": planned size [" << planned_size_
+               << "], naive size [" << naive_size_ << "], " << blocks_.size() << " blocks";
+  return planned_size_;
+}
+
+void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  if (planned_graph_ != graph) {
+    (void)MemPlan(graph);
+  }
+  for (auto &block : blocks_) {
+    MS_EXCEPTION_IF_NULL(block.address_);
+    if (block.address_->ptr_ == nullptr) {
+      block.address_->ptr_ = base_ptr + block.offset_;
     }
   }
+  planned_graph_ = nullptr;
 }
 }  // namespace cpu
 }  // namespace device
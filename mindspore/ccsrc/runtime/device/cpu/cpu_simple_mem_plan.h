@@ -23,6 +23,16 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
+// A device address that needs memory from the graph buffer and the range of kernels, in execution order, it must
+// stay valid for.
+struct CPUMemBlock {
+  DeviceAddress *address_{nullptr};
+  size_t size_{0};
+  size_t start_{0};
+  size_t end_{0};
+  size_t offset_{0};
+};
+
 class CPUSimpleMemPlan {
  public:
   CPUSimpleMemPlan() = default;
@@ -30,6 +40,20 @@ class CPUSimpleMemPlan {
 
   size_t MemPlan(const session::KernelGraph *graph);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+  // size the graph would take with every block laid out back to back
+  size_t naive_size() const { return naive_size_; }
+
+  // Best fit by lifetime: blocks are placed from the largest down, each into the smallest gap it fits between the
+  // placed blocks with an overlapping lifetime, or above all of them if no gap fits. Returns the total size.
+  static size_t PlanOffsets(std::vector<CPUMemBlock> *blocks);
+
+ private:
+  void CollectMemBlocks(const session::KernelGraph *graph);
+
+  const session::KernelGraph *planned_graph_{nullptr};
+  std::vector<CPUMemBlock> blocks_;
+  size_t naive_size_{0};
+  size_t planned_size_{0};
 };
 }  // namespace cpu
 }  // namespace device
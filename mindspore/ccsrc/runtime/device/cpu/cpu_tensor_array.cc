@@ -18,11 +18,201 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <algorithm>
+#include <mutex>
 #include "runtime/hardware/cpu/cpu_memory_pool.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+namespace {
+constexpr size_t kMinCapacity = 8;
+}  // namespace
+
+CPUTensorArray::CPUTensorArray(const string &name, const TypePtr &dtype, const std::vector<size_t> &shapes)
+    : TensorArray(name, dtype, shapes) {
+  element_size_ = GetTypeByte(dtype);
+  for (auto i : shapes) {
+    element_size_ *= i;
+  }
+}
+
+bool CPUTensorArray::Reserve(size_t size) {
+  if (size <= capacity_) {
+    return true;
+  }
+  // The fixed size TensorArray is allocated once, and the dynamic one doubles to keep writing in amortized O(1).
+  size_t chunk_size = is_dynamic_ ? std::max({size - capacity_, capacity_, kMinCapacity}) : LongToSize(max_size_);
+  size_t chunk_bytes = chunk_size * element_size_;
+  void *chunk = nullptr;
+  if (chunk_bytes > 0) {
+    chunk = CreateMemory(chunk_bytes);
+    if (chunk == nullptr) {
+      MS_LOG(ERROR) << "Allocate " << chunk_bytes << " bytes for " << name_ << " failed.";
+      return false;
+    }
+  }
+  MS_LOG(DEBUG) << "Grow " << name_ << " from " << capacity_ << " to " << (capacity_ + chunk_size) << " elements.";
+  (void)chunks_.emplace_back(chunk, chunk_size);
+  capacity_ += chunk_size;
+  return true;
+}
+
+void *CPUTensorArray::ElementAddr(size_t index) const {
+  for (const auto &chunk : chunks_) {
+    if (index < chunk.second) {
+      return static_cast<uint8_t *>(chunk.first) + index * element_size_;
+    }
+    index -= chunk.second;
+  }
+  MS_LOG(EXCEPTION) << "Index " << index << " out of the capacity " << capacity_ << ", " << name_;
+}
+
+bool CPUTensorArray::Write(const int64_t index, const mindspore::kernel::AddressPtr &dev_value) {
+  MS_EXCEPTION_IF_NULL(dev_value);
+  return WriteValue(index, dev_value->addr, dev_value->size);
+}
+
+// The cases of writing are the same as TensorArray::Write(), and the positions skipped are filled with zeros.
+bool CPUTensorArray::WriteValue(const int64_t index, const void *value, const size_t size) {
+  MS_LOG(DEBUG) << "Write value to " << name_ << ", index " << index;
+  if (index < 0 || (!is_dynamic_ && index >= max_size_)) {
+    MS_LOG(ERROR) << "Invalid index " << index << " for " << name_ << ", the max_size is " << max_size_
+                  << ", is dynamic: " << is_dynamic_;
+    return false;
+  }
+  if (size != element_size_) {
+    MS_LOG(ERROR) << "Invalid value size " << size << " for " << name_ << ", the element size is " << element_size_;
+    return false;
+  }
+  size_t position = LongToSize(index);
+  auto copy_value = [this, position, value, size]() {
+    if (size == 0) {
+      return true;
+    }
+    MS_EXCEPTION_IF_NULL(value);
+    auto ret = memcpy_s(tensors_[position]->addr, element_size_, value, size);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Memcpy failed, errorno(" << ret << ")";
+      return false;
+    }
+    return true;
+  };
+  {
+    // Rewriting the valid elements doesn't change the chunks, so they can be written in parallel.
+    std::shared_lock lock(mutex_);
+    if (position < valid_size_) {
+      return copy_value();
+    }
+  }
+
+  std::unique_lock lock(mutex_);
+  if (!Reserve(position + 1)) {
+    return false;
+  }
+  for (size_t i = tensors_.size(); i <= position; ++i) {
+    auto tensor = std::make_shared<kernel::Address>();
+    tensor->addr = ElementAddr(i);
+    tensor->size = element_size_;
+    tensors_.push_back(tensor);
+  }
+  for (size_t i = valid_size_; i < position && element_size_ > 0; ++i) {
+    ClearMemory(tensors_[i]->addr, element_size_);
+  }
+  valid_size_ = std::max(valid_size_, position + 1);
+  return copy_value();
+}
+
+bool CPUTensorArray::ReadValue(const int64_t index, void *output, const size_t output_size) {
+  MS_EXCEPTION_IF_NULL(output);
+  std::shared_lock lock(mutex_);
+  if (index < 0 || LongToSize(index) >= tensors_.size()) {
+    MS_LOG(ERROR) << "Index " << index << " out of range " << tensors_.size() << ", " << name_;
+    return false;
+  }
+  if (element_size_ == 0) {
+    return true;
+  }
+  auto ret = memcpy_s(output, output_size, tensors_[LongToSize(index)]->addr, element_size_);
+  if (ret != EOK) {
+    MS_LOG(ERROR) << "Memcpy failed, errorno(" << ret << ")";
+    return false;
+  }
+  return true;
+}
+
+bool CPUTensorArray::StackValues(void *output, const size_t output_size) {
+  MS_EXCEPTION_IF_NULL(output);
+  std::shared_lock lock(mutex_);
+  if (valid_size_ > tensors_.size()) {
+    MS_LOG(ERROR) << "Invalid TensorArray size, maybe should Clear() TensorArray before next usage.";
+    return false;
+  }
+  // The valid elements are the head of the chunks.
+  size_t rest_num = valid_size_;
+  size_t offset = 0;
+  for (const auto &chunk : chunks_) {
+    size_t copy_bytes = std::min(rest_num, chunk.second) * element_size_;
+    if (copy_bytes == 0) {
+      break;
+    }
+    if (offset + copy_bytes > output_size) {
+      MS_LOG(ERROR) << "The output size " << output_size << " is less than the valid elements of " << name_;
+      return false;
+    }
+    auto ret = memcpy_s(static_cast<uint8_t *>(output) + offset, output_size - offset, chunk.first, copy_bytes);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Memcpy failed, errorno(" << ret << ")";
+      return false;
+    }
+    offset += copy_bytes;
+    rest_num -= std::min(rest_num, chunk.second);
+  }
+  return true;
+}
+
+mindspore::kernel::AddressPtr CPUTensorArray::Read(const int64_t index) {
+  std::shared_lock lock(mutex_);
+  return TensorArray::Read(index);
+}
+
+const void *CPUTensorArray::GetTensorAddr(const size_t &index) const {
+  std::shared_lock lock(mutex_);
+  if (index >= tensors_.size()) {
+    MS_LOG(EXCEPTION) << "Index " << index << " out of range " << tensors_.size() << ", " << name_;
+  }
+  return tensors_[index]->addr;
+}
+
+void CPUTensorArray::Clear() {
+  std::unique_lock lock(mutex_);
+  TensorArray::Clear();
+}
+
+size_t CPUTensorArray::GetValidSize() const {
+  std::shared_lock lock(mutex_);
+  return valid_size_;
+}
+
+size_t CPUTensorArray::GetRealSize() const {
+  std::shared_lock lock(mutex_);
+  return tensors_.size();
+}
+
+void CPUTensorArray::Free() {
+  MS_LOG(DEBUG) << "Free device memory for " << name_;
+  std::unique_lock lock(mutex_);
+  for (const auto &chunk : chunks_) {
+    if (chunk.first != nullptr) {
+      ReleaseMemory(chunk.first);
+    }
+  }
+  chunks_.clear();
+  capacity_ = 0;
+  valid_size_ = 0;
+  tensors_.clear();
+}
+
 void *CPUTensorArray::CreateMemory(const size_t size) { return CPUMemoryPool::GetInstance().AllocTensorMem(size); }
 
 void CPUTensorArray::ClearMemory(void *addr, const size_t size) { (void)memset_s(addr, size, 0, size); }
@@ -20,19 +20,54 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <utility>
+#include <shared_mutex>
 #include "runtime/device/tensor_array.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+// The elements are kept one after another in chunks, each of which is as large as all the former ones, so writing an
+// element allocates memory only in amortized O(1) and the valid elements are stacked by one copy per chunk. The chunks
+// never move, so the element addresses handed out by Read() and GetTensorAddr() are valid until Free(). The elements
+// can be read and rewritten by parallel actors, while appending an element or adding a chunk is exclusive.
 class CPUTensorArray : public TensorArray {
  public:
-  CPUTensorArray(const string &name, const TypePtr &dtype, const std::vector<size_t> &shapes)
-      : TensorArray(name, dtype, shapes) {}
+  CPUTensorArray(const string &name, const TypePtr &dtype, const std::vector<size_t> &shapes);
   ~CPUTensorArray() override = default;
+
+  // Copy the value of dev_value to the position of index.
+  bool Write(const int64_t index, const mindspore::kernel::AddressPtr &dev_value) override;
+  // Copy the value to the position of index, the value should be in the size of an element.
+  bool WriteValue(const int64_t index, const void *value, const size_t size);
+  // Copy the element in the position of index to the output.
+  bool ReadValue(const int64_t index, void *output, const size_t output_size);
+  // Copy all the valid elements to the output.
+  bool StackValues(void *output, const size_t output_size);
+  mindspore::kernel::AddressPtr Read(const int64_t index) override;
+  const void *GetTensorAddr(const size_t &index) const override;
+  void Clear() override;
+  void Free() override;
+
+  size_t GetValidSize() const override;
+  size_t GetRealSize() const override;
+  size_t element_size() const { return element_size_; }
+
   void ReleaseMemory(void *addr) override;
   void *CreateMemory(const size_t size) override;
   void ClearMemory(void *addr, const size_t size) override;
+
+ private:
+  // Make the chunks hold at least size elements, the elements written are kept in place.
+  bool Reserve(size_t size);
+  // Return the address of the element in the position of index, which should be less than the capacity.
+  void *ElementAddr(size_t index) const;
+
+  size_t element_size_;
+  // The address and the element number of the chunks.
+  std::vector<std::pair<void *, size_t>> chunks_;
+  size_t capacity_{0};
+  mutable std::shared_mutex mutex_;
 };
 using CPUTensorArray = CPUTensorArray;
 using CPUTensorArrayPtr = std::shared_ptr<CPUTensorArray>;
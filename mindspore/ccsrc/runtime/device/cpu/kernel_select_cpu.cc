@@ -18,9 +18,11 @@
 #include <string>
 #include <memory>
 #include <algorithm>
+#include <sstream>
 #include "backend/kernel_compiler/common_utils.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 #include "backend/kernel_compiler/kernel_build_info.h"
+#include "backend/kernel_compiler/kernel_select_cache.h"
 #include "backend/kernel_compiler/oplib/opinfo.h"
 #include "backend/kernel_compiler/oplib/oplib.h"
 #include "backend/kernel_compiler/cpu/pyfunc/py_func_cpu_kernel.h"
@@ -184,6 +186,27 @@ void SetKernelBuildInfo(const std::vector<std::string> &input_formats, const std
   AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), kernel_node);
 }
 
+// The selection only depends on the operator, the data types of the inputs and outputs, and which inputs are not
+// cnodes, except for the Custom operators which register the kernel attrs in the selection.
+std::string GetKernelSelectCacheKey(const std::string &op_name, const std::vector<TypeId> &input_types,
+                                    const std::vector<size_t> &input_not_cnode_indexes,
+                                    const std::vector<TypeId> &output_types) {
+  std::ostringstream key;
+  key << kCPUDevice << "_" << op_name << "_in";
+  for (auto type : input_types) {
+    key << "_" << static_cast<int>(type);
+  }
+  key << "_not_cnode";
+  for (auto index : input_not_cnode_indexes) {
+    key << "_" << index;
+  }
+  key << "_out";
+  for (auto type : output_types) {
+    key << "_" << static_cast<int>(type);
+  }
+  return key.str();
+}
+
 void KernelNotSupportException(const AnfNodePtr &kernel_node, const std::vector<TypeId> &input_types,
                                const std::vector<TypeId> &infer_output_types) {
   std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
@@ -451,6 +474,18 @@ void SetKernelInfo(const CNodePtr &kernel_node) {
   }
   GetInputDtypes(kernel_node, &input_types, &input_not_cnode_indexes);
   GetOutputDtypes(kernel_node, &output_types);
+  bool use_cache = !IsPrimitiveCNode(kernel_node, prim::kPrimCustom);
+  std::string cache_key;
+  kernel::KernelSelectInfo cache_info;
+  if (use_cache) {
+    cache_key = GetKernelSelectCacheKey(op_name, input_types, input_not_cnode_indexes, output_types);
+    if (kernel::KernelSelectCache::GetInstance().Find(cache_key, &cache_info)) {
+      MS_LOG(DEBUG) << "Use the cached kernel selection for " << cache_key;
+      SetKernelBuildInfo(cache_info.input_formats, cache_info.input_types, cache_info.output_formats,
+                         cache_info.output_types, kernel_node.get());
+      return;
+    }
+  }
   KernelAttr selected_kernel_attr;
   std::pair<bool, bool> matched = std::make_pair(false, false);
   if (!SelectKernel(kernel_node, &selected_kernel_attr, kernel_attrs, input_types, input_not_cnode_indexes,
@@ -475,6 +510,10 @@ void SetKernelInfo(const CNodePtr &kernel_node) {
     }
   }
   SetKernelBuildInfo(input_formats, input_types, selected_output_formats, selected_output_types, kernel_node.get());
+  if (use_cache) {
+    cache_info = {input_formats, input_types, selected_output_formats, selected_output_types};
+    kernel::KernelSelectCache::GetInstance().Insert(cache_key, cache_info);
+  }
 }
 }  // namespace cpu
 }  // namespace device
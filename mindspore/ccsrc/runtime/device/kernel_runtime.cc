@@ -15,6 +15,10 @@
  */
 
 #include "runtime/device/kernel_runtime.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -63,6 +67,29 @@ std::vector<AnfNodePtr> GetGraphInputs(const session::KernelGraph &graph) {
   }
   return result;
 }
+
+// The limit of the swapped out memory kept in host in bytes, set by MS_DEV_MEM_OFFLOAD_HOST_LIMIT in MB. Return SIZE_MAX
+// for no limit when the env is not set or not a valid number.
+size_t GetOffloadHostMemLimit() {
+  static const auto host_mem_limit = common::GetEnv("MS_DEV_MEM_OFFLOAD_HOST_LIMIT");
+  if (host_mem_limit.empty()) {
+    return SIZE_MAX;
+  }
+  constexpr size_t kMBToByteShift = 20;
+  if (!std::all_of(host_mem_limit.begin(), host_mem_limit.end(), [](char c) { return std::isdigit(c) != 0; })) {
+    MS_LOG(WARNING) << "The env MS_DEV_MEM_OFFLOAD_HOST_LIMIT " << host_mem_limit
+                    << " is not a number of MB, the host memory is not limited.";
+    return SIZE_MAX;
+  }
+  errno = 0;
+  auto limit = std::strtoull(host_mem_limit.c_str(), nullptr, 10);
+  if (errno == ERANGE || limit > (SIZE_MAX >> kMBToByteShift)) {
+    MS_LOG(WARNING) << "The env MS_DEV_MEM_OFFLOAD_HOST_LIMIT " << host_mem_limit
+                    << " is out of range, the host memory is not limited.";
+    return SIZE_MAX;
+  }
+  return static_cast<size_t>(limit) << kMBToByteShift;
+}
 }  // namespace
 constexpr size_t kMinInputSize = 2;
 KernelRuntime::~KernelRuntime() {
@@ -1682,6 +1709,18 @@ void KernelRuntime::UseMemSchedulerIfNeeded(const session::KernelGraph &graph) {
   if (mem_scheduler->need_record_event()) {
     (void)LaunchKernelMod(graph, true);
     mem_scheduler->set_need_record_event(false);
+    // Spill the swapped out memory beyond the host limit in MB to a file in the directory.
+    static const auto disk_swap_path = common::GetEnv("MS_DEV_MEM_OFFLOAD_DISK_PATH");
+    auto host_mem_limit_size = GetOffloadHostMemLimit();
+    if (!disk_swap_path.empty() && host_mem_limit_size == SIZE_MAX) {
+      MS_LOG(INFO) << "The host memory of the offload is not limited, nothing is spilled to " << disk_swap_path;
+    } else if (!disk_swap_path.empty()) {
+      auto file_path = disk_swap_path + "/mem_swap_" + std::to_string(device_id_) + "_" +
+                       std::to_string(graph.graph_id()) + ".bin";
+      if (!mem_scheduler->SetDiskSwap(file_path, host_mem_limit_size)) {
+        MS_LOG(WARNING) << "Can't spill the offloaded memory of graph " << graph.graph_id() << " to " << file_path;
+      }
+    }
   }
   auto ret = mem_scheduler->Optimize();
   if (!ret) {
@@ -0,0 +1,237 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/device/memory_disk_swap.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+// The file space is allocated by page, so the space of a key is reusable by the keys of similar size.
+constexpr size_t kFileSpaceAlignSize = 4096;
+
+size_t AlignFileSpace(size_t size) {
+  return (size + kFileSpaceAlignSize - 1) / kFileSpaceAlignSize * kFileSpaceAlignSize;
+}
+}  // namespace
+
+MemDiskSwap::~MemDiskSwap() {
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    stop_ = true;
+  }
+  request_cv_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+#ifdef _WIN32
+  // The opened file can't be removed on windows, so it is removed after being closed.
+  if (file_ != nullptr) {
+    (void)std::fclose(file_);
+    (void)std::remove(file_path_.c_str());
+  }
+#else
+  if (fd_ >= 0) {
+    (void)close(fd_);
+  }
+#endif
+}
+
+bool MemDiskSwap::Init() {
+#ifdef _WIN32
+  file_ = std::fopen(file_path_.c_str(), "wb+");
+  if (file_ == nullptr) {
+    MS_LOG(WARNING) << "Open memory swap file " << file_path_ << " failed, errno " << errno;
+    return false;
+  }
+#else
+  fd_ = open(file_path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+  if (fd_ < 0) {
+    MS_LOG(WARNING) << "Open memory swap file " << file_path_ << " failed, errno " << errno;
+    return false;
+  }
+  // The file is only reachable by the fd, it is removed by the system when the process exits in any way.
+  (void)unlink(file_path_.c_str());
+#endif
+  worker_ = std::thread(&MemDiskSwap::Run, this);
+  MS_LOG(INFO) << "Memory swap file: " << file_path_;
+  return true;
+}
+
+void MemDiskSwap::Push(const IORequest &request) {
+  requests_.push(request);
+  ++pending_num_[request.key];
+}
+
+size_t MemDiskSwap::GetFileSpace(const void *key, size_t mem_size) {
+  auto space_size = AlignFileSpace(mem_size);
+  auto iter = file_space_.find(key);
+  if (iter != file_space_.end()) {
+    if (iter->second.second >= space_size) {
+      return iter->second.first;
+    }
+    (void)idle_file_space_.emplace(iter->second.second, iter->second.first);
+    (void)file_space_.erase(iter);
+  }
+  size_t offset = file_size_;
+  auto idle_iter = idle_file_space_.lower_bound(space_size);
+  if (idle_iter != idle_file_space_.end()) {
+    offset = idle_iter->second;
+    space_size = idle_iter->first;
+    (void)idle_file_space_.erase(idle_iter);
+  } else {
+    file_size_ += space_size;
+  }
+  file_space_[key] = std::make_pair(offset, space_size);
+  return offset;
+}
+
+void MemDiskSwap::AsyncWrite(const void *key, const void *host_ptr, size_t mem_size) {
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    auto offset = GetFileSpace(key, mem_size);
+    Push({key, const_cast<void *>(host_ptr), mem_size, offset, true});
+  }
+  request_cv_.notify_one();
+}
+
+void MemDiskSwap::AsyncRead(const void *key, void *host_ptr, size_t mem_size) {
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    auto iter = file_space_.find(key);
+    if (iter != file_space_.end() && iter->second.second >= mem_size) {
+      Push({key, host_ptr, mem_size, iter->second.first, false});
+      found = true;
+    }
+  }
+  // Report the error out of the lock, so no log or exception handling runs while the swap thread is blocked.
+  if (!found) {
+    MS_LOG(EXCEPTION) << "The memory of key " << key << " with size " << mem_size << " is not in the swap file.";
+  }
+  request_cv_.notify_one();
+}
+
+bool MemDiskSwap::IsDone(const void *key) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  return pending_num_.find(key) == pending_num_.end();
+}
+
+bool MemDiskSwap::Wait(const void *key) {
+  std::unique_lock<std::mutex> locker(mutex_);
+  done_cv_.wait(locker, [this, key]() { return pending_num_.find(key) == pending_num_.end(); });
+  return failed_keys_.find(key) == failed_keys_.end();
+}
+
+void MemDiskSwap::Release(const void *key) {
+  std::unique_lock<std::mutex> locker(mutex_);
+  done_cv_.wait(locker, [this, key]() { return pending_num_.find(key) == pending_num_.end(); });
+  auto iter = file_space_.find(key);
+  if (iter != file_space_.end()) {
+    (void)idle_file_space_.emplace(iter->second.second, iter->second.first);
+    (void)file_space_.erase(iter);
+  }
+  (void)failed_keys_.erase(key);
+}
+
+void MemDiskSwap::Clear() {
+  std::unique_lock<std::mutex> locker(mutex_);
+  done_cv_.wait(locker, [this]() { return pending_num_.empty(); });
+  file_space_.clear();
+  idle_file_space_.clear();
+  failed_keys_.clear();
+  file_size_ = 0;
+}
+
+bool MemDiskSwap::DoIO(const IORequest &request) const {
+#ifdef _WIN32
+  // There is no pread and pwrite on windows. The IO runs in one thread, so the file is sought before each IO.
+  if (_fseeki64(file_, static_cast<int64_t>(request.offset), SEEK_SET) != 0) {
+    MS_LOG(ERROR) << "Seek memory swap file " << file_path_ << " failed, offset " << request.offset << ", errno "
+                  << errno;
+    return false;
+  }
+  auto done_size = request.is_write ? std::fwrite(request.host_ptr, 1, request.mem_size, file_)
+                                    : std::fread(request.host_ptr, 1, request.mem_size, file_);
+  if (done_size != request.mem_size) {
+    MS_LOG(ERROR) << (request.is_write ? "Write" : "Read") << " memory swap file " << file_path_ << " failed, size "
+                  << request.mem_size << ", offset " << request.offset << ", errno " << errno;
+    return false;
+  }
+  return true;
+#else
+  auto ptr = static_cast<uint8_t *>(request.host_ptr);
+  size_t done_size = 0;
+  while (done_size < request.mem_size) {
+    auto offset = static_cast<off_t>(request.offset + done_size);
+    auto ret = request.is_write ? pwrite(fd_, ptr + done_size, request.mem_size - done_size, offset)
+                                : pread(fd_, ptr + done_size, request.mem_size - done_size, offset);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      MS_LOG(ERROR) << (request.is_write ? "Write" : "Read") << " memory swap file " << file_path_ << " failed, size "
+                    << request.mem_size << ", offset " << request.offset << ", errno " << errno;
+      return false;
+    }
+    done_size += static_cast<size_t>(ret);
+  }
+#ifdef __linux__
+  // Keep the page cache from growing by the swapped memory, which is what the disk swap tries to save.
+  auto offset = static_cast<off64_t>(request.offset);
+  auto size = static_cast<off64_t>(request.mem_size);
+  if (request.is_write) {
+    (void)sync_file_range(fd_, offset, size, SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE |
+                                                SYNC_FILE_RANGE_WAIT_AFTER);
+  }
+  (void)posix_fadvise(fd_, offset, size, POSIX_FADV_DONTNEED);
+#endif
+  return true;
+#endif
+}
+
+void MemDiskSwap::Run() {
+  while (true) {
+    IORequest request;
+    {
+      std::unique_lock<std::mutex> locker(mutex_);
+      request_cv_.wait(locker, [this]() { return stop_ || !requests_.empty(); });
+      if (requests_.empty()) {
+        return;
+      }
+      request = requests_.front();
+      requests_.pop();
+    }
+    bool ret = DoIO(request);
+    {
+      std::lock_guard<std::mutex> locker(mutex_);
+      if (!ret) {
+        (void)failed_keys_.insert(request.key);
+      }
+      auto iter = pending_num_.find(request.key);
+      if (iter != pending_num_.end() && --iter->second == 0) {
+        (void)pending_num_.erase(iter);
+      }
+    }
+    done_cv_.notify_all();
+  }
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_MEMORY_DISK_SWAP_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_MEMORY_DISK_SWAP_H_
+#include <cstdio>
+#include <map>
+#include <set>
+#include <queue>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <utility>
+
+namespace mindspore {
+namespace device {
+// The host side of memory offload spilled to a local file. The file IO runs in order in one background thread, so a
+// read of a key always sees its earlier write.
+class MemDiskSwap {
+ public:
+  explicit MemDiskSwap(const std::string &file_path) : file_path_(file_path) {}
+  ~MemDiskSwap();
+
+  bool Init();
+
+  // The host memory must stay valid until the IO of the key is done.
+  void AsyncWrite(const void *key, const void *host_ptr, size_t mem_size);
+  void AsyncRead(const void *key, void *host_ptr, size_t mem_size);
+  bool IsDone(const void *key);
+  // Wait all the IO of the key, return false if any of them failed since the key was released.
+  bool Wait(const void *key);
+  // Wait the IO of the key and give back its file space.
+  void Release(const void *key);
+  // Wait all the IO and give back all the file space.
+  void Clear();
+
+  size_t file_size() const { return file_size_; }
+
+ private:
+  struct IORequest {
+    const void *key;
+    void *host_ptr;
+    size_t mem_size;
+    size_t offset;
+    bool is_write;
+  };
+
+  void Push(const IORequest &request);
+  // Find the file space of the key for writing mem_size bytes, the lock must be held.
+  size_t GetFileSpace(const void *key, size_t mem_size);
+  bool DoIO(const IORequest &request) const;
+  void Run();
+
+  std::string file_path_;
+#ifdef _WIN32
+  std::FILE *file_{nullptr};
+#else
+  int fd_{-1};
+#endif
+  std::thread worker_;
+  std::mutex mutex_;
+  std::condition_variable request_cv_;
+  std::condition_variable done_cv_;
+  std::queue<IORequest> requests_;
+  // The number of IO requests in the queue or running by key.
+  std::map<const void *, size_t> pending_num_;
+  std::set<const void *> failed_keys_;
+  // The offset and size of the file space by key.
+  std::map<const void *, std::pair<size_t, size_t>> file_space_;
+  // The idle file space, size to offset.
+  std::multimap<size_t, size_t> idle_file_space_;
+  size_t file_size_{0};
+  bool stop_{false};
+};
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_MEMORY_DISK_SWAP_H_
@@ -56,6 +56,12 @@ class MemoryManager : public MemHandler {
   virtual uint8_t *MallocCommunicationMemFromMemPool(size_t size) { return nullptr; }
   virtual void FreeMemFromMemPool(const DeviceAddressPtr address);
   virtual void FreeMemFromMemPool(void *device_ptr);
+  // Free a batch of memory, the memory pool may take the lock once for the whole batch.
+  virtual void FreeMemsFromMemPool(const std::vector<void *> &device_ptrs) {
+    for (auto device_ptr : device_ptrs) {
+      FreeMemFromMemPool(device_ptr);
+    }
+  }
   virtual bool MallocContinuousMemFromMemPool(const DeviceAddressPtrList &addr_list, size_t total_size,
                                               std::vector<size_t> size_list);
   virtual std::vector<void *> MallocContinuousMemFromMemPool(size_t total_size, std::vector<size_t> size_list);
@@ -56,6 +56,7 @@ void MemScheduler::ClearAllocatedMem() {
   if (mem_handler_ == nullptr) {
     return;
   }
+  ClearDiskSwap();
   for (auto &item : mem_result_) {
     const auto device_ptr = item.second;
     if (device_ptr != nullptr) {
@@ -70,6 +71,157 @@ void MemScheduler::ClearAllocatedMem() {
     }
   }
   swap_host_ptr_.clear();
+  swap_host_mem_sizes_.clear();
+  swap_host_mem_size_ = 0;
+}
+
+bool MemScheduler::SetDiskSwap(const std::string &file_path, size_t host_mem_limit) {
+  auto disk_swap = std::make_shared<MemDiskSwap>(file_path);
+  if (!disk_swap->Init()) {
+    return false;
+  }
+  disk_swap_ = disk_swap;
+  host_mem_limit_ = host_mem_limit;
+  MS_LOG(INFO) << "Spill the swapped out memory beyond " << host_mem_limit << " bytes in host to " << file_path;
+  return true;
+}
+
+void MemScheduler::ClearDiskSwap() {
+  if (disk_swap_ == nullptr) {
+    return;
+  }
+  disk_swap_->Clear();
+  for (const auto &item : spilling_host_ptr_) {
+    mem_handler_->FreeHost(item.second);
+  }
+  spilling_host_ptr_.clear();
+  disk_keys_.clear();
+  prefetching_keys_.clear();
+}
+
+void MemScheduler::GenSwapInSteps() {
+  swap_in_steps_.clear();
+  if (strategy_ == nullptr) {
+    return;
+  }
+  for (size_t step = 0; step < total_step_; ++step) {
+    for (const auto &event : strategy_->GetPreComputeEvents(step)) {
+      MS_EXCEPTION_IF_NULL(event);
+      if (event->type == kSwapIn) {
+        swap_in_steps_[event->key].emplace_back(step);
+      }
+    }
+  }
+}
+
+size_t MemScheduler::NextSwapInDistance(const void *key) const {
+  const auto &iter = swap_in_steps_.find(key);
+  if (iter == swap_in_steps_.end() || iter->second.empty()) {
+    return SIZE_MAX;
+  }
+  const auto &steps = iter->second;
+  auto step_iter = std::lower_bound(steps.begin(), steps.end(), current_step_);
+  if (step_iter != steps.end()) {
+    return *step_iter - current_step_;
+  }
+  return steps.front() + total_step_ - current_step_;
+}
+
+bool MemScheduler::CheckDiskSwap() {
+  for (auto iter = spilling_host_ptr_.begin(); iter != spilling_host_ptr_.end();) {
+    if (!disk_swap_->IsDone(iter->first)) {
+      ++iter;
+      continue;
+    }
+    if (!disk_swap_->Wait(iter->first)) {
+      return false;
+    }
+    mem_handler_->FreeHost(iter->second);
+    iter = spilling_host_ptr_.erase(iter);
+  }
+  for (auto iter = prefetching_keys_.begin(); iter != prefetching_keys_.end();) {
+    if (!disk_swap_->IsDone(*iter)) {
+      ++iter;
+      continue;
+    }
+    if (!disk_swap_->Wait(*iter)) {
+      return false;
+    }
+    iter = prefetching_keys_.erase(iter);
+  }
+  return true;
+}
+
+void MemScheduler::SpillHostMem() {
+  // Spill the memory swapped in last, which is the one whose host memory is useless for the longest time.
+  while (swap_host_mem_size_ > host_mem_limit_) {
+    const void *victim = nullptr;
+    size_t victim_distance = 0;
+    for (const auto &item : swap_host_ptr_) {
+      if (prefetching_keys_.find(item.first) != prefetching_keys_.end()) {
+        continue;
+      }
+      auto distance = NextSwapInDistance(item.first);
+      if (victim == nullptr || distance > victim_distance) {
+        victim = item.first;
+        victim_distance = distance;
+      }
+    }
+    if (victim == nullptr) {
+      return;
+    }
+    auto host_ptr = swap_host_ptr_[victim];
+    auto mem_size = swap_host_mem_sizes_[victim];
+    MS_LOG(DEBUG) << "Spill " << victim << " of size " << mem_size << " to disk at step " << current_step_;
+    disk_swap_->AsyncWrite(victim, host_ptr, mem_size);
+    spilling_host_ptr_[victim] = host_ptr;
+    (void)swap_host_ptr_.erase(victim);
+    (void)disk_keys_.insert(victim);
+    swap_host_mem_size_ -= mem_size;
+  }
+}
+
+void MemScheduler::PrefetchFromDisk() {
+  std::vector<std::pair<size_t, const void *>> candidates;
+  for (const auto &key : disk_keys_) {
+    (void)candidates.emplace_back(NextSwapInDistance(key), key);
+  }
+  std::sort(candidates.begin(), candidates.end());
+  for (const auto &candidate : candidates) {
+    if (candidate.first == SIZE_MAX || swap_host_mem_size_ + swap_host_mem_sizes_[candidate.second] > host_mem_limit_) {
+      return;
+    }
+    StartLoadFromDisk(candidate.second);
+  }
+}
+
+void MemScheduler::StartLoadFromDisk(const void *key) {
+  auto mem_size = swap_host_mem_sizes_[key];
+  void *host_ptr = nullptr;
+  const auto &iter = spilling_host_ptr_.find(key);
+  if (iter != spilling_host_ptr_.end()) {
+    // The write is not done yet, keep the host memory instead of reading it back.
+    host_ptr = iter->second;
+    (void)spilling_host_ptr_.erase(iter);
+  } else {
+    host_ptr = mem_handler_->MallocHost(mem_size);
+    MS_EXCEPTION_IF_NULL(host_ptr);
+    disk_swap_->AsyncRead(key, host_ptr, mem_size);
+  }
+  swap_host_ptr_[key] = host_ptr;
+  swap_host_mem_size_ += mem_size;
+  (void)disk_keys_.erase(key);
+  (void)prefetching_keys_.insert(key);
+}
+
+bool MemScheduler::LoadFromDisk(const void *key) {
+  if (disk_keys_.find(key) != disk_keys_.end()) {
+    StartLoadFromDisk(key);
+  }
+  if (prefetching_keys_.erase(key) > 0) {
+    return disk_swap_->Wait(key);
+  }
+  return true;
 }
 
 void MemScheduler::Record(const void *key, const MemEventType &event_type, size_t mem_size) {
@@ -120,6 +272,12 @@ bool MemScheduler::PreCompute(void *stream) {
     return true;
   }
   MS_EXCEPTION_IF_NULL(mem_handler_);
+  if (disk_swap_ != nullptr) {
+    if (!CheckDiskSwap()) {
+      return false;
+    }
+    PrefetchFromDisk();
+  }
   auto &events = strategy_->GetPreComputeEvents(current_step_);
   for (auto &event : events) {
     MS_EXCEPTION_IF_NULL(event);
@@ -149,6 +307,9 @@ bool MemScheduler::PreCompute(void *stream) {
       }
       mem_result_[event->key] = device_ptr;
     } else if (event->type == kSwapIn) {
+      if (disk_swap_ != nullptr && !LoadFromDisk(event->key)) {
+        return false;
+      }
       bool from_init = true;
       auto host_ptr = init_host_ptr_[event->key];
       if (host_ptr == nullptr) {
@@ -165,6 +326,11 @@ bool MemScheduler::PreCompute(void *stream) {
       if (!from_init) {
         mem_handler_->FreeHost(host_ptr);
         (void)swap_host_ptr_.erase(event->key);
+        swap_host_mem_size_ -= swap_host_mem_sizes_[event->key];
+        (void)swap_host_mem_sizes_.erase(event->key);
+        if (disk_swap_ != nullptr) {
+          disk_swap_->Release(event->key);
+        }
       }
     }
   }
@@ -205,6 +371,8 @@ bool MemScheduler::PostCompute(void *stream) {
       if (host_ptr == nullptr) {
         host_ptr = mem_handler_->MallocHost(event->mem_size);
         swap_host_ptr_[event->key] = host_ptr;
+        swap_host_mem_sizes_[event->key] = event->mem_size;
+        swap_host_mem_size_ += event->mem_size;
       }
       MS_EXCEPTION_IF_NULL(host_ptr);
       mem_handler_->SwapOut(device_ptr, host_ptr, event->mem_size, stream);
@@ -212,6 +380,9 @@ bool MemScheduler::PostCompute(void *stream) {
       (void)mem_result_.erase(event->key);
     }
   }
+  if (disk_swap_ != nullptr) {
+    SpillHostMem();
+  }
   ++current_step_;
   return true;
 }
@@ -234,6 +405,7 @@ void MemScheduler::OptMemUsage(float mem_used_factor) {
   available_mem_size = available_mem_size * mem_used_factor_;
   strategy_->set_mem_size(available_mem_size);
   strategy_->Execute();
+  GenSwapInSteps();
 }
 
 bool MemScheduler::Optimize() {
@@ -321,6 +493,7 @@ void MemScheduler::Update() {
 
   strategy_->SetComputeTime(compute_time_);
   strategy_->Execute();
+  GenSwapInSteps();
   updated_ = true;
 }
 }  // namespace device
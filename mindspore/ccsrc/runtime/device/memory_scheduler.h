@@ -21,8 +21,10 @@
 #include <map>
 #include <set>
 #include <memory>
+#include <string>
 #include <utility>
 #include "runtime/device/memory_offload_strategy.h"
+#include "runtime/device/memory_disk_swap.h"
 
 namespace mindspore {
 namespace device {
@@ -34,6 +36,7 @@ class MemHandler {
   virtual void *MallocHost(size_t mem_size) = 0;
   virtual void FreeHost(void *ptr) = 0;
   virtual void SwapIn(const void *host_ptr, void *device_ptr, size_t mem_size, void *stream) = 0;
+  // The host memory may be written to disk right after SwapOut returns, so the copy must be finished by then.
   virtual void SwapOut(const void *device_ptr, void *host_ptr, size_t mem_size, void *stream) = 0;
 };
 
@@ -89,6 +92,10 @@ class MemScheduler {
 
   void ClearMemInitFunc() { high_priority_mem_init_func_.clear(); }
 
+  // Keep at most host_mem_limit bytes of swapped out memory in host, spill the rest to the file and read it back ahead
+  // of its swap in step.
+  bool SetDiskSwap(const std::string &file_path, size_t host_mem_limit);
+
  private:
   void Record(const void *key, const MemEventType &event_type, size_t mem_size = 0);
 
@@ -98,6 +105,24 @@ class MemScheduler {
 
   void AdjustFirstEventIndex();
 
+  void GenSwapInSteps();
+
+  // The number of steps until the next swap in of the key, wrapping around to the next run of the graph.
+  size_t NextSwapInDistance(const void *key) const;
+
+  // Free the host memory written to the file and finish the reads, return false if any IO failed.
+  bool CheckDiskSwap();
+
+  void SpillHostMem();
+
+  void PrefetchFromDisk();
+
+  void StartLoadFromDisk(const void *key);
+
+  bool LoadFromDisk(const void *key);
+
+  void ClearDiskSwap();
+
   std::map<const void *, MemPriority> mem_priority_;
   std::map<const void *, std::vector<std::shared_ptr<MemEvent>>> mem_events_;
   std::set<const void *> manual_offload_keys_;
@@ -118,6 +143,18 @@ class MemScheduler {
   bool updated_{false};
   std::shared_ptr<MemHandler> mem_handler_{nullptr};
   std::shared_ptr<MemOffloadStrategy> strategy_{nullptr};
+  // The size of swap_host_ptr_ memory.
+  size_t swap_host_mem_size_{0};
+  std::map<const void *, size_t> swap_host_mem_sizes_;
+  std::shared_ptr<MemDiskSwap> disk_swap_{nullptr};
+  size_t host_mem_limit_{0};
+  // The memory being written to the file, whose host memory is freed when the write is done.
+  std::map<const void *, void *> spilling_host_ptr_;
+  // The memory only in the file.
+  std::set<const void *> disk_keys_;
+  // The memory being read from the file into swap_host_ptr_.
+  std::set<const void *> prefetching_keys_;
+  std::map<const void *, std::vector<size_t>> swap_in_steps_;
 };
 
 class MemSchedulerManager {
@@ -148,6 +148,7 @@ void DebugActor::DebugOnStepEnd(OpContext<DeviceTensor> *const op_context, const
   if (DumpJsonParser::GetInstance().GetIterDumpFlag()) {
     CPUE2eDump::DumpParametersData();
     CPUE2eDump::DumpConstantsData();
+    CPUE2eDump::FlushDumpData();
   }
 #endif
 
@@ -169,6 +169,10 @@ void FreeMemory(const std::vector<DeviceTensor *> &free_list, const DeviceContex
 void KernelActor::SendMemoryAllocReq(OpContext<DeviceTensor> *const context) {
   running_dependent_msg_num_ = 1;
   if (strategy_ == GraphExecutionStrategy::kPipeline) {
+    if (inline_memory_alloc_ && MemoryManagerActor::TryAllocateMemory(memory_alloc_list_, device_contexts_[0])) {
+      OnMemoryAllocFinish(context);
+      return;
+    }
     ActorDispatcher::Send(memory_manager_aid_, &MemoryManagerActor::AllocateMemory, &memory_alloc_list_,
                           device_contexts_[0], context, GetAID());
   } else {
@@ -41,6 +41,8 @@ using mindspore::tensor::TensorPtr;
 // The kernel actor is used to receive the device tensors and control info to luanch kernel.
 // The processing flow is RunOpData/RunOpControl -> CheckRunningCondition -> SendMemoryAllocReq
 // -> OnMemoryAllocFinish -> LaunchKernel -> SendMemoryFreeReq -> SendOutput.
+// In the inline memory alloc mode, SendMemoryAllocReq allocates the memory in the actor thread and calls
+// OnMemoryAllocFinish directly, only the failed allocation goes to the MemoryManagerActor.
 class KernelActor : public DebugAwareActor {
  public:
   KernelActor(const std::string &name, const CNodePtr &kernel, const DeviceContext *device_context,
@@ -112,6 +114,9 @@ class KernelActor : public DebugAwareActor {
   // In step mode, kernel actor executes synchronously.
   GraphExecutionStrategy strategy_{GraphExecutionStrategy::kPipeline};
 
+  // Allocate memory without the message round trip to the MemoryManagerActor, set by the graph scheduler.
+  bool inline_memory_alloc_{false};
+
   // The device tensors for launch.
   std::vector<DeviceTensor *> input_device_tensors_;
   std::vector<DeviceTensor *> output_device_tensors_;
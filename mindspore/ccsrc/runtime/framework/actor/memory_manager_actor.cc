@@ -15,6 +15,8 @@
  */
 
 #include "runtime/framework/actor/memory_manager_actor.h"
+#include <map>
+#include <vector>
 #include "runtime/framework/actor/data_source_actor.h"
 #include "runtime/framework/actor/kernel_actor.h"
 #include "runtime/hardware/device_context_manager.h"
@@ -24,39 +26,43 @@
 namespace mindspore {
 namespace runtime {
 namespace {
-void FreeMemoryInner(DeviceTensor *const device_tensor, const DeviceContext *device_context) {
+// The device context may be not accurate in the control flow scene, so need fetch by device name and device id.
+const DeviceContext *FetchFreeDeviceContext(const DeviceTensor *device_tensor, const DeviceContext *device_context) {
   MS_EXCEPTION_IF_NULL(device_tensor);
-  // The device context may be not accurate in the control flow scene, so need fetch by device name and device id.
   if ((device_context == nullptr) || (device_context->GetDeviceAddressType() != device_tensor->DeviceType())) {
     const auto &new_device_context = device::DeviceContextManager::GetInstance().GetOrCreateDeviceContext(
       {device_tensor->device_name(), device_tensor->device_id()});
     MS_EXCEPTION_IF_NULL(new_device_context);
-    new_device_context->FreeMemory(device_tensor);
-  } else {
-    device_context->FreeMemory(device_tensor);
+    return new_device_context;
   }
+  return device_context;
 }
 
-// Only one of the static and dynamic reference counts will take effect.
-void FreeMemoryByRefCount(DeviceTensor *const device_tensor, const DeviceContext *device_context, const AID &from_aid) {
+// Only one of the static and dynamic reference counts will take effect. Return whether the memory needs to be freed.
+bool DecreaseRefCountToFree(DeviceTensor *const device_tensor, const AID &from_aid) {
   MS_EXCEPTION_IF_NULL(device_tensor);
   if (device_tensor->original_ref_count() != SIZE_MAX) {
     // The static reference count is decremented to zero to free memory, and reset to the original count.
     device_tensor->DecreaseRefCount();
     if (device_tensor->ref_count() == 0) {
-      if (device_tensor->GetPtr() != nullptr) {
-        FreeMemoryInner(device_tensor, device_context);
-      }
       device_tensor->ResetRefCount();
+      return device_tensor->GetPtr() != nullptr;
     }
   } else if (device_tensor->dynamic_ref_count() != INT32_MAX) {
     // The dynamic reference count is decremented to zero to free memory.
     device_tensor->DecreaseDynamicRefCount(from_aid.Name());
     if ((device_tensor->dynamic_ref_count() == 0) && (device_tensor->GetPtr() != nullptr)) {
       MS_LOG(DEBUG) << "Free memory by the dynamic reference count, device address" << device_tensor->GetPtr();
-      FreeMemoryInner(device_tensor, device_context);
+      return true;
     }
   }
+  return false;
+}
+
+void FreeMemoryByRefCount(DeviceTensor *const device_tensor, const DeviceContext *device_context, const AID &from_aid) {
+  if (DecreaseRefCountToFree(device_tensor, from_aid)) {
+    FetchFreeDeviceContext(device_tensor, device_context)->FreeMemory(device_tensor);
+  }
 }
 }  // namespace
 
@@ -156,6 +162,29 @@ void MemoryManagerActor::AllocateBatchMemory(const std::vector<DeviceTensor *> *
   ActorDispatcher::Send(from_aid, &MemoryAwareActor::OnMemoryAllocFinish, op_context);
 }
 
+bool MemoryManagerActor::TryAllocateMemory(const std::vector<DeviceTensor *> &alloc_list,
+                                           const DeviceContext *device_context) {
+  MS_EXCEPTION_IF_NULL(device_context);
+  for (auto &device_tensor : alloc_list) {
+    MS_EXCEPTION_IF_NULL(device_tensor);
+    if (device_tensor->GetPtr() != nullptr) {
+      continue;
+    }
+    try {
+      if (!device_context->AllocateMemory(device_tensor, device_tensor->GetSize())) {
+        MS_LOG(INFO) << "Allocate memory of size " << device_tensor->GetSize()
+                     << " in the actor thread failed, fall back to the memory manager actor.";
+        return false;
+      }
+    } catch (const std::exception &e) {
+      MS_LOG(WARNING) << "Allocate memory of size " << device_tensor->GetSize()
+                      << " in the actor thread failed, fall back to the memory manager actor: " << e.what();
+      return false;
+    }
+  }
+  return true;
+}
+
 void MemoryManagerActor::FreeMemory(const std::vector<DeviceTensor *> *free_list, const DeviceContext *device_context,
                                     OpContext<DeviceTensor> *, const AID &from_aid) {
   MS_EXCEPTION_IF_NULL(free_list);
@@ -175,10 +204,16 @@ void MemoryManagerActor::FreeBatchMemory(const std::vector<DeviceTensor *> *free
                                       "The size of free list is not equal to the size of device contexts.");
   }
 
+  // Group the memory to free by the device context, so that each memory pool frees its batch in one go.
+  std::map<const DeviceContext *, std::vector<DeviceTensor *>> free_tensors;
   for (size_t i = 0; i < (*free_list).size(); ++i) {
     auto &device_tensor = (*free_list)[i];
-    auto &device_context = (*device_contexts)[i];
-    FreeMemoryByRefCount(device_tensor, device_context, from_aid);
+    if (DecreaseRefCountToFree(device_tensor, from_aid)) {
+      (void)free_tensors[FetchFreeDeviceContext(device_tensor, (*device_contexts)[i])].emplace_back(device_tensor);
+    }
+  }
+  for (const auto &item : free_tensors) {
+    item.first->FreeBatchMemory(item.second);
   }
 }
 
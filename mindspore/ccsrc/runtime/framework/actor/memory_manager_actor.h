@@ -51,6 +51,11 @@ class MemoryManagerActor : public ActorBase {
                            const std::vector<const DeviceContext *> *device_contexts,
                            OpContext<DeviceTensor> *const op_context, const AID &from_aid);
 
+  // Allocate memory in the calling actor thread for the device whose memory allocation is thread safe. Return false
+  // to let the MemoryManagerActor allocate the rest of the list, which retries after the memory free requests in its
+  // queue and reports the failure of the step.
+  static bool TryAllocateMemory(const std::vector<DeviceTensor *> &alloc_list, const DeviceContext *device_context);
+
   // The process entry of memory free.
   void FreeMemory(const std::vector<DeviceTensor *> *free_list, const DeviceContext *device_context,
                   OpContext<DeviceTensor> *const op_context, const AID &from_aid);
@@ -147,6 +147,14 @@ bool SuperKernelActor::CopyInputData(const OpContext<DeviceTensor> *context) {
                  << " need copy from address:" << input_device_tensor->GetPtr()
                  << ", type:" << input_device_tensor->DeviceType() << " to address:" << device_address->GetPtr()
                  << ", type:" << device_address->DeviceType() << ".";
+    // The devices which don't assign the static memory of the whole graph, such as CPU, allocate the graph inputs here.
+    if ((device_address->GetPtr() == nullptr) &&
+        (!device_contexts_[0]->AllocateMemory(device_address.get(), device_address->GetSize()))) {
+      MS_LOG(ERROR) << "Allocate memory failed, graph id: " << graph_->graph_id()
+                    << ", input node: " << input_node->DebugString() << ", alloc size: " << device_address->GetSize()
+                    << "B.";
+      return false;
+    }
     if (!Copy(device_address.get(), input_device_tensor)) {
       MS_LOG(ERROR) << "Copy data failed.";
       return false;
@@ -445,11 +445,9 @@ GraphId GraphCompiler::CompileGraphImpl(const KernelGraphPtr &graph, const Devic
   }
 #endif
 
-  // Set the graph sink flag.
-  auto is_executing_sink = device_context->IsExecutingSink(graph);
-  auto is_loop_count_sink = device_context->IsLoopCountSink(graph);
-  graph->set_is_executing_sink(is_executing_sink);
-  graph->set_is_loop_count_sink(is_loop_count_sink);
+  // Set the graph sink flag, which the optimization passes of some devices depend on.
+  graph->set_is_executing_sink(device_context->IsExecutingSink(graph));
+  graph->set_is_loop_count_sink(device_context->IsLoopCountSink(graph));
 
   // Execute optimization pass.
   device_context->OptimizeGraph(graph);
@@ -458,6 +456,10 @@ GraphId GraphCompiler::CompileGraphImpl(const KernelGraphPtr &graph, const Devic
   // 'KernelMod' is real executive object of kernel.
   device_context->CreateKernel(graph->execution_order());
 
+  // Decide the executing sink again by the optimized kernels, since some devices can only sink the graph whose final
+  // kernels are all supported.
+  graph->set_is_executing_sink(device_context->IsExecutingSink(graph));
+
 #ifndef ENABLE_SECURITY
   session_->SetSummaryNodes(graph.get());
 #endif
@@ -497,11 +499,15 @@ GraphId GraphCompiler::CompileGraph(const session::OpRunInfo &op_run_info, bool
   // Check if the graph cache exists.
   auto iter = run_op_graphs_.find(op_run_info.graph_info);
   auto &op_lazy_builder = runtime::OpLazyBuilder::GetInstance();
-  if (iter != run_op_graphs_.end() && op_lazy_builder.QueueEmpty()) {
+  // The cached graph is reused while the former ops are waiting in the lazy queue unless it is one of them, so the
+  // ops queued in the lazy build don't construct and build the graphs again.
+  if (iter != run_op_graphs_.end()) {
     const auto &graph = iter->second;
     MS_EXCEPTION_IF_NULL(graph);
-    *single_op_cache_hit = true;
-    return graph->graph_id();
+    if (!op_lazy_builder.IsGraphPending(graph->graph_id())) {
+      *single_op_cache_hit = true;
+      return graph->graph_id();
+    }
   }
   *single_op_cache_hit = false;
   // Generate kernel graph.
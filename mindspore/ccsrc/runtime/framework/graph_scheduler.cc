@@ -684,6 +684,11 @@ std::vector<DataSourceActorPtr> GraphScheduler::BuildDataSourceActor(const Graph
 
 std::vector<KernelActorPtr> GraphScheduler::BuildKernelActor(const GraphCompilerInfo &graph_compiler_info) {
   std::vector<KernelActorPtr> kernel_actors;
+  // The kernel actor runs more than once in a step of control flow, then the inline memory alloc may find the output
+  // device tensors whose memory free request is still in the queue of MemoryManagerActor. Without control flow the
+  // loop count actor waits for the MemoryManagerActor at the end of every step.
+  bool is_control_flow =
+    (graph_compiler_info.control_node_parser_ != nullptr) && graph_compiler_info.control_node_parser_->IsInited();
 
   for (size_t i = 0; i < graph_compiler_info.graphs_.size(); ++i) {
     const auto &graph = graph_compiler_info.graphs_[i];
@@ -700,6 +705,10 @@ std::vector<KernelActorPtr> GraphScheduler::BuildKernelActor(const GraphCompiler
     if (strategy == GraphExecutionStrategy::kStep) {
       strategy = (is_single_op_graph ? strategy : GraphExecutionStrategy::kPipeline);
     }
+    MS_EXCEPTION_IF_NULL(device_context);
+    bool inline_memory_alloc = (!is_control_flow) && (strategy == GraphExecutionStrategy::kPipeline) &&
+                               device_context->IsMemoryAllocThreadSafe();
+    MS_LOG(INFO) << "Graph " << graph->graph_id() << " inline memory alloc: " << inline_memory_alloc;
 
     for (auto &kernel : execution_order) {
       MS_EXCEPTION_IF_NULL(kernel);
@@ -707,6 +716,7 @@ std::vector<KernelActorPtr> GraphScheduler::BuildKernelActor(const GraphCompiler
         auto kernel_actor = std::make_shared<KernelActor>(kernel->fullname_with_scope(), kernel, device_context,
                                                           memory_manager_aid_, debug_aid_, recorder_aid_, strategy);
         MS_EXCEPTION_IF_NULL(kernel_actor);
+        kernel_actor->inline_memory_alloc_ = inline_memory_alloc;
         InsertActor(kernel_actor.get());
         (void)kernel_actors.emplace_back(kernel_actor);
       }
@@ -34,6 +34,7 @@
 #include "backend/optimizer/graph_kernel/graph_kernel_optimization.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "profiler/device/cpu/cpu_profiling.h"
+#include "utils/ms_utils.h"
 #if ((defined ENABLE_CPU) && (!defined _WIN32))
 #include "runtime/hardware/cpu/ms_collective_comm_lib.h"
 #endif
@@ -75,6 +76,10 @@ void CPUDeviceContext::Initialize() {
 }
 
 void CPUDeviceContext::Destroy() {
+  {
+    std::lock_guard<std::mutex> lock(graph_executors_mutex_);
+    graph_executors_.clear();
+  }
   // Release memory.
   if (mem_manager_ != nullptr) {
     mem_manager_->Finalize();
@@ -125,6 +130,26 @@ void CPUDeviceContext::FreeMemory(void *const ptr) const {
   mem_manager_->FreeMemFromMemPool(ptr);
 }
 
+void CPUDeviceContext::FreeBatchMemory(const std::vector<DeviceAddress *> &addresses) const {
+  MS_EXCEPTION_IF_NULL(mem_manager_);
+  std::vector<void *> device_ptrs;
+  for (auto address : addresses) {
+    MS_EXCEPTION_IF_NULL(address);
+    MS_EXCEPTION_IF_NULL(address->ptr_);
+    if (address->DeviceType() != DeviceAddressType::kCPU) {
+      MS_LOG(EXCEPTION) << "The device address type is wrong: " << address->DeviceType();
+    }
+    if (!address->from_mem_pool()) {
+      continue;
+    }
+    (void)device_ptrs.emplace_back(address->ptr_);
+    address->ptr_ = nullptr;
+  }
+  if (!device_ptrs.empty()) {
+    mem_manager_->FreeMemsFromMemPool(device_ptrs);
+  }
+}
+
 DeviceAddressPtr CPUDeviceContext::CreateDeviceAddress(void *const device_ptr, size_t device_size, const string &format,
                                                        TypeId type_id) const {
   return std::make_shared<CPUDeviceAddress>(device_ptr, device_size, format, type_id, device_context_key_.device_name_,
@@ -275,6 +300,34 @@ void CPUDeviceContext::PreprocessBeforeRunGraph(const KernelGraphPtr &graph) con
   auto execution_order = graph->execution_order();
   AnfAlgo::ReorderPosteriorExecList(NOT_NULL(&execution_order));
   graph->set_execution_order(execution_order);
+
+  // Build the schedule of the graph launched in whole by the final execution order.
+  if (graph->is_executing_sink()) {
+    auto graph_executor = std::make_shared<CPUGraphExecutor>(graph);
+    std::lock_guard<std::mutex> lock(graph_executors_mutex_);
+    graph_executors_[graph->graph_id()] = graph_executor;
+  }
+}
+
+bool CPUDeviceContext::IsExecutingSink(const KernelGraphPtr &graph) const {
+  static const bool enable_graph_sink = common::GetEnv("MS_DEV_CPU_GRAPH_SINK") == "1";
+  return enable_graph_sink && CPUGraphExecutor::CanSink(graph);
+}
+
+bool CPUDeviceContext::LaunchGraph(const KernelGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  CPUGraphExecutorPtr graph_executor = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(graph_executors_mutex_);
+    auto iter = graph_executors_.find(graph->graph_id());
+    if (iter == graph_executors_.end()) {
+      MS_LOG(ERROR) << "The graph " << graph->graph_id() << " is not prepared to launch in whole.";
+      return false;
+    }
+    graph_executor = iter->second;
+  }
+  MS_EXCEPTION_IF_NULL(graph_executor);
+  return graph_executor->Launch(this);
 }
 
 bool CPUDeviceContext::LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
@@ -340,7 +393,6 @@ bool CPUDeviceContext::LaunchKernelWithProfiling(const CNodePtr &kernel, const s
                                                  const std::vector<AddressPtr> &workspace,
                                                  const std::vector<AddressPtr> &outputs) const {
   MS_EXCEPTION_IF_NULL(kernel);
-  std::lock_guard<std::mutex> locker(launch_mutex_);
 
   auto profiler_inst = profiler::cpu::CPUProfiler::GetInstance();
   MS_EXCEPTION_IF_NULL(profiler_inst);
@@ -23,6 +23,8 @@
 #include "runtime/hardware/device_context.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "runtime/device/memory_manager.h"
+#include "runtime/hardware/cpu/cpu_graph_executor.h"
+#include "utils/hash_map.h"
 
 namespace mindspore {
 namespace device {
@@ -42,6 +44,9 @@ class CPUDeviceContext : public DeviceContext {
   // Relevant function to allocate and free device memory of raw ptr.
   void *AllocateMemory(size_t size) const override;
   void FreeMemory(void *const ptr) const override;
+  void FreeBatchMemory(const std::vector<DeviceAddress *> &addresses) const override;
+  // The CPU memory pool is guarded by lock and serves the small memory from the thread caches.
+  bool IsMemoryAllocThreadSafe() const override { return true; }
 
   DeviceAddressPtr CreateDeviceAddress(void *const device_ptr, size_t device_size, const string &format,
                                        TypeId type_id) const override;
@@ -56,6 +61,10 @@ class CPUDeviceContext : public DeviceContext {
 
   void PreprocessBeforeRunGraph(const KernelGraphPtr &graph) const override;
 
+  // The graph without control flow is launched in whole by the super kernel actor when MS_DEV_CPU_GRAPH_SINK is 1.
+  bool IsExecutingSink(const KernelGraphPtr &graph) const override;
+  bool LaunchGraph(const KernelGraphPtr &graph) const override;
+
   bool LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
                     const std::vector<AddressPtr> &workspace, const std::vector<AddressPtr> &outputs,
                     bool is_dynamic_shape = false) const override;
@@ -76,7 +85,9 @@ class CPUDeviceContext : public DeviceContext {
   bool DoLaunchKernel(KernelMod *const kernel_mod, const std::vector<AddressPtr> &inputs,
                       const std::vector<AddressPtr> &workspace, const std::vector<AddressPtr> &outputs) const;
 
-  mutable std::mutex launch_mutex_;
+  // The executors of the graphs launched in whole, built before running the graphs.
+  mutable std::mutex graph_executors_mutex_;
+  mutable mindspore::HashMap<uint32_t, CPUGraphExecutorPtr> graph_executors_;
   std::shared_ptr<MemoryManager> mem_manager_;
   bool initialized_;
 };
@@ -0,0 +1,252 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/hardware/cpu/cpu_graph_executor.h"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "utils/hash_map.h"
+#include "utils/ms_context.h"
+#include "utils/trace_base.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+bool HasControlFlow(const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  // The control flow of the front graph is cut into several kernel graphs linked by the control actors, whose
+  // partial and call scheduling the whole graph launch can't take part in.
+  for (const auto &front_backend : graph->front_backend_anf_map()) {
+    const auto &front_node = front_backend.first;
+    MS_EXCEPTION_IF_NULL(front_node);
+    auto func_graph = front_node->func_graph();
+    if (func_graph == nullptr) {
+      continue;
+    }
+    auto manager = func_graph->manager();
+    if (manager != nullptr && manager->func_graphs().size() > 1) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IsBarrierKernel(const KernelGraphPtr &graph, const CNodePtr &kernel) {
+  for (size_t i = 0; i < AnfAlgo::GetInputNum(kernel); ++i) {
+    if (HasAbstractMonad(AnfAlgo::GetInputNode(kernel, i))) {
+      return true;
+    }
+  }
+  for (size_t i = 0; i < AnfAlgo::GetOutputTensorNum(kernel); ++i) {
+    if (graph->IsInRefOutputMap(std::make_pair(kernel, i))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void UpdateAddress(const std::vector<DeviceAddress *> &device_tensors, const std::vector<AddressPtr> &addresses) {
+  for (size_t i = 0; i < device_tensors.size(); ++i) {
+    addresses[i]->addr = device_tensors[i]->GetMutablePtr();
+    addresses[i]->size = device_tensors[i]->GetSize();
+  }
+}
+}  // namespace
+
+CPUGraphExecutor::CPUGraphExecutor(const KernelGraphPtr &graph) : graph_(graph) {
+  MS_EXCEPTION_IF_NULL(graph_);
+  kernels_ = graph_->execution_order();
+  mindspore::HashMap<AnfNodePtr, size_t> kernel_indices;
+  std::vector<std::vector<size_t>> deps(kernels_.size());
+  std::vector<bool> barriers(kernels_.size(), false);
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    const auto &kernel = kernels_[i];
+    MS_EXCEPTION_IF_NULL(kernel);
+    for (size_t j = 0; j < AnfAlgo::GetInputTensorNum(kernel); ++j) {
+      auto iter = kernel_indices.find(AnfAlgo::GetPrevNodeOutput(kernel, j, true).first);
+      if (iter != kernel_indices.end()) {
+        deps[i].push_back(iter->second);
+      }
+    }
+    barriers[i] = IsBarrierKernel(graph_, kernel);
+    kernel_indices[kernel] = i;
+  }
+  levels_ = BuildLevels(deps, barriers);
+  MS_LOG(INFO) << "Graph " << graph_->graph_id() << " runs " << kernels_.size() << " kernels in " << levels_.size()
+               << " levels.";
+}
+
+bool CPUGraphExecutor::CanSink(const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  if (ms_context->get_param<int>(MS_CTX_EXECUTION_MODE) != kGraphMode || graph->is_dynamic_shape() ||
+      graph->execution_order().empty() || HasControlFlow(graph)) {
+    return false;
+  }
+  for (const auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    // The data queue kernel is launched by the device queue data source actor, and the communication kernels need the
+    // continuous memory prepared by the data prepare actor.
+    if (AnfAlgo::IsCommunicationOp(kernel) || AnfAlgo::GetCNodeName(kernel) == kGetNextOpName ||
+        AnfAlgo::IsInplaceNode(kernel, "skip") || AnfAlgo::IsDynamicShape(kernel)) {
+      MS_LOG(INFO) << "Graph " << graph->graph_id() << " runs by kernel actors for kernel "
+                   << kernel->fullname_with_scope();
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<std::vector<size_t>> CPUGraphExecutor::BuildLevels(const std::vector<std::vector<size_t>> &deps,
+                                                               const std::vector<bool> &barriers) {
+  if (deps.size() != barriers.size()) {
+    MS_LOG(EXCEPTION) << "The size of deps " << deps.size() << " is not equal to the size of barriers "
+                      << barriers.size();
+  }
+  std::vector<std::vector<size_t>> levels;
+  std::vector<size_t> kernel_levels(deps.size(), 0);
+  // The kernels after a barrier start from the level next to it.
+  size_t min_level = 0;
+  for (size_t i = 0; i < deps.size(); ++i) {
+    size_t level = min_level;
+    if (barriers[i]) {
+      level = levels.size();
+    }
+    for (auto dep : deps[i]) {
+      if (dep >= i) {
+        MS_LOG(EXCEPTION) << "Kernel " << i << " depends on the latter kernel " << dep;
+      }
+      level = std::max(level, kernel_levels[dep] + 1);
+    }
+    if (level >= levels.size()) {
+      levels.resize(level + 1);
+    }
+    levels[level].push_back(i);
+    kernel_levels[i] = level;
+    if (barriers[i]) {
+      min_level = level + 1;
+    }
+  }
+  return levels;
+}
+
+void CPUGraphExecutor::InitLaunchInfos() {
+  launch_infos_.resize(kernels_.size());
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    auto &launch_info = launch_infos_[i];
+    const auto &kernel = kernels_[i];
+    launch_info.kernel_ = kernel;
+    for (size_t j = 0; j < AnfAlgo::GetInputTensorNum(kernel); ++j) {
+      auto device_tensor = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, j, true);
+      MS_EXCEPTION_IF_NULL(device_tensor);
+      (void)launch_info.input_device_tensors_.emplace_back(device_tensor.get());
+      (void)launch_info.inputs_.emplace_back(std::make_shared<kernel::Address>());
+    }
+    for (size_t j = 0; j < AnfAlgo::GetOutputTensorNum(kernel); ++j) {
+      auto device_tensor = AnfAlgo::GetMutableOutputAddr(kernel, j, false);
+      MS_EXCEPTION_IF_NULL(device_tensor);
+      (void)launch_info.output_device_tensors_.emplace_back(device_tensor.get());
+      (void)launch_info.outputs_.emplace_back(std::make_shared<kernel::Address>());
+    }
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    for (size_t j = 0; j < kernel_mod->GetWorkspaceSizeList().size(); ++j) {
+      auto device_tensor = AnfAlgo::GetMutableWorkspaceAddr(kernel, j);
+      MS_EXCEPTION_IF_NULL(device_tensor);
+      (void)launch_info.workspace_device_tensors_.emplace_back(device_tensor.get());
+      (void)launch_info.workspaces_.emplace_back(std::make_shared<kernel::Address>());
+    }
+  }
+}
+
+bool CPUGraphExecutor::PrepareLaunchInfo(const DeviceContext *device_context, KernelLaunchInfo *launch_info) const {
+  MS_EXCEPTION_IF_NULL(launch_info);
+  // The outputs moved to the graph output tensors in the last step are allocated again.
+  for (auto device_tensors : {&launch_info->output_device_tensors_, &launch_info->workspace_device_tensors_}) {
+    for (auto device_tensor : *device_tensors) {
+      if (device_tensor->GetPtr() != nullptr) {
+        continue;
+      }
+      if (!device_context->AllocateMemory(device_tensor, device_tensor->GetSize())) {
+        MS_LOG(ERROR) << "Allocate memory failed, kernel name: " << launch_info->kernel_->fullname_with_scope()
+                      << ", alloc size: " << device_tensor->GetSize() << "B.";
+        return false;
+      }
+    }
+  }
+  UpdateAddress(launch_info->input_device_tensors_, launch_info->inputs_);
+  UpdateAddress(launch_info->output_device_tensors_, launch_info->outputs_);
+  UpdateAddress(launch_info->workspace_device_tensors_, launch_info->workspaces_);
+  return true;
+}
+
+bool CPUGraphExecutor::LaunchLevel(const DeviceContext *device_context, const std::vector<size_t> &level) {
+  for (auto index : level) {
+    if (!PrepareLaunchInfo(device_context, &launch_infos_[index])) {
+      return false;
+    }
+  }
+  if (level.size() == 1) {
+    const auto &launch_info = launch_infos_[level[0]];
+    return device_context->LaunchKernel(launch_info.kernel_, launch_info.inputs_, launch_info.workspaces_,
+                                        launch_info.outputs_);
+  }
+
+  // The exceptions can't be thrown out of the thread pool.
+  std::atomic<bool> success{true};
+  std::vector<common::Task> tasks;
+  for (auto index : level) {
+    const auto &launch_info = launch_infos_[index];
+    (void)tasks.emplace_back([&launch_info, &success, device_context]() {
+      try {
+        if (!device_context->LaunchKernel(launch_info.kernel_, launch_info.inputs_, launch_info.workspaces_,
+                                          launch_info.outputs_)) {
+          MS_LOG(ERROR) << "Launch kernel failed, kernel name: " << launch_info.kernel_->fullname_with_scope();
+          success = false;
+        }
+      } catch (const std::exception &e) {
+        MS_LOG(ERROR) << "Launch kernel " << launch_info.kernel_->fullname_with_scope() << " exception: " << e.what()
+                      << trace::DumpSourceLines(launch_info.kernel_);
+        success = false;
+      }
+      return common::SUCCESS;
+    });
+  }
+  kernel::ParallelLaunch(tasks);
+  return success.load();
+}
+
+bool CPUGraphExecutor::Launch(const DeviceContext *device_context) {
+  MS_EXCEPTION_IF_NULL(device_context);
+  if (launch_infos_.empty()) {
+    InitLaunchInfos();
+  }
+  for (const auto &level : levels_) {
+    if (!LaunchLevel(device_context, level)) {
+      MS_LOG(ERROR) << "Launch graph " << graph_->graph_id() << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_CPU_GRAPH_EXECUTOR_H_
+#define MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_CPU_GRAPH_EXECUTOR_H_
+
+#include <vector>
+#include <memory>
+#include "runtime/hardware/device_context.h"
+#include "backend/session/kernel_graph.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// Run the kernel graph in whole by the super kernel actor instead of one kernel actor per kernel. The kernels are
+// grouped into levels at compile time, each kernel only depends on the kernels of the former levels, so the kernels
+// of a level run in parallel on the actor thread pool. The memory of the kernel outputs and workspaces is allocated
+// in the first step and kept, so no memory message is sent in the steps.
+class CPUGraphExecutor {
+ public:
+  explicit CPUGraphExecutor(const KernelGraphPtr &graph);
+  ~CPUGraphExecutor() = default;
+
+  // The graphs with dynamic shape, control flow, communication, data queue or in-place kernels are left to the kernel
+  // actors.
+  static bool CanSink(const KernelGraphPtr &graph);
+
+  // Group the kernels into levels by the dependencies, deps[i] are the indices of the former kernels which kernel i
+  // depends on. A barrier kernel, which has side effect, runs alone after all the former kernels and before all the
+  // latter ones.
+  static std::vector<std::vector<size_t>> BuildLevels(const std::vector<std::vector<size_t>> &deps,
+                                                      const std::vector<bool> &barriers);
+
+  bool Launch(const DeviceContext *device_context);
+
+  size_t level_num() const { return levels_.size(); }
+
+ private:
+  struct KernelLaunchInfo {
+    CNodePtr kernel_;
+    std::vector<DeviceAddress *> input_device_tensors_;
+    std::vector<DeviceAddress *> output_device_tensors_;
+    std::vector<DeviceAddress *> workspace_device_tensors_;
+    std::vector<AddressPtr> inputs_;
+    std::vector<AddressPtr> outputs_;
+    std::vector<AddressPtr> workspaces_;
+  };
+
+  // The device addresses are created after the schedule is built, so fetch them in the first launch.
+  void InitLaunchInfos();
+  bool PrepareLaunchInfo(const DeviceContext *device_context, KernelLaunchInfo *launch_info) const;
+  bool LaunchLevel(const DeviceContext *device_context, const std::vector<size_t> &level);
+
+  KernelGraphPtr graph_;
+  std::vector<CNodePtr> kernels_;
+  std::vector<std::vector<size_t>> levels_;
+  std::vector<KernelLaunchInfo> launch_infos_;
+};
+using CPUGraphExecutorPtr = std::shared_ptr<CPUGraphExecutor>;
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_CPU_GRAPH_EXECUTOR_H_
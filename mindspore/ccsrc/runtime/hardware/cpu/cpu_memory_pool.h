@@ -38,7 +38,8 @@ class CPUMemoryPool : public DynamicMemPoolBestFit {
   size_t free_mem_size() override;
 
  private:
-  CPUMemoryPool() = default;
+  // The actors alloc and free small host memory on the critical path from many threads.
+  CPUMemoryPool() { EnableThreadCache(); }
   DISABLE_COPY_AND_ASSIGN(CPUMemoryPool);
 
   size_t total_used_memory_{0};
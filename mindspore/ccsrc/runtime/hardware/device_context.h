@@ -75,6 +75,15 @@ class DeviceContext {
   // Relevant function to allocate and free device memory of raw ptr.
   virtual void *AllocateMemory(size_t size) const = 0;
   virtual void FreeMemory(void *const ptr) const = 0;
+  // Free the device memory of a batch of DeviceAddress, the device can free them in one go.
+  virtual void FreeBatchMemory(const std::vector<DeviceAddress *> &addresses) const {
+    for (auto address : addresses) {
+      FreeMemory(address);
+    }
+  }
+  // Whether the memory can be allocated concurrently by the actors themselves instead of through the
+  // MemoryManagerActor.
+  virtual bool IsMemoryAllocThreadSafe() const { return false; }
 
   // Allocate continuous device memory end to end into 'addr_list'.
   // Communication operators may need continuous memory for input and output
@@ -32,6 +32,30 @@ void OpLazyBuilder::ClearAllResources() {
   op_build_tasks.clear();
   std::queue<std::shared_ptr<OpTask>> empty;
   std::swap(op_run_tasks, empty);
+  pending_graphs_.clear();
+}
+
+void OpLazyBuilder::PushOpRunTask(const std::shared_ptr<OpTask> &op_run_task) {
+  MS_EXCEPTION_IF_NULL(op_run_task);
+  MS_EXCEPTION_IF_NULL(op_run_task->context());
+  MS_EXCEPTION_IF_NULL(op_run_task->context()->graph());
+  ++pending_graphs_[op_run_task->context()->graph()->graph_id()];
+  op_run_tasks.push(op_run_task);
+}
+
+void OpLazyBuilder::PopOpRunTask() {
+  if (op_run_tasks.empty()) {
+    return;
+  }
+  auto &op_run_task = op_run_tasks.front();
+  MS_EXCEPTION_IF_NULL(op_run_task);
+  MS_EXCEPTION_IF_NULL(op_run_task->context());
+  MS_EXCEPTION_IF_NULL(op_run_task->context()->graph());
+  auto iter = pending_graphs_.find(op_run_task->context()->graph()->graph_id());
+  if (iter != pending_graphs_.end() && --iter->second == 0) {
+    (void)pending_graphs_.erase(iter);
+  }
+  op_run_tasks.pop();
 }
 
 void OpLazyBuilder::ExecuteRemainingTasks() {
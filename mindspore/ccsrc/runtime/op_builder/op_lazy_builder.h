@@ -102,9 +102,11 @@ class OpLazyBuilder {
   void ExecuteRemainingTasks();
 
   void PushOpBuildTask(const std::shared_ptr<OpTask> &op_build_task) { op_build_tasks.push_back(op_build_task); }
-  void PushOpRunTask(const std::shared_ptr<OpTask> &op_run_task) { op_run_tasks.push(op_run_task); }
-  void PopOpRunTask() { op_run_tasks.pop(); }
+  void PushOpRunTask(const std::shared_ptr<OpTask> &op_run_task);
+  void PopOpRunTask();
   bool QueueEmpty() const { return op_run_tasks.empty() && op_build_tasks.empty(); }
+  // The graph waiting in the queue can't be reused by the latter op, whose outputs would share its device addresses.
+  bool IsGraphPending(GraphId graph_id) const { return pending_graphs_.find(graph_id) != pending_graphs_.end(); }
   bool QueueFull() const { return op_build_tasks.size() > kMaxQueueSize || op_run_tasks.size() > kMaxQueueSize; }
   bool registered() const { return registered_; }
 
@@ -114,6 +116,8 @@ class OpLazyBuilder {
   DISABLE_COPY_AND_ASSIGN(OpLazyBuilder);
   std::vector<std::shared_ptr<OpTask>> op_build_tasks;
   std::queue<std::shared_ptr<OpTask>> op_run_tasks;
+  // The number of the run tasks of each graph in the queue.
+  std::map<GraphId, size_t> pending_graphs_;
   std::function<void()> execute_callback_{nullptr};
   inline static size_t kMaxQueueSize = 20;
   bool executing_{false};
@@ -228,6 +228,21 @@ class MS_API LiteSession {
   /// \return STATUS as an error code of the set operation, STATUS is defined in errorcode.h
   virtual int UpdateFeatureMaps(const std::vector<tensor::MSTensor *> &features) { return mindspore::lite::RET_ERROR; }
 
+  /// \brief Record the current trainable weights as the reference for ExportWeightsDelta
+  ///
+  /// \return STATUS as an error code of the set operation, STATUS is defined in errorcode.h
+  virtual int TakeWeightsSnapshot() { return mindspore::lite::RET_ERROR; }
+
+  /// \brief Serialize the change of the trainable weights since the last snapshot, quantized for upload
+  /// \param[in] buf destination buffer
+  /// \param[in] buf_size size of buf in bytes
+  /// \param[out] out_size bytes written, or bytes required when buf is too small
+  /// \param[in] data_type kNumberTypeInt8 or kNumberTypeFloat16
+  /// \return STATUS as an error code of the set operation, STATUS is defined in errorcode.h
+  virtual int ExportWeightsDelta(void *buf, size_t buf_size, size_t *out_size, TypeId data_type) {
+    return mindspore::lite::RET_ERROR;
+  }
+
   /// \brief Get model gradient
   ///
   /// \return a vector of gradient tensors (MindSpore Lite MSTensor).
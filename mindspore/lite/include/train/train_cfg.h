@@ -60,16 +60,19 @@ class TrainCfg {
     this->loss_name_ = rhs.loss_name_;
     this->mix_precision_cfg_ = rhs.mix_precision_cfg_;
     this->accumulate_gradients_ = rhs.accumulate_gradients_;
+    this->recompute_memory_budget_ = rhs.recompute_memory_budget_;
   }
   TrainCfg &operator=(const TrainCfg &rhs) {
     this->loss_name_ = rhs.loss_name_;
     this->mix_precision_cfg_ = rhs.mix_precision_cfg_;
     this->accumulate_gradients_ = rhs.accumulate_gradients_;
+    this->recompute_memory_budget_ = rhs.recompute_memory_budget_;
     return *this;
   }
   std::vector<std::string> loss_name_ = {"loss_fct"}; /**< Set part of the name that identify a loss kernel */
   MixPrecisionCfg mix_precision_cfg_;                 /**< Mix precision configuration */
   bool accumulate_gradients_ = false; /**< If true gardents are accmulated and can be read by GetGradients */
+  size_t recompute_memory_budget_ = 0; /**< If not 0, activations are recomputed to keep the arena in this budget */
 };
 
 }  // namespace lite
@@ -57,6 +57,9 @@ static const char *const kMSCacheModelPath = "cache_model_path";
 static const char *const kMSCacheVocabSize = "vocab_size";
 static const char *const kMSCacheDeviceSize = "device_cache_size";
 static const char *const kMSCacheSerializePath = "serialize_path";
+// weight decode
+static const char *const kWeightDecode = "weight_decode";
+static const char *const kWeightDecodeLazy = "lazy_decode";
 }  // namespace lite
 }  // namespace mindspore
 
@@ -37,6 +37,7 @@ Status A2L_ConvertConfig(const TrainCfg *a_train_cfg, lite::TrainCfg *l_train_cf
   l_train_cfg->mix_precision_cfg_.keep_batchnorm_fp32_ = (a_train_cfg->optimization_level_ != kO3);
   l_train_cfg->mix_precision_cfg_.num_of_not_nan_iter_th_ = a_train_cfg->mix_precision_cfg_.num_of_not_nan_iter_th_;
   l_train_cfg->accumulate_gradients_ = a_train_cfg->accumulate_gradients_;
+  l_train_cfg->recompute_memory_budget_ = a_train_cfg->recompute_memory_budget_;
   return kSuccess;
 }
 }  // namespace mindspore
@@ -205,6 +205,12 @@ int LiteSession::ConvertTensorsData(const lite::LiteModel *model, size_t tensor_
     return RET_ERROR;
   }
 
+#ifndef WEIGHT_DECODE_CLIP
+  if (lazy_weight_decode_ && WeightDecoder::NeedDecompress(*src_tensor)) {
+    lazy_weight_decoder_.Register(dst_tensor, src_tensor);
+    return RET_OK;
+  }
+#endif
   auto ret = DecompressTensor(*src_tensor, dst_tensor);
   if (ret == RET_NO_CHANGE) {
     if (dst_tensor->Size() == 0 || src_tensor->length() < dst_tensor->Size()) {
@@ -265,6 +271,21 @@ lite::Tensor *LiteSession::ConvertTensor(const schema::Tensor &src_tensor) {
   return dst_tensor;
 }
 
+void LiteSession::InitLazyWeightDecode() {
+#ifndef WEIGHT_DECODE_CLIP
+  lazy_weight_decode_ = false;
+  if (config_info_ == nullptr) {
+    return;
+  }
+  auto section = config_info_->find(kWeightDecode);
+  if (section == config_info_->end()) {
+    return;
+  }
+  auto lazy = section->second.find(kWeightDecodeLazy);
+  lazy_weight_decode_ = (lazy != section->second.end() && (lazy->second == "true" || lazy->second == "on"));
+#endif
+}
+
 int LiteSession::ConvertTensors(const lite::Model *model) {
   MS_ASSERT(model != nullptr);
   auto lite_model = reinterpret_cast<const lite::LiteModel *>(model);
@@ -555,6 +576,7 @@ int LiteSession::CompileGraph(Model *model) {
     return ret;
   }
 
+  InitLazyWeightDecode();
   ret = ConvertTensors(model);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "ConvertTensors failed: " << ret;
@@ -569,7 +591,20 @@ int LiteSession::CompileGraph(Model *model) {
                       &is_control_flow_, execution_plan_, delegate_, delegate_device_type_);
   scheduler.SetupSchedulerCb(std::move(sched_cb_));
   scheduler.SetConfig(config_info_);
+#ifndef WEIGHT_DECODE_CLIP
+  if (lazy_weight_decode_) {
+    scheduler.SetLazyWeightDecoder(&lazy_weight_decoder_);
+  }
+#endif
   ret = scheduler.Schedule(&kernels_);
+#ifndef WEIGHT_DECODE_CLIP
+  // the model may be freed after compiling, weights no kernel asked for stay undecoded
+  if (lazy_weight_decode_) {
+    auto skipped = lazy_weight_decoder_.Clear();
+    MS_LOG(INFO) << "lazily decoded " << lazy_weight_decoder_.decoded_size() << " bytes of weights, " << skipped
+                 << " compressed tensors unused";
+  }
+#endif
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "Schedule kernels failed: " << ret;
     is_running_.store(false);
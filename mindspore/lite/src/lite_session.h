@@ -42,6 +42,9 @@
 #include "src/runtime/gpu/opencl/opencl_runtime.h"
 #endif
 #include "src/scheduler_cb.h"
+#ifndef WEIGHT_DECODE_CLIP
+#include "src/weight_decoder.h"
+#endif
 
 namespace mindspore {
 namespace lite {
@@ -95,6 +98,8 @@ class LiteSession : public session::LiteSession {
   int ConvertTensorsData(const lite::LiteModel *model, size_t tensor_index, lite::Tensor *dst_tensor);
   lite::Tensor *ConvertTensor(const schema::Tensor &src_tensor);
   int ConvertTensors(const lite::Model *model);
+
+  void InitLazyWeightDecode();
   void InitGraphInOutTensorsMap(const lite::Model *model);
   void InitGraphInputTensors(const lite::Model *model);
   void InitGraphInputMSTensors();
@@ -176,6 +181,10 @@ class LiteSession : public session::LiteSession {
   std::map<std::string, TypeId> *execution_plan_ = nullptr;
   const std::map<std::string, std::map<std::string, std::string>> *config_info_ = nullptr;
   std::vector<kernel::LiteKernel *> non_tail_call_kernels_;
+#ifndef WEIGHT_DECODE_CLIP
+  bool lazy_weight_decode_ = false;
+  LazyWeightDecoder lazy_weight_decoder_;
+#endif
 };
 }  // namespace lite
 }  // namespace mindspore
@@ -170,6 +170,34 @@ int AdamCPUKernel::OptimizerStep() {
   return ret;
 }
 
+int AdamCPUKernel::GetFusedSegment(FusedOptimizerSegment *segment) {
+  CHECK_NULL_RETURN(segment);
+  CHECK_LESS_RETURN(in_tensors_.size(), DIMENSION_10D);
+  auto beta1_power = reinterpret_cast<float *>(in_tensors_.at(kBeta1PowerIdx)->MutableData())[0];
+  auto beta2_power = reinterpret_cast<float *>(in_tensors_.at(kBeta2PowerIdx)->MutableData())[0];
+  if ((1.f - beta1_power) <= 0.0f || (1.f - beta2_power) < 0.0f) {
+    MS_LOG(ERROR) << "invalid beta power for adam bias correction";
+    return RET_ERROR;
+  }
+  segment->type_ = FusedOptimizer_Adam;
+  segment->weight_ = reinterpret_cast<float *>(in_tensors_.at(kWeightIdx)->MutableData());
+  segment->moment1_ = reinterpret_cast<float *>(in_tensors_.at(kMomentVector1stIdx)->MutableData());
+  segment->moment2_ = reinterpret_cast<float *>(in_tensors_.at(kMomentVector2stIdx)->MutableData());
+  segment->gradient_ = reinterpret_cast<float *>(in_tensors_.at(kGradientIdx)->MutableData());
+  segment->grad_sum_ = grad_sum_;
+  segment->length_ = in_tensors_.at(kWeightIdx)->ElementsNum();
+  segment->lr_ = lr_ * std::sqrt(1.f - beta2_power) / (1.f - beta1_power);
+  segment->beta1_ = reinterpret_cast<float *>(in_tensors_.at(kBeta1Idx)->MutableData())[0];
+  segment->beta2_ = reinterpret_cast<float *>(in_tensors_.at(kBeta2Idx)->MutableData())[0];
+  segment->epsilon_ = reinterpret_cast<float *>(in_tensors_.at(kEpsilonIdx)->MutableData())[0];
+  segment->use_nesterov_ = adam_param_->use_nesterov_;
+  CHECK_NULL_RETURN(segment->weight_);
+  CHECK_NULL_RETURN(segment->moment1_);
+  CHECK_NULL_RETURN(segment->moment2_);
+  CHECK_NULL_RETURN(segment->gradient_);
+  return RET_OK;
+}
+
 kernel::InnerKernel *CpuAdamFp32KernelCreator(const std::vector<lite::Tensor *> &inputs,
                                               const std::vector<lite::Tensor *> &outputs, OpParameter *opParameter,
                                               const lite::Context *ctx, const kernel::KernelKey &desc) {
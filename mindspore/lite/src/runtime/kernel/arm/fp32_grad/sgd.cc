@@ -227,6 +227,31 @@ int SgdCPUKernel::OptimizerStep() {
   return RET_OK;
 }
 
+int SgdCPUKernel::GetFusedSegment(FusedOptimizerSegment *segment) {
+  CHECK_NULL_RETURN(segment);
+  CHECK_LESS_RETURN(in_tensors_.size(), 6);
+  auto stat = reinterpret_cast<float *>(in_tensors_.at(5)->MutableData());
+  CHECK_NULL_RETURN(stat);
+  CHECK_NULL_RETURN(in_tensors_.at(4)->MutableData());
+  segment->type_ = FusedOptimizer_Sgd;
+  segment->weight_ = reinterpret_cast<float *>(in_tensors_.at(0)->MutableData());
+  segment->moment1_ = reinterpret_cast<float *>(in_tensors_.at(3)->MutableData());
+  segment->moment2_ = nullptr;
+  segment->gradient_ = reinterpret_cast<float *>(in_tensors_.at(1)->MutableData());
+  segment->grad_sum_ = grad_sum_;
+  segment->length_ = in_tensors_.at(0)->ElementsNum();
+  segment->lr_ = lr_;
+  segment->momentum_ = reinterpret_cast<float *>(in_tensors_.at(4)->MutableData())[0];
+  segment->dampening_ = sgd_param_->dampening_;
+  segment->use_nesterov_ = sgd_param_->use_nesterov_;
+  // same condition as Run, which selects SgdRunInit while stat is set
+  segment->sgd_init_ = (*stat > 0.0f);
+  CHECK_NULL_RETURN(segment->weight_);
+  CHECK_NULL_RETURN(segment->moment1_);
+  CHECK_NULL_RETURN(segment->gradient_);
+  return RET_OK;
+}
+
 kernel::InnerKernel *CpuSgdFp32KernelCreator(const std::vector<lite::Tensor *> &inputs,
                                              const std::vector<lite::Tensor *> &outputs, OpParameter *opParameter,
                                              const lite::Context *ctx, const kernel::KernelKey &desc) {
@@ -42,6 +42,7 @@ class SgdCPUKernel : public OptimizerKernel {
   int Execute(int task_id);
   int OptimizerStep() override;
   std::vector<int> GetOptimizerParamsIdxs() const override;
+  int GetFusedSegment(FusedOptimizerSegment *segment) override;
 
  private:
   int thread_count_;
@@ -573,6 +573,14 @@ int Scheduler::InferNodeShape(const lite::Model::Node *node) {
   FindNodeInoutTensors(*node, &inputs, &outputs);
   int ret;
 #ifndef CUSTOM_KERNEL_REGISTRY_CLIP
+#ifndef WEIGHT_DECODE_CLIP
+  // the infers registered by users may read any const input, so the compressed weights are decoded in advance
+  bool user_infer = IsCustomNode(primitive, schema_version_) || !context_->GetProviders().empty();
+  if (lazy_weight_decoder_ != nullptr && user_infer && lazy_weight_decoder_->Decode(inputs) != RET_OK) {
+    MS_LOG(ERROR) << "decode weights of " << node->name_ << " failed";
+    return RET_ERROR;
+  }
+#endif
   ret = KernelInferShape(inputs, outputs, node->primitive_, context_->GetProviders(), schema_version_);
   if (ret != RET_NOT_SUPPORT) {
     return ret;
@@ -612,6 +620,18 @@ int Scheduler::InferNodeShape(const lite::Model::Node *node) {
     return InferCallShape(node);
   }
   ret = KernelInferShape(inputs, outputs, parameter);
+#ifndef WEIGHT_DECODE_CLIP
+  // a built-in infer reading a const input without data, e.g. the shape of Reshape, reports RET_INFER_INVALID, so the
+  // compressed weights of the node are decoded and the infer runs again
+  if (ret == RET_INFER_INVALID && lazy_weight_decoder_ != nullptr && lazy_weight_decoder_->HasPending(inputs)) {
+    if (lazy_weight_decoder_->Decode(inputs) != RET_OK) {
+      MS_LOG(ERROR) << "decode weights of " << node->name_ << " failed";
+      FreeOpParameters();
+      return RET_ERROR;
+    }
+    ret = KernelInferShape(inputs, outputs, parameter);
+  }
+#endif
 
 #ifndef CONTROLFLOW_TENSORLIST_CLIP
   if (*is_control_flow_) {
@@ -1036,6 +1056,13 @@ kernel::LiteKernel *Scheduler::FindBackendKernel(const std::vector<Tensor *> &in
                                                  const std::vector<Tensor *> &out_tensors, const Model::Node *node,
                                                  TypeId prefer_data_type) {
   MS_ASSERT(node != nullptr);
+#ifndef WEIGHT_DECODE_CLIP
+  // compressed weights are decoded when the first kernel that reads them is built
+  if (lazy_weight_decoder_ != nullptr && lazy_weight_decoder_->Decode(in_tensors) != RET_OK) {
+    MS_LOG(ERROR) << "decode weights of " << node->name_ << " failed";
+    return nullptr;
+  }
+#endif
   // why we need this
   TypeId data_type;
   if (node->quant_type_ == schema::QuantType_QUANT_WEIGHT) {
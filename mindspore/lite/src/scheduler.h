@@ -35,6 +35,9 @@
 #ifndef CONTROLFLOW_TENSORLIST_CLIP
 #include "src/control_flow/control_flow_scheduler.h"
 #endif
+#ifndef WEIGHT_DECODE_CLIP
+#include "src/weight_decoder.h"
+#endif
 
 namespace mindspore::lite {
 constexpr int kDefaultDeviceType = -1;
@@ -62,6 +65,9 @@ class Scheduler {
   void SetConfig(const std::map<std::string, std::map<std::string, std::string>> *config_info) {
     config_info_ = config_info;
   }
+#ifndef WEIGHT_DECODE_CLIP
+  void SetLazyWeightDecoder(LazyWeightDecoder *decoder) { lazy_weight_decoder_ = decoder; }
+#endif
   std::vector<kernel::LiteKernel *> NonTailCallNodes();
 
  private:
@@ -178,6 +184,9 @@ class Scheduler {
   int schema_version_ = SCHEMA_VERSION::SCHEMA_CUR;
   std::map<std::string, TypeId> *execution_plan_ = nullptr;
   const std::map<std::string, std::map<std::string, std::string>> *config_info_ = nullptr;
+#ifndef WEIGHT_DECODE_CLIP
+  LazyWeightDecoder *lazy_weight_decoder_ = nullptr;
+#endif
 };
 }  // namespace mindspore::lite
 
@@ -0,0 +1,333 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/train/fl_simulation.h"
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include "include/errorcode.h"
+#include "src/inner_context.h"
+#include "src/tensor.h"
+#include "src/common/log_adapter.h"
+#include "src/train/static_allocator.h"
+
+namespace mindspore {
+namespace lite {
+FLSimulation::~FLSimulation() { Clear(); }
+
+void FLSimulation::Clear() {
+  for (auto engine : engines_) {
+    delete engine;
+  }
+  engines_.clear();
+  slots_.clear();
+  state_size_ = 0;
+  init_state_.clear();
+  clients_.clear();
+  model_ = nullptr;
+}
+
+TrainSession *FLSimulation::CreateEngine(const Context *context, const TrainCfg *train_cfg) {
+  // every engine plans its own static arena, so it can not share the allocator of the user context
+  Context engine_context = *context;
+  engine_context.allocator = std::make_shared<StaticAllocator>();
+  auto *inner_context = new (std::nothrow) InnerContext(&engine_context);
+  if (inner_context == nullptr) {
+    MS_LOG(ERROR) << "new inner context failed";
+    return nullptr;
+  }
+  auto engine = std::make_unique<TrainSession>();
+  auto ret = engine->Init(inner_context, train_cfg);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "init engine session failed";
+    return nullptr;
+  }
+  ret = engine->CompileTrainGraph(model_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "compile engine train graph failed";
+    return nullptr;
+  }
+  ret = engine->Train();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "engine failed to switch to train mode";
+    return nullptr;
+  }
+  if (PrivatizeState(engine.get()) != RET_OK) {
+    MS_LOG(ERROR) << "engine failed to privatize trainable state";
+    return nullptr;
+  }
+  return engine.release();
+}
+
+// Const tensors point into the shared model buffer. Tensors training writes to are copied so that concurrently
+// running engines do not update each other's weights; frozen weights stay shared.
+int FLSimulation::PrivatizeState(TrainSession *engine) {
+  for (auto tensor : engine->GetTrainableStateTensors()) {
+    if (tensor->own_data() || tensor->data() == nullptr) {
+      continue;
+    }
+    auto size = tensor->Size();
+    auto data = malloc(size);
+    if (data == nullptr) {
+      MS_LOG(ERROR) << "malloc state of " << tensor->tensor_name() << " failed, size=" << size;
+      return RET_ERROR;
+    }
+    memcpy(data, tensor->data(), size);
+    tensor->set_data(data);
+    tensor->set_own_data(true);
+  }
+  return RET_OK;
+}
+
+int FLSimulation::Init(const std::string &model_file, const Context *context, const TrainCfg *train_cfg,
+                       int engine_num) {
+  if (context == nullptr) {
+    MS_LOG(ERROR) << "context cannot be nullptr";
+    return RET_NULL_PTR;
+  }
+  if (engine_num <= 0 || !engines_.empty()) {
+    MS_LOG(ERROR) << "invalid engine number " << engine_num << " or simulation already initialized";
+    return RET_PARAM_INVALID;
+  }
+  std::string filename = model_file;
+  if (filename.substr(filename.find_last_of(".") + 1) != "ms") {
+    filename = filename + ".ms";
+  }
+  model_ = std::shared_ptr<Model>(Model::Import(filename.c_str()));
+  if (model_ == nullptr) {
+    MS_LOG(ERROR) << "import model for simulation failed " << filename;
+    return RET_ERROR;
+  }
+  auto ret = InitEngines(context, train_cfg, engine_num);
+  if (ret != RET_OK) {
+    // a failed initialization leaves nothing behind, so Init can be called again
+    Clear();
+    return ret;
+  }
+  MS_LOG(INFO) << "FL simulation: " << engine_num << " engines, " << slots_.size() << " state tensors, "
+               << state_size_ << " bytes per client";
+  return RET_OK;
+}
+
+int FLSimulation::InitEngines(const Context *context, const TrainCfg *train_cfg, int engine_num) {
+  for (int i = 0; i < engine_num; i++) {
+    auto engine = CreateEngine(context, train_cfg);
+    if (engine == nullptr) {
+      MS_LOG(ERROR) << "create simulation engine " << i << " failed";
+      return RET_ERROR;
+    }
+    engines_.push_back(engine);
+  }
+
+  auto state = engines_.front()->GetTrainableStateTensors();
+  for (auto tensor : state) {
+    StateSlot slot = {tensor->tensor_name(), tensor->data_type(), tensor->shape(), state_size_, tensor->Size()};
+    slots_.push_back(slot);
+    state_size_ += tensor->Size();
+  }
+  for (auto engine : engines_) {
+    auto engine_state = engine->GetTrainableStateTensors();
+    if (engine_state.size() != slots_.size()) {
+      MS_LOG(ERROR) << "engines of the same model have different trainable state";
+      return RET_ERROR;
+    }
+    for (size_t i = 0; i < engine_state.size(); i++) {
+      if (engine_state[i]->tensor_name() != slots_[i].name_ || engine_state[i]->Size() != slots_[i].size_) {
+        MS_LOG(ERROR) << "trainable state mismatch at " << engine_state[i]->tensor_name();
+        return RET_ERROR;
+      }
+    }
+  }
+  init_state_.resize(state_size_);
+  for (size_t i = 0; i < state.size(); i++) {
+    if (state[i]->data() != nullptr) {
+      memcpy(init_state_.data() + slots_[i].offset_, state[i]->data(), slots_[i].size_);
+    }
+  }
+  return RET_OK;
+}
+
+int FLSimulation::AddClients(int client_num) {
+  if (engines_.empty()) {
+    MS_LOG(ERROR) << "simulation is not initialized";
+    return RET_ERROR;
+  }
+  if (client_num <= 0) {
+    MS_LOG(ERROR) << "invalid client number " << client_num;
+    return RET_PARAM_INVALID;
+  }
+  clients_.reserve(clients_.size() + client_num);
+  for (int i = 0; i < client_num; i++) {
+    clients_.push_back(init_state_);
+  }
+  return RET_OK;
+}
+
+int FLSimulation::LoadClientState(TrainSession *engine, int client_id) {
+  auto state = engine->GetTrainableStateTensors();
+  const auto &client = clients_.at(client_id);
+  for (size_t i = 0; i < state.size(); i++) {
+    auto data = state[i]->MutableData();
+    if (data == nullptr) {
+      MS_LOG(ERROR) << "state tensor " << state[i]->tensor_name() << " has no data";
+      return RET_ERROR;
+    }
+    memcpy(data, client.data() + slots_[i].offset_, slots_[i].size_);
+  }
+  return RET_OK;
+}
+
+int FLSimulation::SaveClientState(TrainSession *engine, int client_id) {
+  auto state = engine->GetTrainableStateTensors();
+  auto &client = clients_.at(client_id);
+  for (size_t i = 0; i < state.size(); i++) {
+    if (state[i]->data() == nullptr) {
+      MS_LOG(ERROR) << "state tensor " << state[i]->tensor_name() << " has no data";
+      return RET_ERROR;
+    }
+    memcpy(client.data() + slots_[i].offset_, state[i]->data(), slots_[i].size_);
+  }
+  return RET_OK;
+}
+
+int FLSimulation::RunEngine(size_t engine_idx, std::atomic<size_t> *next, const std::vector<int> &client_ids,
+                            const ClientFunc &func) {
+  auto engine = engines_.at(engine_idx);
+  for (size_t idx = next->fetch_add(1); idx < client_ids.size(); idx = next->fetch_add(1)) {
+    auto client_id = client_ids[idx];
+    auto ret = LoadClientState(engine, client_id);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "load state of client " << client_id << " failed";
+      return ret;
+    }
+    ret = engine->Train();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "client " << client_id << " failed to switch to train mode";
+      return ret;
+    }
+    ret = func(client_id, engine);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "client " << client_id << " failed: " << ret;
+      return ret;
+    }
+    // Eval flushes pending virtual batch / accumulated gradients into the weights
+    ret = engine->Eval();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "client " << client_id << " failed to switch to eval mode";
+      return ret;
+    }
+    ret = SaveClientState(engine, client_id);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "save state of client " << client_id << " failed";
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+int FLSimulation::RunClients(const std::vector<int> &client_ids, const ClientFunc &func) {
+  if (func == nullptr) {
+    MS_LOG(ERROR) << "client function cannot be nullptr";
+    return RET_NULL_PTR;
+  }
+  for (auto client_id : client_ids) {
+    if (!IsValidClient(client_id)) {
+      MS_LOG(ERROR) << "invalid client id " << client_id;
+      return RET_PARAM_INVALID;
+    }
+  }
+  // a client scheduled twice in one call would race with itself on two engines
+  std::vector<int> sorted_ids = client_ids;
+  std::sort(sorted_ids.begin(), sorted_ids.end());
+  if (std::adjacent_find(sorted_ids.begin(), sorted_ids.end()) != sorted_ids.end()) {
+    MS_LOG(ERROR) << "client ids must be unique";
+    return RET_PARAM_INVALID;
+  }
+
+  std::atomic<size_t> next(0);
+  size_t worker_num = std::min(engines_.size(), client_ids.size());
+  std::vector<int> results(worker_num, RET_OK);
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < worker_num; i++) {
+    workers.emplace_back([this, i, &next, &client_ids, &func, &results]() {
+      results[i] = RunEngine(i, &next, client_ids, func);
+    });
+  }
+  if (worker_num > 0) {
+    results[0] = RunEngine(0, &next, client_ids, func);
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  for (auto ret : results) {
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+std::vector<tensor::MSTensor *> FLSimulation::GetClientParams(int client_id) const {
+  std::vector<tensor::MSTensor *> params;
+  if (!IsValidClient(client_id)) {
+    MS_LOG(ERROR) << "invalid client id " << client_id;
+    return params;
+  }
+  auto &client = clients_.at(client_id);
+  for (auto &slot : slots_) {
+    auto tensor = new (std::nothrow) lite::Tensor(slot.data_type_, slot.shape_);
+    if (tensor == nullptr) {
+      MS_LOG(ERROR) << "failed to allocate param tensor";
+      for (auto param : params) {
+        delete param;
+      }
+      return {};
+    }
+    tensor->set_tensor_name(slot.name_);
+    tensor->set_data(const_cast<char *>(client.data() + slot.offset_));
+    tensor->set_own_data(false);
+    params.push_back(tensor);
+  }
+  return params;
+}
+
+int FLSimulation::SetClientParams(int client_id, const std::vector<tensor::MSTensor *> &params) {
+  if (!IsValidClient(client_id)) {
+    MS_LOG(ERROR) << "invalid client id " << client_id;
+    return RET_PARAM_INVALID;
+  }
+  auto &client = clients_.at(client_id);
+  for (auto param : params) {
+    if (param == nullptr || param->data() == nullptr) {
+      MS_LOG(ERROR) << "param tensor or its data is nullptr";
+      return RET_NULL_PTR;
+    }
+    auto it = std::find_if(slots_.begin(), slots_.end(),
+                           [param](const StateSlot &slot) { return slot.name_ == param->tensor_name(); });
+    if (it == slots_.end()) {
+      MS_LOG(ERROR) << "cannot find client param " << param->tensor_name();
+      return RET_ERROR;
+    }
+    if (it->size_ != param->Size()) {
+      MS_LOG(ERROR) << "param " << param->tensor_name() << " has wrong size " << param->Size() << " instead of "
+                    << it->size_;
+      return RET_ERROR;
+    }
+    memcpy(client.data() + it->offset_, param->data(), it->size_);
+  }
+  return RET_OK;
+}
+}  // namespace lite
+}  // namespace mindspore
@@ -0,0 +1,85 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_SRC_TRAIN_FL_SIMULATION_H_
+#define MINDSPORE_LITE_SRC_TRAIN_FL_SIMULATION_H_
+#include <vector>
+#include <atomic>
+#include <string>
+#include <memory>
+#include <functional>
+#include "include/context.h"
+#include "include/model.h"
+#include "include/train/train_cfg.h"
+#include "src/train/train_session.h"
+
+namespace mindspore {
+namespace lite {
+/*
+  Federated learning simulation.
+
+  The model flatbuffer is imported once and compiled into a small number of TrainSession "engines" (one per worker
+  thread). All engines share the model buffer, so frozen const weights are never duplicated. A simulated client owns
+  only the tensors training writes to (parameters, optimizer state and batchnorm statistics), which are swapped into
+  an idle engine before the client runs and swapped out afterwards.
+*/
+class FLSimulation {
+ public:
+  using ClientFunc = std::function<int(int client_id, session::LiteSession *session)>;
+
+  FLSimulation() = default;
+  ~FLSimulation();
+
+  int Init(const std::string &model_file, const Context *context, const TrainCfg *train_cfg, int engine_num);
+  int AddClients(int client_num);
+  // run func for each client; clients are spread over the engines, which run concurrently
+  int RunClients(const std::vector<int> &client_ids, const ClientFunc &func);
+
+  // tensors returned by GetClientParams view the client state, they do not own data and must be deleted by caller
+  std::vector<tensor::MSTensor *> GetClientParams(int client_id) const;
+  int SetClientParams(int client_id, const std::vector<tensor::MSTensor *> &params);
+
+  size_t client_num() const { return clients_.size(); }
+  size_t client_state_size() const { return state_size_; }
+
+ private:
+  struct StateSlot {
+    std::string name_;
+    TypeId data_type_;
+    std::vector<int> shape_;
+    size_t offset_;
+    size_t size_;
+  };
+
+  int InitEngines(const Context *context, const TrainCfg *train_cfg, int engine_num);
+  void Clear();
+  TrainSession *CreateEngine(const Context *context, const TrainCfg *train_cfg);
+  int PrivatizeState(TrainSession *engine);
+  int LoadClientState(TrainSession *engine, int client_id);
+  int SaveClientState(TrainSession *engine, int client_id);
+  int RunEngine(size_t engine_idx, std::atomic<size_t> *next, const std::vector<int> &client_ids,
+                const ClientFunc &func);
+  bool IsValidClient(int client_id) const { return client_id >= 0 && static_cast<size_t>(client_id) < clients_.size(); }
+
+  std::shared_ptr<Model> model_ = nullptr;
+  std::vector<TrainSession *> engines_;
+  std::vector<StateSlot> slots_;
+  size_t state_size_ = 0;
+  std::vector<char> init_state_;
+  std::vector<std::vector<char>> clients_;
+};
+}  // namespace lite
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_SRC_TRAIN_FL_SIMULATION_H_
@@ -0,0 +1,186 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/train/fused_optimizer.h"
+#include "include/errorcode.h"
+#include "schema/model_generated.h"
+#include "src/common/log_adapter.h"
+
+namespace mindspore {
+namespace lite {
+namespace {
+// below this many elements per thread the parallel launch costs more than it saves
+constexpr size_t kMinFusedElementsPerThread = 4096;
+
+int FusedOptimizerRun(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  auto fused = reinterpret_cast<FusedOptimizer *>(cdata);
+  return fused->Execute(task_id);
+}
+}  // namespace
+
+int FusedOptimizer::Init(const std::vector<kernel::LiteKernel *> &optimizers, const InnerContext *context) {
+  if (optimizers.empty() || context == nullptr) {
+    return RET_NOT_SUPPORT;
+  }
+  kernels_.clear();
+  optimizers_.clear();
+  for (auto kernel : optimizers) {
+    auto desc = kernel->desc();
+    if (desc.arch != kernel::kCPU || desc.provider != kernel::kBuiltin || desc.data_type != kNumberTypeFloat32 ||
+        (kernel->type() != schema::PrimitiveType_Adam && kernel->type() != schema::PrimitiveType_SGD)) {
+      MS_LOG(INFO) << kernel->name() << " can not be fused, optimizer kernels run one by one";
+      kernels_.clear();
+      optimizers_.clear();
+      return RET_NOT_SUPPORT;
+    }
+    kernels_.push_back(kernel);
+    optimizers_.push_back(static_cast<kernel::OptimizerKernel *>(kernel->kernel()));
+  }
+  context_ = context;
+  segments_.resize(optimizers_.size());
+  auto ret = CollectSegments();
+  if (ret != RET_OK) {
+    kernels_.clear();
+    optimizers_.clear();
+    return RET_NOT_SUPPORT;
+  }
+  return RET_OK;
+}
+
+bool FusedOptimizer::IsUniformMode() const {
+  auto mode = optimizers_.front()->get_optimizer_mode();
+  for (auto optimizer : optimizers_) {
+    if (optimizer->get_optimizer_mode() != mode) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// learning rate, bias correction and tensor data may change between steps, so segments are refreshed every time
+int FusedOptimizer::CollectSegments() {
+  total_length_ = 0;
+  for (size_t i = 0; i < optimizers_.size(); i++) {
+    auto ret = optimizers_[i]->GetFusedSegment(&segments_[i]);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "optimizer " << i << " failed to get fused segment";
+      return ret;
+    }
+    total_length_ += segments_[i].length_;
+  }
+  auto max_threads = static_cast<int>(UP_DIV(total_length_, kMinFusedElementsPerThread));
+  thread_num_ = MSMAX(1, MSMIN(context_->thread_num_, max_threads));
+  return RET_OK;
+}
+
+int FusedOptimizer::Execute(int task_id) {
+  size_t stride = UP_DIV(total_length_, static_cast<size_t>(thread_num_));
+  size_t start = stride * task_id;
+  if (start >= total_length_) {
+    return RET_OK;
+  }
+  size_t end = MSMIN(start + stride, total_length_);
+  if (accumulate_) {
+    FusedAccumulateGradFp32(segments_.data(), segments_.size(), start, end);
+  } else {
+    FusedOptimizerStepFp32(segments_.data(), segments_.size(), start, end);
+  }
+  return RET_OK;
+}
+
+int FusedOptimizer::PreProcess(const KernelCallBack &before) {
+  for (auto kernel : kernels_) {
+    if (before != nullptr) {
+      if (!before(TensorVectorCast(kernel->in_tensors()), TensorVectorCast(kernel->out_tensors()),
+                  {kernel->name(), schema::EnumNamePrimitiveType(kernel->type())})) {
+        MS_LOG(WARNING) << "run kernel before_callback failed, name: " << kernel->name();
+      }
+    }
+    auto ret = kernel->kernel()->PreProcess();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "PreProcess of kernel " << kernel->name() << " failed, error_code[" << ret << "]";
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+int FusedOptimizer::PostProcess(const KernelCallBack &after) {
+  for (auto kernel : kernels_) {
+    auto ret = kernel->kernel()->PostProcess();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "PostProcess of kernel " << kernel->name() << " failed, error_code[" << ret << "]";
+      return ret;
+    }
+    if (after != nullptr) {
+      if (!after(TensorVectorCast(kernel->in_tensors()), TensorVectorCast(kernel->out_tensors()),
+                 {kernel->name(), schema::EnumNamePrimitiveType(kernel->type())})) {
+        MS_LOG(WARNING) << "run kernel after_callback failed, name: " << kernel->name();
+      }
+    }
+  }
+  return RET_OK;
+}
+
+int FusedOptimizer::Launch(bool accumulate, const KernelCallBack &before, const KernelCallBack &after) {
+  auto ret = PreProcess(before);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  ret = CollectSegments();
+  if (ret != RET_OK) {
+    return ret;
+  }
+  if (accumulate) {
+    for (auto &segment : segments_) {
+      if (segment.grad_sum_ == nullptr) {
+        MS_LOG(ERROR) << "gradient sum is not allocated, optimizer is not in accumulation mode";
+        return RET_ERROR;
+      }
+    }
+  }
+  accumulate_ = accumulate;
+  ret = ParallelLaunch(context_, FusedOptimizerRun, this, thread_num_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "fused optimizer launch failed, error_code[" << ret << "]";
+    return RET_ERROR;
+  }
+  return PostProcess(after);
+}
+
+int FusedOptimizer::Accumulate(const KernelCallBack &before, const KernelCallBack &after) {
+  auto ret = Launch(true, before, after);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  for (auto optimizer : optimizers_) {
+    optimizer->set_grad_sum_valid();
+  }
+  return RET_OK;
+}
+
+int FusedOptimizer::Step(const KernelCallBack &before, const KernelCallBack &after) {
+  auto ret = Launch(false, before, after);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  // gradient sums were consumed and cleared by the fused step
+  for (auto optimizer : optimizers_) {
+    optimizer->clear_grad_sum_valid();
+  }
+  return RET_OK;
+}
+}  // namespace lite
+}  // namespace mindspore
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_SRC_TRAIN_FUSED_OPTIMIZER_H_
+#define MINDSPORE_LITE_SRC_TRAIN_FUSED_OPTIMIZER_H_
+#include <vector>
+#include "src/lite_kernel.h"
+#include "src/inner_context.h"
+#include "src/train/optimizer_kernel.h"
+#include "nnacl/fp32_grad/fused_optimizer.h"
+
+namespace mindspore {
+namespace lite {
+// Runs the weight update of all optimizer kernels of a train graph as one multi-threaded pass, instead of
+// launching one optimizer kernel per parameter. Virtual batch accumulation runs fused as well.
+class FusedOptimizer {
+ public:
+  FusedOptimizer() = default;
+  ~FusedOptimizer() = default;
+
+  // returns RET_NOT_SUPPORT if any of the optimizers can not be fused
+  int Init(const std::vector<kernel::LiteKernel *> &optimizers, const InnerContext *context);
+  // all optimizers must be in the same weight update mode to run fused
+  bool IsUniformMode() const;
+  kernel::WeightUpdateMode mode() const { return optimizers_.front()->get_optimizer_mode(); }
+  // add current gradients into the gradient sums
+  int Accumulate(const KernelCallBack &before, const KernelCallBack &after);
+  // update weights using gradient sums plus current gradients
+  int Step(const KernelCallBack &before, const KernelCallBack &after);
+  int Execute(int task_id);
+
+ private:
+  int CollectSegments();
+  int Launch(bool accumulate, const KernelCallBack &before, const KernelCallBack &after);
+  // the callbacks and the pre/post processing of every fused optimizer kernel, same as running it by itself
+  int PreProcess(const KernelCallBack &before);
+  int PostProcess(const KernelCallBack &after);
+
+  std::vector<kernel::LiteKernel *> kernels_;
+  std::vector<kernel::OptimizerKernel *> optimizers_;
+  std::vector<FusedOptimizerSegment> segments_;
+  size_t total_length_ = 0;
+  bool accumulate_ = false;
+  const InnerContext *context_ = nullptr;
+  int thread_num_ = 1;
+};
+}  // namespace lite
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_SRC_TRAIN_FUSED_OPTIMIZER_H_
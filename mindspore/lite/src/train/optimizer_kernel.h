@@ -24,7 +24,9 @@
 #include "src/lite_kernel.h"
 #include "include/ms_tensor.h"
 #include "include/errorcode.h"
+#include "nnacl/fp32_grad/fused_optimizer.h"
 using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_NOT_SUPPORT;
 using mindspore::lite::RET_OK;
 using mindspore::lite::RET_OUT_OF_TENSOR_RANGE;
 
@@ -208,6 +210,10 @@ class OptimizerKernel : public InnerKernel {
     valid_grad_sum_ = true;
     return RET_OK;
   }
+  void clear_grad_sum_valid() { valid_grad_sum_ = false; }
+
+  // Describe the update of this kernel as one segment of a multi-tensor optimizer step
+  virtual int GetFusedSegment(FusedOptimizerSegment *segment) { return RET_NOT_SUPPORT; }
 
  protected:
   float default_lr_ = 0.0f;
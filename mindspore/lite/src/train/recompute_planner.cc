@@ -0,0 +1,186 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/train/recompute_planner.h"
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include "include/errorcode.h"
+#include "src/common/log_adapter.h"
+
+namespace mindspore {
+namespace lite {
+RecomputePlanner::RecomputePlanner(const std::vector<kernel::LiteKernel *> &kernels,
+                                   const std::vector<kernel::LiteKernel *> &forward_kernels, PeakFunc peak_func,
+                                   KernelFilter can_recompute)
+    : kernels_(kernels),
+      forward_(forward_kernels.begin(), forward_kernels.end()),
+      peak_func_(std::move(peak_func)),
+      can_recompute_(std::move(can_recompute)) {}
+
+uint64_t RecomputePlanner::KernelFlops(const kernel::LiteKernel *kernel) {
+  uint64_t out_elements = 0;
+  for (auto tensor : kernel->out_tensors()) {
+    out_elements += static_cast<uint64_t>(std::max<int64_t>(tensor->ElementsNum(), 0));
+  }
+  auto &in_tensors = kernel->in_tensors();
+  auto out = kernel->out_tensors().front();
+  switch (kernel->type()) {
+    case schema::PrimitiveType_Conv2DFusion: {
+      // weight is [out_c, kh, kw, in_c / group], one multiply-add per weight element of the output channel
+      if (in_tensors.size() < 2 || in_tensors.at(1)->shape().empty() || in_tensors.at(1)->shape().front() <= 0) {
+        return out_elements;
+      }
+      auto weight = in_tensors.at(1);
+      uint64_t per_output = static_cast<uint64_t>(weight->ElementsNum() / weight->shape().front());
+      return 2 * out_elements * per_output;
+    }
+    case schema::PrimitiveType_MatMulFusion:
+    case schema::PrimitiveType_FullConnection: {
+      // input is [..., M, K] and output [..., M, N] whatever the transposes, so K = input / (output / N)
+      if (out->shape().empty() || out->shape().back() <= 0 || out->ElementsNum() <= 0) {
+        return out_elements;
+      }
+      uint64_t rows = static_cast<uint64_t>(out->ElementsNum() / out->shape().back());
+      uint64_t depth = static_cast<uint64_t>(in_tensors.front()->ElementsNum()) / std::max<uint64_t>(rows, 1);
+      return 2 * out_elements * depth;
+    }
+    default:
+      return out_elements;
+  }
+}
+
+std::vector<RecomputePlanner::Candidate> RecomputePlanner::CollectCandidates() const {
+  std::unordered_map<lite::Tensor *, std::vector<size_t>> consumers;
+  for (size_t i = 0; i < kernels_.size(); i++) {
+    for (auto tensor : kernels_[i]->in_tensors()) {
+      auto &positions = consumers[tensor];
+      if (positions.empty() || positions.back() != i) {
+        positions.push_back(i);
+      }
+    }
+  }
+  std::vector<Candidate> candidates;
+  for (auto kernel : kernels_) {
+    if (forward_.find(kernel) == forward_.end() || kernel->out_tensors().size() != 1 || !can_recompute_(kernel)) {
+      continue;
+    }
+    auto tensor = kernel->out_tensors().front();
+    if (tensor->category() != lite::Category::VAR || resident_.find(tensor) != resident_.end()) {
+      continue;
+    }
+    // the activation must have forward uses, after which it is dropped, and backward uses, before which it returns
+    size_t forward_uses = 0;
+    size_t backward_uses = 0;
+    bool ordered = true;
+    for (auto position : consumers[tensor]) {
+      if (forward_.find(kernels_[position]) != forward_.end()) {
+        ordered = ordered && (backward_uses == 0);
+        forward_uses++;
+      } else {
+        backward_uses++;
+      }
+    }
+    if (forward_uses == 0 || backward_uses == 0 || !ordered) {
+      continue;
+    }
+    auto flops = KernelFlops(kernel);
+    auto score = static_cast<double>(tensor->Size()) / static_cast<double>(flops + 1);
+    candidates.push_back({tensor, kernel, flops, score});
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Candidate &a, const Candidate &b) { return a.score_ > b.score_; });
+  return candidates;
+}
+
+std::vector<kernel::LiteKernel *> RecomputePlanner::BuildSchedule(
+  const std::unordered_set<lite::Tensor *> &dropped) const {
+  std::unordered_map<lite::Tensor *, kernel::LiteKernel *> producers;
+  for (auto kernel : kernels_) {
+    for (auto tensor : kernel->out_tensors()) {
+      if (dropped.find(tensor) != dropped.end()) {
+        producers[tensor] = kernel;
+      }
+    }
+  }
+  std::vector<kernel::LiteKernel *> schedule;
+  std::unordered_set<lite::Tensor *> recomputed;
+  for (auto kernel : kernels_) {
+    if (forward_.find(kernel) == forward_.end()) {
+      for (auto tensor : kernel->in_tensors()) {
+        auto it = producers.find(tensor);
+        if (it != producers.end() && recomputed.insert(tensor).second) {
+          schedule.push_back(it->second);
+        }
+      }
+    }
+    schedule.push_back(kernel);
+  }
+  return schedule;
+}
+
+int RecomputePlanner::Plan(size_t memory_budget, RecomputePlan *plan) {
+  if (plan == nullptr) {
+    MS_LOG(ERROR) << "plan cannot be nullptr";
+    return RET_NULL_PTR;
+  }
+  plan->schedule_ = kernels_;
+  plan->dropped_.clear();
+  plan->baseline_peak_ = peak_func_(kernels_);
+  plan->peak_ = plan->baseline_peak_;
+  plan->flops_ = 0;
+  plan->extra_flops_ = 0;
+  for (auto kernel : kernels_) {
+    plan->flops_ += KernelFlops(kernel);
+  }
+  if (plan->peak_ <= memory_budget) {
+    return RET_OK;
+  }
+
+  std::unordered_set<lite::Tensor *> dropped;
+  // inputs of recomputed kernels stay resident until the recomputation, so they can not be dropped themselves
+  std::unordered_set<lite::Tensor *> pinned;
+  for (auto &candidate : CollectCandidates()) {
+    if (pinned.find(candidate.tensor_) != pinned.end()) {
+      continue;
+    }
+    auto &inputs = candidate.producer_->in_tensors();
+    if (std::any_of(inputs.begin(), inputs.end(),
+                    [&dropped](lite::Tensor *tensor) { return dropped.find(tensor) != dropped.end(); })) {
+      continue;
+    }
+    dropped.insert(candidate.tensor_);
+    auto schedule = BuildSchedule(dropped);
+    auto peak = peak_func_(schedule);
+    if (peak >= plan->peak_) {
+      dropped.erase(candidate.tensor_);
+      continue;
+    }
+    pinned.insert(inputs.begin(), inputs.end());
+    plan->schedule_ = std::move(schedule);
+    plan->dropped_.push_back(candidate.tensor_);
+    plan->peak_ = peak;
+    plan->extra_flops_ += candidate.flops_;
+    if (peak <= memory_budget) {
+      break;
+    }
+  }
+  if (plan->peak_ > memory_budget) {
+    MS_LOG(WARNING) << "recomputation reaches " << plan->peak_ << " bytes, above the budget of " << memory_budget;
+  }
+  return RET_OK;
+}
+}  // namespace lite
+}  // namespace mindspore
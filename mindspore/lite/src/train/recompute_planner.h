@@ -0,0 +1,74 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_SRC_TRAIN_RECOMPUTE_PLANNER_H_
+#define MINDSPORE_LITE_SRC_TRAIN_RECOMPUTE_PLANNER_H_
+#include <functional>
+#include <unordered_set>
+#include <vector>
+#include "src/lite_kernel.h"
+
+namespace mindspore {
+namespace lite {
+struct RecomputePlan {
+  // train kernels in run order, the producer of every dropped activation runs again before its first backward use
+  std::vector<kernel::LiteKernel *> schedule_;
+  std::vector<lite::Tensor *> dropped_;
+  size_t baseline_peak_ = 0;
+  size_t peak_ = 0;
+  uint64_t flops_ = 0;
+  uint64_t extra_flops_ = 0;
+};
+
+// Chooses forward activations to drop after their last forward use and recompute during backward, so that the
+// static arena fits a memory budget. Activations are picked greedily by bytes saved per recomputed FLOP and a pick is
+// kept only if the simulated arena peak goes down.
+class RecomputePlanner {
+ public:
+  // arena size needed to run a schedule
+  using PeakFunc = std::function<size_t(const std::vector<kernel::LiteKernel *> &schedule)>;
+  // kernels that may run twice, e.g. not in place, no random or running statistics state
+  using KernelFilter = std::function<bool(kernel::LiteKernel *kernel)>;
+
+  RecomputePlanner(const std::vector<kernel::LiteKernel *> &kernels,
+                   const std::vector<kernel::LiteKernel *> &forward_kernels, PeakFunc peak_func,
+                   KernelFilter can_recompute);
+  ~RecomputePlanner() = default;
+
+  // tensors that must keep their single location, e.g. session outputs
+  void set_resident(const std::unordered_set<lite::Tensor *> &resident) { resident_ = resident; }
+  // on return plan is valid also when the budget could not be met
+  int Plan(size_t memory_budget, RecomputePlan *plan);
+  std::vector<kernel::LiteKernel *> BuildSchedule(const std::unordered_set<lite::Tensor *> &dropped) const;
+  static uint64_t KernelFlops(const kernel::LiteKernel *kernel);
+
+ private:
+  struct Candidate {
+    lite::Tensor *tensor_;
+    kernel::LiteKernel *producer_;
+    uint64_t flops_;
+    double score_;
+  };
+  std::vector<Candidate> CollectCandidates() const;
+
+  std::vector<kernel::LiteKernel *> kernels_;
+  std::unordered_set<kernel::LiteKernel *> forward_;
+  std::unordered_set<lite::Tensor *> resident_;
+  PeakFunc peak_func_;
+  KernelFilter can_recompute_;
+};
+}  // namespace lite
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_SRC_TRAIN_RECOMPUTE_PLANNER_H_
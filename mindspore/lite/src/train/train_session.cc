@@ -25,6 +25,7 @@
 #include <queue>
 #include <map>
 #include <set>
+#include <unordered_set>
 #include "include/errorcode.h"
 #include "src/lite_model.h"
 #include "src/lite_kernel_util.h"
@@ -248,18 +249,65 @@ int TrainSession::UpdateWeights(std::vector<tensor::MSTensor *> modify_tensors)
   }
   if (is_eval) {
     ret = Eval();
+    if (ret != RET_OK) {
+      return ret;
+    }
   }
-  return ret;
+  return RefreshWeightsSnapshot();
 }
 
-int TrainSession::AllocTensors(const std::vector<kernel::LiteKernel *> &kernels) {
-  if (!IS_STATIC_ALLOCATOR(allocator_)) return RET_OK;
+size_t TrainSession::PlanTensors(const std::vector<kernel::LiteKernel *> &schedule,
+                                 std::unordered_map<lite::Tensor *, size_t> *offset_map,
+                                 std::vector<std::vector<size_t>> *step_offsets) {
   OptAllocator allocator;
   std::unordered_map<lite::Tensor *, int> ref_count;
-  std::unordered_map<lite::Tensor *, size_t> offset_map;
+  // A kernel that appears more than once (recomputation) uses its inputs once more per extra appearance, and each
+  // appearance of its outputs serves only the consumers scheduled before the next appearance
+  std::unordered_map<kernel::LiteKernel *, int> appearances;
+  for (auto kernel : schedule) {
+    appearances[kernel]++;
+  }
+  std::unordered_map<lite::Tensor *, int> extra_uses;
+  std::unordered_map<lite::Tensor *, std::vector<int>> appearance_uses;
+  for (auto &item : appearances) {
+    if (item.second < 2) {
+      continue;
+    }
+    for (auto tensor : item.first->in_tensors()) {
+      extra_uses[tensor] += item.second - 1;
+    }
+    for (auto tensor : item.first->out_tensors()) {
+      appearance_uses[tensor].assign(item.second, 0);
+    }
+  }
+  if (!appearance_uses.empty()) {
+    std::unordered_map<lite::Tensor *, int> produced;
+    for (auto kernel : schedule) {
+      for (auto tensor : kernel->in_tensors()) {
+        auto it = appearance_uses.find(tensor);
+        if (it != appearance_uses.end() && produced[tensor] > 0) {
+          it->second.at(produced[tensor] - 1)++;
+        }
+      }
+      for (auto tensor : kernel->out_tensors()) {
+        if (appearance_uses.find(tensor) != appearance_uses.end()) {
+          produced[tensor]++;
+        }
+      }
+    }
+  }
+  std::unordered_map<lite::Tensor *, int> appearance_idx;
+  std::unordered_map<lite::Tensor *, size_t> local_offset_map;
+  if (offset_map == nullptr) {
+    offset_map = &local_offset_map;
+  }
+  if (step_offsets != nullptr) {
+    step_offsets->clear();
+  }
   int counter = 0;
   uint32_t input_idx = 0;
-  for (auto &kernel : kernels) {
+  for (auto &kernel : schedule) {
+    std::vector<size_t> offsets;
     for (size_t i = 0; i < kernel->out_tensors().size(); i++) {
       auto tensor = kernel->out_tensors().at(i);
       bool in_place = false;
@@ -269,26 +317,54 @@ int TrainSession::AllocTensors(const std::vector<kernel::LiteKernel *> &kernels)
       counter++;
       size_t offset;
       if (in_place) {
-        offset = GetInplaceTensorOffset(kernel, offset_map, &ref_count, input_idx);
+        offset = GetInplaceTensorOffset(kernel, *offset_map, &ref_count, input_idx);
       } else {
         size_t size = tensor->Size();
         offset = allocator.Malloc(size);
       }
-      offset_map[tensor] = offset;
-      ref_count[tensor] = tensor->init_ref_count();
+      (*offset_map)[tensor] = offset;
+      offsets.push_back(offset);
+      auto uses = appearance_uses.find(tensor);
+      if (uses == appearance_uses.end()) {
+        ref_count[tensor] = tensor->init_ref_count() + extra_uses[tensor];
+      } else {
+        auto idx = appearance_idx[tensor]++;
+        if (idx + 1 < static_cast<int>(uses->second.size())) {
+          ref_count[tensor] = uses->second.at(idx);
+        } else {
+          // the last appearance keeps whatever the earlier ones did not use, e.g. output references
+          int used = 0;
+          for (int k = 0; k < idx; k++) {
+            used += uses->second.at(k);
+          }
+          ref_count[tensor] = tensor->init_ref_count() - used;
+        }
+      }
     }
     for (auto tensor : kernel->in_tensors()) {
       if (tensor->category() == lite::Category::VAR) {
         int count = ref_count[tensor] - 1;
         ref_count[tensor] = count;
         if (count == 0) {
-          allocator.Free(offset_map[tensor]);
+          allocator.Free((*offset_map)[tensor]);
         }
       }
     }
+    if (step_offsets != nullptr) {
+      step_offsets->push_back(std::move(offsets));
+    }
   }
-  // Set Tensor data
-  auto size = allocator.total_size();
+  return allocator.total_size();
+}
+
+int TrainSession::AllocTensors(const std::vector<kernel::LiteKernel *> &kernels) {
+  if (!IS_STATIC_ALLOCATOR(allocator_)) return RET_OK;
+  std::unordered_map<lite::Tensor *, size_t> offset_map;
+  auto size = PlanTensors(kernels, &offset_map, nullptr);
+  return SetTensorsData(size, offset_map);
+}
+
+int TrainSession::SetTensorsData(size_t size, const std::unordered_map<lite::Tensor *, size_t> &offset_map) {
   if (size > tensors_data_size_) {
     free(tensors_data_);
     tensors_data_ = nullptr;
@@ -315,6 +391,73 @@ int TrainSession::AllocTensors(const std::vector<kernel::LiteKernel *> &kernels)
   return RET_OK;
 }
 
+bool TrainSession::CanRecompute(kernel::LiteKernel *kernel) {
+  // running twice must give the same result and leave no other trace
+  return !IsInPlaceKernel(kernel) && !IsBN(kernel) && !IsLossKernel(kernel) &&
+         kernel->type() != schema::PrimitiveType_Dropout;
+}
+
+int TrainSession::PlanRecompute() {
+  ResetRecomputePlan();
+  RecomputePlanner planner(
+    train_kernels_, inference_kernels_,
+    [this](const std::vector<kernel::LiteKernel *> &schedule) { return PlanTensors(schedule, nullptr, nullptr); },
+    [this](kernel::LiteKernel *kernel) { return CanRecompute(kernel); });
+  std::unordered_set<lite::Tensor *> resident;
+  for (auto &item : train_output_tensor_map_) {
+    resident.insert(static_cast<lite::Tensor *>(item.second));
+  }
+  for (auto &item : eval_output_tensor_map_) {
+    resident.insert(static_cast<lite::Tensor *>(item.second));
+  }
+  planner.set_resident(resident);
+  auto ret = planner.Plan(cfg_.recompute_memory_budget_, &recompute_plan_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "failed to plan activation recomputation";
+    return ret;
+  }
+  MS_LOG(INFO) << "recompute " << recompute_plan_.dropped_.size() << " activations, arena " << recompute_plan_.peak_
+               << " bytes (without recompute " << recompute_plan_.baseline_peak_ << "), extra FLOPs "
+               << recompute_plan_.extra_flops_ << " of " << recompute_plan_.flops_;
+  if (!recompute_plan_.dropped_.empty()) {
+    recompute_arena_size_ = PlanTensors(recompute_plan_.schedule_, &recompute_offset_map_, &recompute_offsets_);
+  }
+  recompute_planned_budget_ = cfg_.recompute_memory_budget_;
+  return RET_OK;
+}
+
+int TrainSession::AllocTrainTensors() {
+  if (!IS_STATIC_ALLOCATOR(allocator_) || cfg_.recompute_memory_budget_ == 0) {
+    ResetRecomputePlan();
+    return AllocTensors(train_kernels_);
+  }
+  // mix precision swaps tensor data around kernels, which does not mix with moving activations
+  if (context_->IsCpuFloat16Enabled()) {
+    MS_LOG(WARNING) << "activation recomputation is not supported with float16, ignoring the memory budget";
+    ResetRecomputePlan();
+    return AllocTensors(train_kernels_);
+  }
+  // the plan depends only on the graph, the shapes and the budget, so switching between train and eval reuses it
+  if (recompute_planned_budget_ != cfg_.recompute_memory_budget_) {
+    auto ret = PlanRecompute();
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+  if (recompute_plan_.dropped_.empty()) {
+    return AllocTensors(train_kernels_);
+  }
+  return SetTensorsData(recompute_arena_size_, recompute_offset_map_);
+}
+
+void TrainSession::ResetRecomputePlan() {
+  recompute_plan_ = RecomputePlan();
+  recompute_offsets_.clear();
+  recompute_offset_map_.clear();
+  recompute_arena_size_ = 0;
+  recompute_planned_budget_ = 0;
+}
+
 int TrainSession::CompileGraph(lite::Model *model) { return lite::RET_ERROR; }
 
 int TrainSession::CompileTrainGraph(std::shared_ptr<Model> model) {
@@ -349,6 +492,7 @@ int TrainSession::CompileTrainGraph(std::shared_ptr<Model> model) {
   CompileOptimizedKernels();  // Prepare a list of kernels which are optimized (weight update step)
   CompileTrainOutputs();      // prepare outputs in train mode
   CompileEvalOutputs();       // prepare outputs in eval mode
+  CompileFusedOptimizer();    // weight update of all optimizers in one pass when possible
   // Prepare a list of eval kernels
   if (CompileInferenceKernels() != RET_OK) {
     MS_LOG(ERROR) << "CompileInferenceKernels failed.";
@@ -359,7 +503,7 @@ int TrainSession::CompileTrainGraph(std::shared_ptr<Model> model) {
     MS_LOG(ERROR) << "failed to allocate space";
     return RET_ERROR;
   }
-  ret = AllocTensors(train_kernels_);
+  ret = AllocTrainTensors();
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "failed to allocate space";
     return RET_ERROR;
@@ -388,6 +532,45 @@ int TrainSession::ExecKernels(const KernelCallBack &before, const KernelCallBack
   return RET_OK;
 }
 
+int TrainSession::RecomputeExecKernels(const KernelCallBack &before, const KernelCallBack &after,
+                                       bool skip_optimizers) {
+  auto &schedule = recompute_plan_.schedule_;
+  for (size_t i = 0; i < schedule.size(); i++) {
+    auto kernel = schedule[i];
+    MS_ASSERT(kernel != nullptr);
+    if (skip_optimizers && IsOptimizer(kernel)) {
+      continue;
+    }
+    // a recomputed activation lives at a different arena offset in each of its appearances
+    auto &offsets = recompute_offsets_.at(i);
+    for (size_t j = 0; j < offsets.size(); j++) {
+      kernel->out_tensors().at(j)->set_data(reinterpret_cast<char *>(tensors_data_) + offsets[j]);
+    }
+    auto ret = kernel->Execute(before, after);
+    if (RET_OK != ret) {
+      MS_LOG(ERROR) << "Execute kernel failed, name: " << kernel->name();
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
+int TrainSession::FusedOptimizerExecKernels(const KernelCallBack &before, const KernelCallBack &after) {
+  bool recompute = !recompute_offsets_.empty();
+  if (!fused_optimizer_->IsUniformMode()) {
+    return recompute ? RecomputeExecKernels(before, after, false) : ExecKernels(before, after, train_kernels_);
+  }
+  auto ret = recompute ? RecomputeExecKernels(before, after, true) : ExecKernels(before, after, fused_run_kernels_);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  // in virtual batch mode the gradients are only accumulated, OptimizerStep applies them at the end of the batch
+  if (fused_optimizer_->mode() == kernel::WeightUpdateMode::NORMAL) {
+    return fused_optimizer_->Step(before, after);
+  }
+  return fused_optimizer_->Accumulate(before, after);
+}
+
 void TrainSession::RestoreTensorData() {
   for (auto &restored_origin_tensor : restored_origin_tensors_) {
     auto *origin_tensor = restored_origin_tensor.first;
@@ -559,6 +742,10 @@ int TrainSession::RunGraph(const KernelCallBack &before, const KernelCallBack &a
   auto &run_kernels = (train_mode_) ? train_kernels_ : inference_kernels_;
   if (context_->IsCpuFloat16Enabled()) {
     ret = MixPrecisionExecKernels(before, after, run_kernels);
+  } else if (train_mode_ && fused_optimizer_ != nullptr) {
+    ret = FusedOptimizerExecKernels(before, after);
+  } else if (train_mode_ && !recompute_offsets_.empty()) {
+    ret = RecomputeExecKernels(before, after, false);
   } else {
     ret = ExecKernels(before, after, run_kernels);
   }
@@ -605,7 +792,7 @@ int TrainSession::Train() {
     }
   }
   // allocate tensors
-  auto ret = AllocTensors(train_kernels_);
+  auto ret = AllocTrainTensors();
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "failed to allocate tensor space";
     return RET_ERROR;
@@ -775,6 +962,29 @@ void TrainSession::CompileOptimizedKernels() {
   }
 }
 
+void TrainSession::CompileFusedOptimizer() {
+  fused_optimizer_ = nullptr;
+  fused_run_kernels_.clear();
+  // mix precision needs the per kernel nan check and loss scale handling of OptimizerKernel::PreProcess
+  if (context_->IsCpuFloat16Enabled()) {
+    return;
+  }
+  std::vector<kernel::LiteKernel *> optimizers;
+  for (auto kernel : this->train_kernels_) {
+    if (IsOptimizer(kernel)) {
+      optimizers.push_back(kernel);
+    } else {
+      fused_run_kernels_.push_back(kernel);
+    }
+  }
+  auto fused = std::make_unique<FusedOptimizer>();
+  if (fused->Init(optimizers, context_) != RET_OK) {
+    fused_run_kernels_.clear();
+    return;
+  }
+  fused_optimizer_ = std::move(fused);
+}
+
 int TrainSession::SetLearningRate(float learning_rate) {
   if (learning_rate < 0.0f) {
     MS_LOG(ERROR) << "learning rate should more than 0";
@@ -1017,6 +1227,8 @@ int TrainSession::Resize(const std::vector<tensor::MSTensor *> &inputs, const st
     free(tensors_data_);
     tensors_data_ = nullptr;
   }
+  // the activation sizes change with the input shapes, so the recompute plan is made again
+  ResetRecomputePlan();
   auto ret = lite::LiteSession::Resize(inputs, dims);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "train resize input failed.";
@@ -1027,7 +1239,7 @@ int TrainSession::Resize(const std::vector<tensor::MSTensor *> &inputs, const st
     MS_LOG(ERROR) << "failed to allocate space";
     return RET_ERROR;
   }
-  ret = AllocTensors(train_kernels_);
+  ret = AllocTrainTensors();
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "train alloc failed after resize.";
     return RET_ERROR;
@@ -1165,6 +1377,21 @@ std::vector<tensor::MSTensor *> TrainSession::GetFeatureMaps() const {
   return features;
 }
 
+std::vector<lite::Tensor *> TrainSession::GetTrainableStateTensors() const {
+  std::vector<lite::Tensor *> state;
+  for (auto kernel : this->train_kernels_) {
+    if (!IsOptimizer(kernel) && !IsBN(kernel)) {
+      continue;
+    }
+    for (auto tensor : kernel->in_tensors()) {
+      if (tensor->IsConst() && !IsContain(state, tensor)) {
+        state.push_back(tensor);
+      }
+    }
+  }
+  return state;
+}
+
 int TrainSession::UpdateFeatureMaps(const std::vector<tensor::MSTensor *> &features_map) {
   for (auto feature : features_map) {
     bool find = false;
@@ -1188,7 +1415,42 @@ int TrainSession::UpdateFeatureMaps(const std::vector<tensor::MSTensor *> &featu
       return RET_ERROR;
     }
   }
-  return RET_OK;
+  return RefreshWeightsSnapshot();
+}
+
+std::vector<lite::Tensor *> TrainSession::GetTrainableWeights() const {
+  std::vector<lite::Tensor *> weights;
+  for (auto kernel : this->train_kernels_) {
+    if (!IsOptimizer(kernel)) {
+      continue;
+    }
+    auto weight = kernel->in_tensors().at(0);
+    if (weight->data_type() == kNumberTypeFloat32 && !IsContain(weights, weight)) {
+      weights.push_back(weight);
+    }
+  }
+  return weights;
+}
+
+int TrainSession::RefreshWeightsSnapshot() {
+  // a snapshot taken earlier follows weights that were replaced from outside, e.g. by a new global model
+  if (!weights_delta_.HasSnapshot()) {
+    return RET_OK;
+  }
+  return TakeWeightsSnapshot();
+}
+
+int TrainSession::TakeWeightsSnapshot() {
+  auto weights = GetTrainableWeights();
+  if (weights.empty()) {
+    MS_LOG(ERROR) << "model has no trainable float32 weights";
+    return RET_ERROR;
+  }
+  return weights_delta_.TakeSnapshot(weights);
+}
+
+int TrainSession::ExportWeightsDelta(void *buf, size_t buf_size, size_t *out_size, TypeId data_type) {
+  return weights_delta_.Encode(data_type, buf, buf_size, out_size);
 }
 
 std::set<schema::PrimitiveType> inPlaceSupportedKernels = {
@@ -24,6 +24,9 @@
 #include "include/train/train_cfg.h"
 #include "include/train/train_session.h"
 #include "src/lite_session.h"
+#include "src/train/fused_optimizer.h"
+#include "src/train/recompute_planner.h"
+#include "src/train/weights_delta.h"
 
 /*
        Inheritance Diagram
@@ -100,12 +103,18 @@ class TrainSession : virtual public lite::LiteSession {
   std::vector<tensor::MSTensor *> GetFeatureMaps() const override;
 
   int UpdateFeatureMaps(const std::vector<tensor::MSTensor *> &features_map) override;
+  int TakeWeightsSnapshot() override;
+  int ExportWeightsDelta(void *buf, size_t buf_size, size_t *out_size, TypeId data_type) override;
   int FindUseInTensorKernel(std::vector<kernel::LiteKernel *> *use_in_tensor_kernels,
                             const std::vector<lite::Tensor *> &kernel_in_tensors,
                             const std::vector<kernel::LiteKernel *> &inference_kernels);
   int FindExportKernels(std::vector<kernel::LiteKernel *> *export_kernels,
                         const std::vector<std::string> &export_output_tensor_names,
                         const std::vector<kernel::LiteKernel *> &inference_kernels);
+  // const tensors that training writes to: optimizer params/state and batchnorm statistics
+  std::vector<lite::Tensor *> GetTrainableStateTensors() const;
+  // activations dropped and recomputed to meet TrainCfg::recompute_memory_budget_, with peak memory and FLOPs
+  const RecomputePlan &recompute_plan() const { return recompute_plan_; }
 
  protected:
   int AllocWorkSpace();
@@ -122,6 +131,7 @@ class TrainSession : virtual public lite::LiteSession {
   virtual void CompileOptimizedKernels();
   virtual void CompileTrainOutputs();
   virtual void CompileEvalOutputs();
+  virtual void CompileFusedOptimizer();
   virtual int InitCallBack();
   std::shared_ptr<Model> model_ = nullptr;
   // TrainCfg train_cfg_;
@@ -148,6 +158,8 @@ class TrainSession : virtual public lite::LiteSession {
   int OptimizerStep();
   int ExecKernels(const KernelCallBack &before, const KernelCallBack &after,
                   const std::vector<kernel::LiteKernel *> &run_kernel);
+  int FusedOptimizerExecKernels(const KernelCallBack &before, const KernelCallBack &after);
+  int RecomputeExecKernels(const KernelCallBack &before, const KernelCallBack &after, bool skip_optimizers);
   int MixPrecisionExecKernels(const KernelCallBack &before, const KernelCallBack &after,
                               const std::vector<kernel::LiteKernel *> &run_kernel);
   int MixPrecisionPreProcess(kernel::LiteKernel *kernel, float scale);
@@ -157,7 +169,17 @@ class TrainSession : virtual public lite::LiteSession {
   void FreeRestoreTensors();
   bool AllInputsNeedScale(kernel::LiteKernel *kernel);
   void FreeWorkSpace();
+  std::vector<lite::Tensor *> GetTrainableWeights() const;
+  int RefreshWeightsSnapshot();
   int AllocTensors(const std::vector<kernel::LiteKernel *> &kernels);
+  int AllocTrainTensors();
+  int PlanRecompute();
+  void ResetRecomputePlan();
+  size_t PlanTensors(const std::vector<kernel::LiteKernel *> &schedule,
+                     std::unordered_map<lite::Tensor *, size_t> *offset_map,
+                     std::vector<std::vector<size_t>> *step_offsets);
+  int SetTensorsData(size_t size, const std::unordered_map<lite::Tensor *, size_t> &offset_map);
+  bool CanRecompute(kernel::LiteKernel *kernel);
   bool IsInPlaceKernel(kernel::LiteKernel *kernel);
   bool IsInPlaceTensor(kernel::LiteKernel *kernel, uint32_t idx,
                        const std::unordered_map<lite::Tensor *, int> &ref_count, uint32_t *input_idx);
@@ -175,6 +197,15 @@ class TrainSession : virtual public lite::LiteSession {
   void *tensors_data_ = nullptr;
   unsigned int tensors_data_size_ = 0;
   std::shared_ptr<Allocator> allocator_;
+  std::unique_ptr<FusedOptimizer> fused_optimizer_ = nullptr;
+  std::vector<kernel::LiteKernel *> fused_run_kernels_;
+  WeightsDelta weights_delta_;
+  RecomputePlan recompute_plan_;
+  std::vector<std::vector<size_t>> recompute_offsets_;
+  std::unordered_map<lite::Tensor *, size_t> recompute_offset_map_;
+  size_t recompute_arena_size_ = 0;
+  // budget the recompute plan was made for, 0 when there is no plan
+  size_t recompute_planned_budget_ = 0;
 };
 
 }  // namespace lite
@@ -0,0 +1,269 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/train/weights_delta.h"
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <algorithm>
+#include <type_traits>
+#include "include/errorcode.h"
+#include "src/common/log_adapter.h"
+#include "nnacl/nnacl_common.h"
+
+namespace mindspore {
+namespace lite {
+namespace {
+constexpr uint32_t kWeightsDeltaMagic = 0x4457534D;  // "MSWD"
+constexpr uint16_t kWeightsDeltaVersion = 1;
+constexpr float kInt8QuantMax = 127.0f;
+constexpr size_t kHeaderSize = sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint32_t);
+
+// the fields are stored byte by byte in little endian, independent of the byte order of the host
+template <typename T>
+void StoreLittleEndian(T value, char *dst) {
+  static_assert(std::is_unsigned<T>::value, "only unsigned integers are stored");
+  for (size_t i = 0; i < sizeof(T); i++) {
+    dst[i] = static_cast<char>((value >> (i * CHAR_BIT)) & 0xFF);
+  }
+}
+
+template <typename T>
+T LoadLittleEndian(const char *src) {
+  static_assert(std::is_unsigned<T>::value, "only unsigned integers are loaded");
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); i++) {
+    value |= static_cast<T>(static_cast<unsigned char>(src[i])) << (i * CHAR_BIT);
+  }
+  return value;
+}
+
+uint32_t FloatToBits(float value) {
+  uint32_t bits = 0;
+  memcpy(&bits, &value, sizeof(float));
+  return bits;
+}
+
+float BitsToFloat(uint32_t bits) {
+  float value = 0.0f;
+  memcpy(&value, &bits, sizeof(float));
+  return value;
+}
+
+class StreamWriter {
+ public:
+  explicit StreamWriter(char *buf) : cur_(buf) {}
+  template <typename T>
+  void Write(T value) {
+    StoreLittleEndian<T>(value, cur_);
+    cur_ += sizeof(T);
+  }
+  void Write(const void *data, size_t size) {
+    memcpy(cur_, data, size);
+    cur_ += size;
+  }
+  char *cur() { return cur_; }
+  void Skip(size_t size) { cur_ += size; }
+
+ private:
+  char *cur_;
+};
+
+class StreamReader {
+ public:
+  StreamReader(const char *buf, size_t size) : cur_(buf), left_(size) {}
+  template <typename T>
+  bool Read(T *value) {
+    if (left_ < sizeof(T)) {
+      return false;
+    }
+    *value = LoadLittleEndian<T>(cur_);
+    cur_ += sizeof(T);
+    left_ -= sizeof(T);
+    return true;
+  }
+  const char *Take(size_t size) {
+    if (left_ < size) {
+      return nullptr;
+    }
+    auto ret = cur_;
+    cur_ += size;
+    left_ -= size;
+    return ret;
+  }
+
+ private:
+  const char *cur_;
+  size_t left_;
+};
+
+size_t PayloadSize(TypeId data_type, size_t elem_num) {
+  if (data_type == kNumberTypeInt8) {
+    return sizeof(float) + elem_num * sizeof(int8_t);
+  }
+  return elem_num * sizeof(uint16_t);
+}
+}  // namespace
+
+int WeightsDelta::TakeSnapshot(const std::vector<lite::Tensor *> &weights) {
+  ClearSnapshot();
+  for (auto weight : weights) {
+    if (weight == nullptr || weight->data() == nullptr || weight->data_type() != kNumberTypeFloat32) {
+      MS_LOG(ERROR) << "weights snapshot supports only float32 tensors with data";
+      ClearSnapshot();
+      return RET_PARAM_INVALID;
+    }
+    if (weight->tensor_name().size() > UINT16_MAX) {
+      MS_LOG(ERROR) << "tensor name too long: " << weight->tensor_name();
+      ClearSnapshot();
+      return RET_PARAM_INVALID;
+    }
+    auto data = reinterpret_cast<float *>(weight->data());
+    weights_.push_back(weight);
+    snapshot_.emplace_back(data, data + weight->ElementsNum());
+  }
+  return RET_OK;
+}
+
+void WeightsDelta::ClearSnapshot() {
+  weights_.clear();
+  snapshot_.clear();
+}
+
+size_t WeightsDelta::EncodedSize(TypeId data_type) const {
+  size_t size = kHeaderSize;
+  for (size_t i = 0; i < weights_.size(); i++) {
+    size += sizeof(uint16_t) + weights_[i]->tensor_name().size() + sizeof(uint32_t);
+    size += PayloadSize(data_type, snapshot_[i].size());
+  }
+  return size;
+}
+
+int WeightsDelta::Encode(TypeId data_type, void *buf, size_t buf_size, size_t *out_size) const {
+  if (out_size == nullptr) {
+    MS_LOG(ERROR) << "out_size cannot be nullptr";
+    return RET_NULL_PTR;
+  }
+  if (data_type != kNumberTypeInt8 && data_type != kNumberTypeFloat16) {
+    MS_LOG(ERROR) << "weights delta supports only int8 and float16, got " << data_type;
+    return RET_PARAM_INVALID;
+  }
+  if (!HasSnapshot()) {
+    MS_LOG(ERROR) << "no weights snapshot to compute deltas against";
+    return RET_ERROR;
+  }
+  *out_size = EncodedSize(data_type);
+  if (buf == nullptr || buf_size < *out_size) {
+    MS_LOG(ERROR) << "buffer of " << buf_size << " bytes is too small, " << *out_size << " bytes are required";
+    return RET_PARAM_INVALID;
+  }
+  for (size_t i = 0; i < weights_.size(); i++) {
+    if (static_cast<size_t>(weights_[i]->ElementsNum()) != snapshot_[i].size() || weights_[i]->data() == nullptr) {
+      MS_LOG(ERROR) << "weight " << weights_[i]->tensor_name() << " changed shape since snapshot";
+      return RET_ERROR;
+    }
+  }
+
+  StreamWriter writer(reinterpret_cast<char *>(buf));
+  writer.Write<uint32_t>(kWeightsDeltaMagic);
+  writer.Write<uint16_t>(kWeightsDeltaVersion);
+  writer.Write<uint16_t>(static_cast<uint16_t>(data_type));
+  writer.Write<uint32_t>(static_cast<uint32_t>(weights_.size()));
+  for (size_t i = 0; i < weights_.size(); i++) {
+    const auto &name = weights_[i]->tensor_name();
+    auto current = reinterpret_cast<const float *>(weights_[i]->data());
+    const auto &reference = snapshot_[i];
+    size_t elem_num = reference.size();
+    writer.Write<uint16_t>(static_cast<uint16_t>(name.size()));
+    writer.Write(name.data(), name.size());
+    writer.Write<uint32_t>(static_cast<uint32_t>(elem_num));
+    if (data_type == kNumberTypeInt8) {
+      float max_abs = 0.0f;
+      for (size_t j = 0; j < elem_num; j++) {
+        max_abs = std::max(max_abs, std::fabs(current[j] - reference[j]));
+      }
+      float scale = max_abs / kInt8QuantMax;
+      writer.Write<uint32_t>(FloatToBits(scale));
+      auto dst = reinterpret_cast<int8_t *>(writer.cur());
+      float inv_scale = (scale > 0.0f) ? (1.0f / scale) : 0.0f;
+      for (size_t j = 0; j < elem_num; j++) {
+        float q = std::round((current[j] - reference[j]) * inv_scale);
+        dst[j] = static_cast<int8_t>(std::min(std::max(q, -kInt8QuantMax), kInt8QuantMax));
+      }
+      writer.Skip(elem_num * sizeof(int8_t));
+    } else {
+      for (size_t j = 0; j < elem_num; j++) {
+        writer.Write<uint16_t>(Float32ToShort(current[j] - reference[j]));
+      }
+    }
+  }
+  return RET_OK;
+}
+
+int WeightsDelta::Apply(const void *buf, size_t size, const std::vector<lite::Tensor *> &weights) {
+  if (buf == nullptr) {
+    MS_LOG(ERROR) << "weights delta buffer cannot be nullptr";
+    return RET_NULL_PTR;
+  }
+  StreamReader reader(reinterpret_cast<const char *>(buf), size);
+  uint32_t magic = 0;
+  uint16_t version = 0;
+  uint16_t data_type = 0;
+  uint32_t tensor_num = 0;
+  if (!reader.Read(&magic) || !reader.Read(&version) || !reader.Read(&data_type) || !reader.Read(&tensor_num) ||
+      magic != kWeightsDeltaMagic || version != kWeightsDeltaVersion ||
+      (data_type != kNumberTypeInt8 && data_type != kNumberTypeFloat16)) {
+    MS_LOG(ERROR) << "invalid weights delta header";
+    return RET_ERROR;
+  }
+  for (uint32_t i = 0; i < tensor_num; i++) {
+    uint16_t name_len = 0;
+    uint32_t elem_num = 0;
+    const char *name = nullptr;
+    if (!reader.Read(&name_len) || (name = reader.Take(name_len)) == nullptr || !reader.Read(&elem_num)) {
+      MS_LOG(ERROR) << "truncated weights delta record " << i;
+      return RET_ERROR;
+    }
+    std::string tensor_name(name, name_len);
+    auto it = std::find_if(weights.begin(), weights.end(),
+                           [&tensor_name](const lite::Tensor *t) { return t->tensor_name() == tensor_name; });
+    if (it == weights.end() || (*it)->data_type() != kNumberTypeFloat32 || (*it)->data() == nullptr ||
+        static_cast<uint32_t>((*it)->ElementsNum()) != elem_num) {
+      MS_LOG(ERROR) << "no matching float32 tensor for weights delta of " << tensor_name;
+      return RET_ERROR;
+    }
+    auto payload = reader.Take(PayloadSize(static_cast<TypeId>(data_type), elem_num));
+    if (payload == nullptr) {
+      MS_LOG(ERROR) << "truncated weights delta payload of " << tensor_name;
+      return RET_ERROR;
+    }
+    auto dst = reinterpret_cast<float *>((*it)->data());
+    if (data_type == kNumberTypeInt8) {
+      float scale = BitsToFloat(LoadLittleEndian<uint32_t>(payload));
+      auto q = reinterpret_cast<const int8_t *>(payload + sizeof(float));
+      for (uint32_t j = 0; j < elem_num; j++) {
+        dst[j] += q[j] * scale;
+      }
+    } else {
+      for (uint32_t j = 0; j < elem_num; j++) {
+        dst[j] += ShortToFloat32(LoadLittleEndian<uint16_t>(payload + j * sizeof(uint16_t)));
+      }
+    }
+  }
+  return RET_OK;
+}
+}  // namespace lite
+}  // namespace mindspore
@@ -0,0 +1,52 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_LITE_SRC_TRAIN_WEIGHTS_DELTA_H_
+#define MINDSPORE_LITE_SRC_TRAIN_WEIGHTS_DELTA_H_
+#include <vector>
+#include "src/tensor.h"
+
+namespace mindspore {
+namespace lite {
+/*
+  Trainable weights serialized as quantized deltas against a reference snapshot.
+  All fields are little endian and every tensor record is self contained, so the stream is written in one pass:
+
+    header : magic(u32) version(u16) data_type(u16) tensor_num(u32)
+    tensor : name_len(u16) name elem_num(u32) payload
+             int8    payload: scale(f32) followed by elem_num int8, delta = q * scale
+             float16 payload: elem_num fp16 values
+*/
+class WeightsDelta {
+ public:
+  WeightsDelta() = default;
+  ~WeightsDelta() = default;
+
+  int TakeSnapshot(const std::vector<lite::Tensor *> &weights);
+  bool HasSnapshot() const { return !weights_.empty(); }
+  void ClearSnapshot();
+  size_t EncodedSize(TypeId data_type) const;
+  // out_size is set to the required size also when buf_size is too small
+  int Encode(TypeId data_type, void *buf, size_t buf_size, size_t *out_size) const;
+  // adds the deltas of buf to the tensors with matching names
+  static int Apply(const void *buf, size_t size, const std::vector<lite::Tensor *> &weights);
+
+ private:
+  std::vector<lite::Tensor *> weights_;
+  std::vector<std::vector<float>> snapshot_;
+};
+}  // namespace lite
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_SRC_TRAIN_WEIGHTS_DELTA_H_
@@ -457,4 +457,33 @@ int WeightDecoder::DecompressTensor(const SchemaTensorWrapper &src_tensor, Tenso
     return WeightDecoder::UnPack(src_tensor, dst_tensor);
   }
 }
+
+bool WeightDecoder::NeedDecompress(const SchemaTensorWrapper &src_tensor) {
+  MS_ASSERT(src_tensor.handler() != nullptr);
+  return src_tensor.handler()->weightQunatCompressType() != schema::WeightQunatCompressType_NONE ||
+         NeedBitUppackCheck(src_tensor);
+}
+
+int LazyWeightDecoder::Decode(const std::vector<Tensor *> &tensors) {
+  for (auto tensor : tensors) {
+    auto iter = pending_.find(tensor);
+    if (iter == pending_.end()) {
+      continue;
+    }
+    auto ret = WeightDecoder::DecompressTensor(*(iter->second), tensor);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Decompress tensor " << tensor->tensor_name() << " failed: " << ret;
+      return RET_ERROR;
+    }
+    pending_.erase(iter);
+    decoded_size_ += tensor->Size();
+  }
+  return RET_OK;
+}
+
+size_t LazyWeightDecoder::Clear() {
+  auto skipped = pending_.size();
+  pending_.clear();
+  return skipped;
+}
 }  // namespace mindspore::lite
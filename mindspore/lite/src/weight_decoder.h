@@ -17,7 +17,9 @@
 #ifndef MINDSPORE_LITE_SRC_WEIGHT_DECODER_H_
 #define MINDSPORE_LITE_SRC_WEIGHT_DECODER_H_
 
+#include <algorithm>
 #include <map>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <queue>
@@ -155,6 +157,8 @@ class WeightDecoder {
 
   static int DecompressTensor(const SchemaTensorWrapper &src_tensor, Tensor *dst_tensor);
 
+  static bool NeedDecompress(const SchemaTensorWrapper &src_tensor);
+
  private:
   static int DequantTensor(Tensor *tensor, int preferred_dim, TypeId dst_data_type = kNumberTypeFloat32);
 
@@ -311,6 +315,32 @@ class WeightDecoder {
     }
   }
 };
+
+// Holds compressed weights back from model conversion and decodes each one when the first kernel using it is built,
+// or earlier when the shape infer of a node needs its data, so weights of nodes that never get a kernel are never
+// decoded.
+class LazyWeightDecoder {
+ public:
+  LazyWeightDecoder() = default;
+  ~LazyWeightDecoder() = default;
+
+  // src_tensor points into the model and must stay valid until the tensor is decoded or Clear is called
+  void Register(Tensor *tensor, const SchemaTensorWrapper *src_tensor) { pending_[tensor] = src_tensor; }
+  bool IsPending(const Tensor *tensor) const { return pending_.find(tensor) != pending_.end(); }
+  bool HasPending(const std::vector<Tensor *> &tensors) const {
+    return std::any_of(tensors.begin(), tensors.end(), [this](const Tensor *tensor) { return IsPending(tensor); });
+  }
+  // decodes the pending ones of tensors, others are left alone
+  int Decode(const std::vector<Tensor *> &tensors);
+  // drops the tensors nobody asked for, returns their number
+  size_t Clear();
+  size_t pending_num() const { return pending_.size(); }
+  size_t decoded_size() const { return decoded_size_; }
+
+ private:
+  std::unordered_map<const Tensor *, const SchemaTensorWrapper *> pending_;
+  size_t decoded_size_ = 0;
+};
 }  // namespace mindspore::lite
 #endif
 #endif  // MINDSPORE_LITE_SRC_WEIGHT_DECODER_H_
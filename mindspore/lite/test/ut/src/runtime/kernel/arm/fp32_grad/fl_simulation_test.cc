@@ -0,0 +1,120 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "include/context.h"
+#include "include/errorcode.h"
+#include "include/train/train_cfg.h"
+#include "src/train/fl_simulation.h"
+
+namespace mindspore {
+class TestFLSimulation : public mindspore::CommonTest {
+ public:
+  TestFLSimulation() {}
+};
+
+namespace {
+const char kNet[] = "./nets/lenet_train.ms";
+
+lite::Context SimulationContext() {
+  lite::Context context;
+  context.device_list_[0].device_info_.cpu_device_info_.cpu_bind_mode_ = lite::NO_BIND;
+  context.thread_num_ = 1;
+  return context;
+}
+
+// every client trains one step on its own constant data, labels are class 0
+int TrainClient(int client_id, session::LiteSession *session) {
+  for (auto input : session->GetInputs()) {
+    auto data = input->MutableData();
+    if (data == nullptr) {
+      return lite::RET_ERROR;
+    }
+    if (input->data_type() == kNumberTypeFloat32) {
+      auto float_data = reinterpret_cast<float *>(data);
+      for (int i = 0; i < input->ElementsNum(); i++) {
+        float_data[i] = 0.1f * (client_id + 1);
+      }
+    } else {
+      memset(data, 0, input->Size());
+    }
+  }
+  return session->RunGraph();
+}
+
+std::vector<std::vector<char>> RunRound(int engine_num, std::vector<char> *init_state) {
+  auto context = SimulationContext();
+  lite::TrainCfg cfg;
+  lite::FLSimulation simulation;
+  EXPECT_EQ(lite::RET_OK, simulation.Init(kNet, &context, &cfg, engine_num));
+  EXPECT_EQ(lite::RET_OK, simulation.AddClients(2));
+  if (init_state != nullptr) {
+    auto params = simulation.GetClientParams(0);
+    for (auto param : params) {
+      auto data = reinterpret_cast<char *>(param->data());
+      init_state->insert(init_state->end(), data, data + param->Size());
+      delete param;
+    }
+  }
+  EXPECT_EQ(lite::RET_OK, simulation.RunClients({0, 1}, TrainClient));
+
+  std::vector<std::vector<char>> states;
+  for (int client_id = 0; client_id < 2; client_id++) {
+    std::vector<char> state;
+    auto params = simulation.GetClientParams(client_id);
+    for (auto param : params) {
+      auto data = reinterpret_cast<char *>(param->data());
+      state.insert(state.end(), data, data + param->Size());
+      delete param;
+    }
+    states.push_back(state);
+  }
+  return states;
+}
+}  // namespace
+
+/// Feature: FLSimulation
+/// Description: Train two clients in one round on two engines concurrently and on one engine in turn
+/// Expectation: Each client is trained on its own state, and the engines don't leak the state between the clients
+TEST_F(TestFLSimulation, TwoClientRound) {
+  std::vector<char> init_state;
+  auto concurrent = RunRound(2, &init_state);
+  auto sequential = RunRound(1, nullptr);
+  ASSERT_EQ(concurrent.size(), 2);
+  ASSERT_FALSE(init_state.empty());
+  EXPECT_EQ(concurrent[0].size(), init_state.size());
+  EXPECT_NE(concurrent[0], init_state);
+  EXPECT_NE(concurrent[1], init_state);
+  EXPECT_NE(concurrent[0], concurrent[1]);
+  EXPECT_EQ(concurrent, sequential);
+}
+
+/// Feature: FLSimulation
+/// Description: Initialize the simulation with a model which doesn't exist, and then with the right one
+/// Expectation: The failed initialization leaves nothing behind, so the second one succeeds
+TEST_F(TestFLSimulation, InitAfterFailure) {
+  auto context = SimulationContext();
+  lite::TrainCfg cfg;
+  lite::FLSimulation simulation;
+  EXPECT_NE(lite::RET_OK, simulation.Init("./nets/not_exist_train.ms", &context, &cfg, 2));
+  EXPECT_NE(lite::RET_OK, simulation.AddClients(1));
+  EXPECT_EQ(lite::RET_OK, simulation.Init(kNet, &context, &cfg, 2));
+  EXPECT_EQ(lite::RET_OK, simulation.AddClients(1));
+  EXPECT_EQ(simulation.client_num(), 1);
+}
+}  // namespace mindspore
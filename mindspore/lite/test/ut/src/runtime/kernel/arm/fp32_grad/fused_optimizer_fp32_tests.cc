@@ -0,0 +1,226 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "include/context.h"
+#include "include/errorcode.h"
+#include "include/train/train_cfg.h"
+#include "include/train/train_session.h"
+#include "nnacl/fp32_grad/fused_optimizer.h"
+
+namespace mindspore {
+class TestFusedOptimizerFp32 : public mindspore::CommonTest {
+ public:
+  TestFusedOptimizerFp32() {}
+};
+
+TEST_F(TestFusedOptimizerFp32, AdamSgdAcrossSegments) {
+  constexpr size_t kAdamLen = 13;
+  constexpr size_t kSgdLen = 21;
+  constexpr size_t kTotal = kAdamLen + kSgdLen;
+  const float lr = 0.1f;
+  const float beta1 = 0.9f;
+  const float beta2 = 0.99f;
+  const float eps = 1e-8f;
+  const float momentum = 0.9f;
+  const float dampening = 0.1f;
+  std::vector<float> weight(kTotal), moment1(kTotal), moment2(kTotal), gradient(kTotal), grad_sum(kTotal);
+  for (size_t i = 0; i < kTotal; i++) {
+    weight[i] = 0.1f * i;
+    moment1[i] = 0.01f * i;
+    moment2[i] = 0.02f * i;
+    gradient[i] = std::sin(static_cast<float>(i));
+    grad_sum[i] = std::cos(static_cast<float>(i));
+  }
+  std::vector<float> expect_weight = weight;
+  std::vector<float> expect_moment1 = moment1;
+  std::vector<float> expect_moment2 = moment2;
+  for (size_t i = 0; i < kAdamLen; i++) {
+    float grad = gradient[i] + grad_sum[i];
+    expect_moment1[i] += (grad - expect_moment1[i]) * (1 - beta1);
+    expect_moment2[i] += (grad * grad - expect_moment2[i]) * (1 - beta2);
+    expect_weight[i] -= lr * expect_moment1[i] / (std::sqrt(expect_moment2[i]) + eps);
+  }
+  for (size_t i = kAdamLen; i < kTotal; i++) {
+    float grad = gradient[i] + grad_sum[i];
+    expect_moment1[i] = expect_moment1[i] * momentum + grad * (1 - dampening);
+    expect_weight[i] -= expect_moment1[i] * lr;
+  }
+
+  FusedOptimizerSegment segments[2] = {};
+  segments[0].type_ = FusedOptimizer_Adam;
+  segments[0].weight_ = weight.data();
+  segments[0].moment1_ = moment1.data();
+  segments[0].moment2_ = moment2.data();
+  segments[0].gradient_ = gradient.data();
+  segments[0].grad_sum_ = grad_sum.data();
+  segments[0].length_ = kAdamLen;
+  segments[0].lr_ = lr;
+  segments[0].beta1_ = beta1;
+  segments[0].beta2_ = beta2;
+  segments[0].epsilon_ = eps;
+  segments[1].type_ = FusedOptimizer_Sgd;
+  segments[1].weight_ = weight.data() + kAdamLen;
+  segments[1].moment1_ = moment1.data() + kAdamLen;
+  segments[1].gradient_ = gradient.data() + kAdamLen;
+  segments[1].grad_sum_ = grad_sum.data() + kAdamLen;
+  segments[1].length_ = kSgdLen;
+  segments[1].lr_ = lr;
+  segments[1].momentum_ = momentum;
+  segments[1].dampening_ = dampening;
+
+  // task ranges deliberately straddle the segment boundary
+  FusedOptimizerStepFp32(segments, 2, 0, 7);
+  FusedOptimizerStepFp32(segments, 2, 7, 20);
+  FusedOptimizerStepFp32(segments, 2, 20, kTotal);
+
+  ASSERT_EQ(0, CompareOutputData(weight.data(), expect_weight.data(), kTotal));
+  ASSERT_EQ(0, CompareOutputData(moment1.data(), expect_moment1.data(), kTotal));
+  ASSERT_EQ(0, CompareOutputData(moment2.data(), expect_moment2.data(), kAdamLen));
+  std::vector<float> zeros(kTotal, 0.0f);
+  ASSERT_EQ(0, CompareOutputData(grad_sum.data(), zeros.data(), kTotal));
+}
+
+TEST_F(TestFusedOptimizerFp32, AccumulateGrad) {
+  std::vector<float> gradient = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<float> grad_sum(gradient.size(), 1.0f);
+  FusedOptimizerSegment segments[2] = {};
+  segments[0].gradient_ = gradient.data();
+  segments[0].grad_sum_ = grad_sum.data();
+  segments[0].length_ = 5;
+  segments[1].gradient_ = gradient.data() + 5;
+  segments[1].grad_sum_ = grad_sum.data() + 5;
+  segments[1].length_ = 4;
+  FusedAccumulateGradFp32(segments, 2, 0, 3);
+  FusedAccumulateGradFp32(segments, 2, 3, gradient.size());
+  std::vector<float> expect = {2, 3, 4, 5, 6, 7, 8, 9, 10};
+  ASSERT_EQ(0, CompareOutputData(grad_sum.data(), expect.data(), expect.size()));
+}
+
+/// Feature: Fused optimizer
+/// Description: Accumulate the gradients of two micro batches, then step on the gradient sum only, as OptimizerStep
+/// does at the end of a virtual batch
+/// Expectation: Same weights as one step on the summed gradients, and the gradient sums are cleared
+TEST_F(TestFusedOptimizerFp32, VirtualBatchSgd) {
+  constexpr size_t kLen = 19;
+  const float lr = 0.05f;
+  const float momentum = 0.9f;
+  std::vector<float> weight(kLen), accumulate(kLen, 0.0f), grad1(kLen), grad2(kLen), grad_sum(kLen, 0.0f);
+  for (size_t i = 0; i < kLen; i++) {
+    weight[i] = 0.1f * i;
+    grad1[i] = std::sin(static_cast<float>(i));
+    grad2[i] = std::cos(static_cast<float>(i));
+  }
+  std::vector<float> expect_weight = weight;
+  std::vector<float> expect_accumulate(kLen);
+  for (size_t i = 0; i < kLen; i++) {
+    expect_accumulate[i] = grad1[i] + grad2[i];
+    expect_weight[i] -= expect_accumulate[i] * lr;
+  }
+
+  FusedOptimizerSegment segment = {};
+  segment.type_ = FusedOptimizer_Sgd;
+  segment.weight_ = weight.data();
+  segment.moment1_ = accumulate.data();
+  segment.grad_sum_ = grad_sum.data();
+  segment.length_ = kLen;
+  segment.lr_ = lr;
+  segment.momentum_ = momentum;
+  segment.sgd_init_ = true;
+  segment.gradient_ = grad1.data();
+  FusedAccumulateGradFp32(&segment, 1, 0, kLen);
+  segment.gradient_ = grad2.data();
+  FusedAccumulateGradFp32(&segment, 1, 0, kLen);
+  std::vector<float> origin_weight(kLen);
+  for (size_t i = 0; i < kLen; i++) {
+    origin_weight[i] = 0.1f * i;
+  }
+  ASSERT_EQ(0, CompareOutputData(weight.data(), origin_weight.data(), kLen));
+
+  segment.gradient_ = nullptr;
+  FusedOptimizerStepFp32(&segment, 1, 0, kLen);
+  ASSERT_EQ(0, CompareOutputData(weight.data(), expect_weight.data(), kLen));
+  ASSERT_EQ(0, CompareOutputData(accumulate.data(), expect_accumulate.data(), kLen));
+  std::vector<float> zeros(kLen, 0.0f);
+  ASSERT_EQ(0, CompareOutputData(grad_sum.data(), zeros.data(), kLen));
+}
+
+/// Feature: Fused optimizer
+/// Description: Train lenet with a virtual batch of two micro batches, and count the optimizer kernels seen by the
+/// callbacks
+/// Expectation: The weights change only after the last micro batch, and the optimizer kernels are reported to both
+/// callbacks in every run
+TEST_F(TestFusedOptimizerFp32, VirtualBatchTrainSession) {
+  lite::Context context;
+  context.device_list_[0].device_info_.cpu_device_info_.cpu_bind_mode_ = lite::NO_BIND;
+  context.thread_num_ = 1;
+  lite::TrainCfg cfg;
+  auto session = session::TrainSession::CreateTrainSession("./nets/lenet_train.ms", &context, true, &cfg);
+  ASSERT_NE(session, nullptr);
+  ASSERT_EQ(lite::RET_OK, session->SetupVirtualBatch(2));
+  ASSERT_EQ(lite::RET_OK, session->Train());
+  for (auto input : session->GetInputs()) {
+    auto data = input->MutableData();
+    ASSERT_NE(data, nullptr);
+    if (input->data_type() == kNumberTypeFloat32) {
+      auto float_data = reinterpret_cast<float *>(data);
+      for (int i = 0; i < input->ElementsNum(); i++) {
+        float_data[i] = 0.01f * (i % 100);
+      }
+    } else {
+      memset(data, 0, input->Size());
+    }
+  }
+  auto get_weights = [session]() {
+    std::vector<char> weights;
+    for (auto tensor : session->GetFeatureMaps()) {
+      auto data = reinterpret_cast<char *>(tensor->data());
+      weights.insert(weights.end(), data, data + tensor->Size());
+    }
+    return weights;
+  };
+  int before_count = 0;
+  int after_count = 0;
+  auto is_optimizer = [](const CallBackParam &info) { return info.node_type == "SGD" || info.node_type == "Adam"; };
+  KernelCallBack before = [&before_count, &is_optimizer](const Vector<tensor::MSTensor *> &,
+                                                         const Vector<tensor::MSTensor *> &,
+                                                         const CallBackParam &info) {
+    before_count += is_optimizer(info) ? 1 : 0;
+    return true;
+  };
+  KernelCallBack after = [&after_count, &is_optimizer](const Vector<tensor::MSTensor *> &,
+                                                       const Vector<tensor::MSTensor *> &, const CallBackParam &info) {
+    after_count += is_optimizer(info) ? 1 : 0;
+    return true;
+  };
+
+  auto origin = get_weights();
+  ASSERT_FALSE(origin.empty());
+  ASSERT_EQ(lite::RET_OK, session->RunGraph(before, after));
+  EXPECT_EQ(get_weights(), origin);
+  EXPECT_GT(before_count, 0);
+  EXPECT_EQ(before_count, after_count);
+  int optimizer_num = before_count;
+  ASSERT_EQ(lite::RET_OK, session->RunGraph(before, after));
+  EXPECT_NE(get_weights(), origin);
+  EXPECT_EQ(before_count, 2 * optimizer_num);
+  EXPECT_EQ(after_count, 2 * optimizer_num);
+  delete session;
+}
+}  // namespace mindspore
@@ -0,0 +1,132 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "include/context.h"
+#include "include/errorcode.h"
+#include "include/train/train_cfg.h"
+#include "include/train/train_session.h"
+#include "src/train/train_session.h"
+
+namespace mindspore {
+class TestRecomputePlanner : public mindspore::CommonTest {
+ public:
+  TestRecomputePlanner() {}
+};
+
+namespace {
+const char kNet[] = "./nets/lenet_train.ms";
+
+std::unique_ptr<session::LiteSession> CreateSession(size_t memory_budget) {
+  lite::Context context;
+  context.device_list_[0].device_info_.cpu_device_info_.cpu_bind_mode_ = lite::NO_BIND;
+  context.thread_num_ = 1;
+  lite::TrainCfg cfg;
+  cfg.recompute_memory_budget_ = memory_budget;
+  return std::unique_ptr<session::LiteSession>(session::TrainSession::CreateTrainSession(kNet, &context, true, &cfg));
+}
+
+const lite::RecomputePlan &GetPlan(session::LiteSession *session) {
+  return static_cast<lite::TrainSession *>(session)->recompute_plan();
+}
+
+void FillInputs(session::LiteSession *session) {
+  for (auto input : session->GetInputs()) {
+    auto data = input->MutableData();
+    ASSERT_NE(data, nullptr);
+    if (input->data_type() == kNumberTypeFloat32) {
+      auto float_data = reinterpret_cast<float *>(data);
+      for (int i = 0; i < input->ElementsNum(); i++) {
+        float_data[i] = 0.01f * (i % 100);
+      }
+    } else {
+      memset(data, 0, input->Size());
+    }
+  }
+}
+
+// train two steps, then collect the outputs of the last step and the weights
+std::vector<char> TrainTwoSteps(session::LiteSession *session) {
+  std::vector<char> result;
+  EXPECT_EQ(lite::RET_OK, session->Train());
+  FillInputs(session);
+  for (int step = 0; step < 2; step++) {
+    EXPECT_EQ(lite::RET_OK, session->RunGraph());
+  }
+  for (auto &item : session->GetOutputs()) {
+    auto data = reinterpret_cast<char *>(item.second->MutableData());
+    result.insert(result.end(), data, data + item.second->Size());
+  }
+  for (auto tensor : session->GetFeatureMaps()) {
+    auto data = reinterpret_cast<char *>(tensor->data());
+    result.insert(result.end(), data, data + tensor->Size());
+  }
+  return result;
+}
+}  // namespace
+
+/// Feature: Activation recomputation
+/// Description: Plan lenet training with a budget above the arena, between the arena and zero, and below any schedule
+/// Expectation: Nothing is dropped above the arena, otherwise the arena shrinks and every dropped activation adds FLOPs
+TEST_F(TestRecomputePlanner, BudgetSelection) {
+  auto unlimited = CreateSession(std::numeric_limits<size_t>::max());
+  ASSERT_NE(unlimited, nullptr);
+  auto &unlimited_plan = GetPlan(unlimited.get());
+  EXPECT_TRUE(unlimited_plan.dropped_.empty());
+  EXPECT_EQ(unlimited_plan.extra_flops_, 0);
+  auto baseline = unlimited_plan.baseline_peak_;
+  ASSERT_GT(baseline, 0);
+  EXPECT_EQ(unlimited_plan.peak_, baseline);
+
+  for (size_t budget : {baseline * 3 / 4, static_cast<size_t>(1)}) {
+    auto session = CreateSession(budget);
+    ASSERT_NE(session, nullptr);
+    auto &plan = GetPlan(session.get());
+    EXPECT_EQ(plan.baseline_peak_, baseline);
+    if (plan.dropped_.empty()) {
+      EXPECT_EQ(plan.peak_, baseline);
+      continue;
+    }
+    EXPECT_LT(plan.peak_, baseline);
+    EXPECT_GT(plan.extra_flops_, 0);
+    EXPECT_LE(plan.extra_flops_, plan.flops_);
+    EXPECT_GT(plan.schedule_.size(), unlimited_plan.schedule_.size());
+  }
+}
+
+/// Feature: Activation recomputation
+/// Description: Train lenet two steps with the tightest budget and without recomputation, switching to eval between
+/// Expectation: Same outputs and weights, and the plan is made once and kept across the train and eval switches
+TEST_F(TestRecomputePlanner, SameResultAsNoRecompute) {
+  auto reference = CreateSession(0);
+  ASSERT_NE(reference, nullptr);
+  auto recompute = CreateSession(1);
+  ASSERT_NE(recompute, nullptr);
+  auto dropped = GetPlan(recompute.get()).dropped_;
+  auto schedule_size = GetPlan(recompute.get()).schedule_.size();
+
+  auto expect = TrainTwoSteps(reference.get());
+  ASSERT_EQ(lite::RET_OK, recompute->Eval());
+  auto result = TrainTwoSteps(recompute.get());
+  ASSERT_FALSE(expect.empty());
+  EXPECT_EQ(expect, result);
+  EXPECT_EQ(GetPlan(recompute.get()).dropped_, dropped);
+  EXPECT_EQ(GetPlan(recompute.get()).schedule_.size(), schedule_size);
+}
+}  // namespace mindspore
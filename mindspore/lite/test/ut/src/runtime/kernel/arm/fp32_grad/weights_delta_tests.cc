@@ -0,0 +1,81 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <vector>
+#include "common/common_test.h"
+#include "src/train/weights_delta.h"
+
+namespace mindspore {
+class TestWeightsDelta : public mindspore::CommonTest {
+ public:
+  TestWeightsDelta() {}
+};
+
+namespace {
+void InitWeight(lite::Tensor *tensor, const std::string &name, float base) {
+  tensor->set_tensor_name(name);
+  ASSERT_EQ(lite::RET_OK, tensor->MallocData());
+  auto data = reinterpret_cast<float *>(tensor->data());
+  for (int i = 0; i < tensor->ElementsNum(); i++) {
+    data[i] = base + 0.1f * i;
+  }
+}
+
+void RoundTrip(TypeId data_type, float tolerance) {
+  lite::Tensor w1(kNumberTypeFloat32, {2, 3});
+  lite::Tensor w2(kNumberTypeFloat32, {5});
+  InitWeight(&w1, "conv.weight", 1.0f);
+  InitWeight(&w2, "fc.bias", -2.0f);
+  std::vector<lite::Tensor *> weights = {&w1, &w2};
+
+  lite::WeightsDelta delta;
+  ASSERT_EQ(lite::RET_OK, delta.TakeSnapshot(weights));
+  // local training moves the weights
+  std::vector<std::vector<float>> trained;
+  for (auto w : weights) {
+    auto data = reinterpret_cast<float *>(w->data());
+    for (int i = 0; i < w->ElementsNum(); i++) {
+      data[i] += 0.01f * std::sin(static_cast<float>(i + 1));
+    }
+    trained.emplace_back(data, data + w->ElementsNum());
+  }
+
+  size_t size = 0;
+  ASSERT_NE(lite::RET_OK, delta.Encode(data_type, nullptr, 0, &size));
+  ASSERT_EQ(delta.EncodedSize(data_type), size);
+  std::vector<char> buf(size);
+  ASSERT_EQ(lite::RET_OK, delta.Encode(data_type, buf.data(), buf.size(), &size));
+  // the header is little endian on any host: magic "MSWD", version 1
+  const std::vector<char> header = {'M', 'S', 'W', 'D', 1, 0};
+  ASSERT_EQ(header, std::vector<char>(buf.begin(), buf.begin() + header.size()));
+
+  // the receiver still holds the reference weights
+  lite::Tensor r1(kNumberTypeFloat32, {2, 3});
+  lite::Tensor r2(kNumberTypeFloat32, {5});
+  InitWeight(&r1, "conv.weight", 1.0f);
+  InitWeight(&r2, "fc.bias", -2.0f);
+  std::vector<lite::Tensor *> receiver = {&r2, &r1};
+  ASSERT_EQ(lite::RET_OK, lite::WeightsDelta::Apply(buf.data(), buf.size(), receiver));
+  ASSERT_EQ(0, CompareOutputData(reinterpret_cast<float *>(r1.data()), trained[0].data(), r1.ElementsNum(), tolerance));
+  ASSERT_EQ(0, CompareOutputData(reinterpret_cast<float *>(r2.data()), trained[1].data(), r2.ElementsNum(), tolerance));
+  ASSERT_NE(lite::RET_OK, lite::WeightsDelta::Apply(buf.data(), buf.size() - 1, receiver));
+}
+}  // namespace
+
+TEST_F(TestWeightsDelta, Int8RoundTrip) { RoundTrip(kNumberTypeInt8, 1e-4); }
+
+TEST_F(TestWeightsDelta, Fp16RoundTrip) { RoundTrip(kNumberTypeFloat16, 1e-5); }
+}  // namespace mindspore
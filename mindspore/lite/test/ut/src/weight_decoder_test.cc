@@ -0,0 +1,183 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "schema/inner/model_generated.h"
+#include "src/common/common.h"
+#include "src/common/utils.h"
+#include "src/lite_session.h"
+#include "src/weight_decoder.h"
+
+namespace mindspore {
+class WeightDecoderTest : public mindspore::CommonTest {
+ public:
+  WeightDecoderTest() = default;
+};
+
+namespace {
+constexpr int kElementNum = 8;
+
+// an int8 weight of 8 elements, bit packed with 4 bits each
+void BuildPackedWeight(flatbuffers::FlatBufferBuilder *fbb) {
+  auto tensor = std::make_unique<schema::TensorT>();
+  tensor->nodeType = lite::NodeType_ValueNode;
+  tensor->format = schema::Format_NHWC;
+  tensor->dataType = kNumberTypeInt8;
+  tensor->dims = {kElementNum};
+  tensor->data = {0x12, 0x34, 0x56, 0x78};
+  auto quant_param = std::make_unique<schema::QuantParamT>();
+  quant_param->numBits = 4;
+  quant_param->scale = 0.5;
+  quant_param->zeroPoint = 0;
+  quant_param->inited = true;
+  tensor->quantParams.emplace_back(std::move(quant_param));
+  fbb->Finish(schema::Tensor::Pack(*fbb, tensor.get()));
+}
+
+constexpr int kReshapeRow = 3;
+constexpr int kReshapeCol = 4;
+
+// reshapes a float input of {2, 6} by an int8 shape of {3, 4}, which is bit packed with 4 bits each, so the infer of
+// Reshape reads the compressed const input
+void BuildPackedShapeReshape(flatbuffers::FlatBufferBuilder *fbb) {
+  auto meta_graph = std::make_unique<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Reshape;
+  node->primitive->value.value = new schema::ReshapeT;
+  node->name = "Reshape";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+
+  auto input = std::make_unique<schema::TensorT>();
+  input->nodeType = lite::NodeType_Parameter;
+  input->format = schema::Format_NHWC;
+  input->dataType = kNumberTypeFloat32;
+  input->dims = {2, kReshapeRow * kReshapeCol / 2};
+  meta_graph->allTensors.emplace_back(std::move(input));
+
+  auto shape = std::make_unique<schema::TensorT>();
+  shape->nodeType = lite::NodeType_ValueNode;
+  shape->format = schema::Format_NHWC;
+  shape->dataType = kNumberTypeInt8;
+  shape->dims = {2};
+  // the low 4 bits come first and each value is offset by 8: 0xB - 8 = 3, 0xC - 8 = 4
+  shape->data = {0xCB};
+  auto quant_param = std::make_unique<schema::QuantParamT>();
+  quant_param->numBits = 4;
+  quant_param->scale = 1;
+  quant_param->zeroPoint = 0;
+  quant_param->inited = true;
+  shape->quantParams.emplace_back(std::move(quant_param));
+  meta_graph->allTensors.emplace_back(std::move(shape));
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = lite::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = kNumberTypeFloat32;
+  meta_graph->allTensors.emplace_back(std::move(output));
+  fbb->Finish(schema::MetaGraph::Pack(*fbb, meta_graph.get()));
+}
+
+// compiles the model with the weight decode config given, checks the output shape is inferred at compiling and
+// returns the output after running
+std::vector<float> CompileAndRun(const flatbuffers::FlatBufferBuilder &fbb, const std::string &lazy_decode) {
+  std::unique_ptr<lite::Model> model(
+    lite::Model::Import(reinterpret_cast<const char *>(fbb.GetBufferPointer()), fbb.GetSize()));
+  if (model == nullptr) {
+    return {};
+  }
+  std::map<std::string, std::map<std::string, std::string>> config = {
+    {lite::kWeightDecode, {{lite::kWeightDecodeLazy, lazy_decode}}}};
+  lite::LiteSession session;
+  session.SetConfigInfo(&config);
+  auto context = new lite::InnerContext;
+  context->device_list_.push_back({lite::DT_CPU, {false, lite::NO_BIND}});
+  context->thread_num_ = 1;
+  if (session.Init(context) != lite::RET_OK || session.CompileGraph(model.get()) != lite::RET_OK) {
+    return {};
+  }
+  auto output = session.GetOutputs().begin()->second;
+  EXPECT_EQ(output->shape(), std::vector<int>({kReshapeRow, kReshapeCol}));
+  auto input = session.GetInputs().front();
+  auto input_data = static_cast<float *>(input->MutableData());
+  for (int i = 0; i < input->ElementsNum(); ++i) {
+    input_data[i] = static_cast<float>(i);
+  }
+  if (session.RunGraph() != lite::RET_OK) {
+    return {};
+  }
+  auto output_data = static_cast<float *>(output->MutableData());
+  return std::vector<float>(output_data, output_data + output->ElementsNum());
+}
+}  // namespace
+
+/// Feature: Lazy weight decode
+/// Description: Decode a bit packed weight at once, and register the same weight with LazyWeightDecoder and decode it
+/// when a kernel reading it is built
+/// Expectation: The lazily decoded weight is the same as the eagerly decoded one, and it is decoded only once
+TEST_F(WeightDecoderTest, LazyDecodeSameAsEager) {
+  flatbuffers::FlatBufferBuilder fbb(1024);
+  BuildPackedWeight(&fbb);
+  auto schema_tensor = flatbuffers::GetRoot<schema::Tensor>(fbb.GetBufferPointer());
+  lite::SchemaTensorWrapper src_tensor;
+  ASSERT_TRUE(src_tensor.Init(*schema_tensor, lite::SCHEMA_VERSION::SCHEMA_CUR, ""));
+  ASSERT_TRUE(lite::WeightDecoder::NeedDecompress(src_tensor));
+
+  lite::Tensor eager(kNumberTypeInt8, {kElementNum}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  ASSERT_EQ(lite::RET_OK, lite::WeightDecoder::DecompressTensor(src_tensor, &eager));
+  ASSERT_NE(eager.data(), nullptr);
+
+  lite::Tensor lazy(kNumberTypeInt8, {kElementNum}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  lite::Tensor other(kNumberTypeFloat32, {kElementNum}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  lite::LazyWeightDecoder decoder;
+  decoder.Register(&lazy, &src_tensor);
+  EXPECT_TRUE(decoder.IsPending(&lazy));
+  EXPECT_EQ(lazy.data(), nullptr);
+  ASSERT_EQ(lite::RET_OK, decoder.Decode({&other, &lazy}));
+  EXPECT_FALSE(decoder.IsPending(&lazy));
+  EXPECT_EQ(other.data(), nullptr);
+  ASSERT_NE(lazy.data(), nullptr);
+  ASSERT_EQ(lazy.Size(), eager.Size());
+  EXPECT_EQ(0, memcmp(lazy.data(), eager.data(), eager.Size()));
+  EXPECT_EQ(decoder.decoded_size(), eager.Size());
+
+  // the second kernel reading the weight finds it decoded already
+  ASSERT_EQ(lite::RET_OK, decoder.Decode({&lazy}));
+  EXPECT_EQ(decoder.decoded_size(), eager.Size());
+  EXPECT_EQ(decoder.Clear(), 0);
+}
+
+/// Feature: Lazy weight decode
+/// Description: Compile and run a Reshape whose shape is a bit packed const input, with lazy decode off and on
+/// Expectation: The output shape is inferred at compiling in both, and the outputs are the same
+TEST_F(WeightDecoderTest, LazyDecodeBeforeInfer) {
+  flatbuffers::FlatBufferBuilder fbb(1024);
+  BuildPackedShapeReshape(&fbb);
+  auto eager = CompileAndRun(fbb, "false");
+  ASSERT_EQ(eager.size(), static_cast<size_t>(kReshapeRow * kReshapeCol));
+  auto lazy = CompileAndRun(fbb, "true");
+  EXPECT_EQ(lazy, eager);
+}
+}  // namespace mindspore
@@ -73,3 +73,4 @@ from .pyfunc import _pyfunc_cpu
 from .buffer_append import _buffer_append_cpu
 from .buffer_get import _buffer_get_cpu
 from .buffer_sample import _buffer_sample_cpu
+from .buffer_update_priority import _buffer_update_priority_cpu
@@ -119,7 +119,7 @@ from .sponge_update_ops import (ConstrainForceCycleWithVirial, RefreshUintCrd, L
                                 PMEExcludedForceUpdate, LJForceWithVirialEnergyUpdate,
                                 Dihedral14ForceWithAtomEnergyVirial, PMEEnergyUpdate,
                                 ConstrainForceVirial, ConstrainForce, Constrain)
-from .rl_ops import (BufferAppend, BufferGetItem, BufferSample)
+from .rl_ops import (BufferAppend, BufferGetItem, BufferSample, BufferUpdatePriority)
 from ._inner_ops import (MatmulDDS, DSDMatmul, NonZero)
 from .custom_ops import (Custom)
 
@@ -490,6 +490,7 @@ __all__ = [
     "BufferAppend",
     "BufferGetItem",
     "BufferSample",
+    "BufferUpdatePriority",
     "Erfinv",
     "Conj",
     "Real",
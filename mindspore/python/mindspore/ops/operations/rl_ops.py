@@ -41,6 +41,9 @@ class BufferSample(PrimitiveWithInfer):
         one in kernel. Set a number other than `0` to keep a specific seed. Default: 0.
         unique (bool): Whether the sampled data is strictly unique. Setting it to False has a better performance.
             Default: False
+        priority (bool): Whether to sample the data in proportion to their priorities, which are set by
+            `BufferAppend` and `BufferUpdatePriority` with the same `priorities`. `unique` is ignored if it is True.
+            Only supported on CPU. Default: False
 
     Inputs:
         - **data** (tuple(Parameter(Tensor))) - The tuple(Tensor) represents replaybuffer,
@@ -48,9 +51,13 @@ class BufferSample(PrimitiveWithInfer):
         - **count** (Parameter) - The count means the real available size of the buffer,
          data type: int32.
         - **head** (Parameter) - The position of the first data in buffer, data type: int32.
+        - **priorities** (Parameter) - The priorities of the buffer, only needed when `priority` is True. It is a
+         float32 tensor of shape (2 * `capacity`,) initialized with zeros.
 
     Outputs:
-        tuple(Tensor). The shape is `batch_size` * `buffer_shape`. The dtype is `buffer_dtype`.
+        tuple(Tensor). The shape is `batch_size` * `buffer_shape`. The dtype is `buffer_dtype`. When `priority` is
+        True, the int32 indexes of the sampled data in shape (`batch_size`,) follow, which are given to
+        `BufferUpdatePriority`.
 
     Raises:
         TypeError: If `buffer_shape` is not a tuple.
@@ -101,7 +108,7 @@ class BufferSample(PrimitiveWithInfer):
     """
 
     @prim_attr_register
-    def __init__(self, capacity, batch_size, buffer_shape, buffer_dtype, seed=0, unique=False):
+    def __init__(self, capacity, batch_size, buffer_shape, buffer_dtype, seed=0, unique=False, priority=False):
         """Initialize BufferSample."""
         self.init_prim_io_names(inputs=["buffer"], outputs=["sample"])
         validator.check_value_type("shape of init data", buffer_shape, [tuple, list], self.name)
@@ -114,6 +121,7 @@ class BufferSample(PrimitiveWithInfer):
         self.add_prim_attr('capacity', capacity)
         self.add_prim_attr('seed', seed)
         self.add_prim_attr('unique', unique)
+        self.add_prim_attr('priority', validator.check_value_type("priority", priority, [bool], self.name))
         buffer_elements = []
         for shape in buffer_shape:
             buffer_elements.append(reduce(lambda x, y: x * y, shape))
@@ -123,16 +131,23 @@ class BufferSample(PrimitiveWithInfer):
         if context.get_context('device_target') == "Ascend":
             self.add_prim_attr('device_target', "CPU")
 
-    def infer_shape(self, data_shape, count_shape, head_shape):
+    def infer_shape(self, data_shape, count_shape, head_shape, priorities_shape=None):
         validator.check_value_type("shape of data", data_shape, [tuple, list], self.name)
         out_shapes = []
         for i in range(self._n):
             out_shapes.append((self._batch_size,) + self._buffer_shape[i])
+        if self.priority:
+            validator.check_value_type("shape of priorities", priorities_shape, [tuple, list], self.name)
+            validator.check("priorities shape", tuple(priorities_shape), "", (2 * self.capacity,), Rel.EQ, self.name)
+            out_shapes.append((self._batch_size,))
         return tuple(out_shapes)
 
-    def infer_dtype(self, data_type, count_type, head_type):
+    def infer_dtype(self, data_type, count_type, head_type, priorities_type=None):
         validator.check_type_name("count type", count_type, (mstype.int32), self.name)
         validator.check_type_name("head type", head_type, (mstype.int32), self.name)
+        if self.priority:
+            validator.check_tensor_dtype_valid("priorities", priorities_type, (mstype.float32,), self.name)
+            return tuple(self._buffer_dtype) + (mstype.int32,)
         return tuple(self._buffer_dtype)
 
 
@@ -148,6 +163,8 @@ class BufferAppend(PrimitiveWithInfer):
         capacity (int64): Capacity of the buffer, must be non-negative.
         buffer_shape (tuple(shape)): The shape of an buffer.
         buffer_dtype (tuple(type)): The type of an buffer.
+        priority (bool): Whether to keep the priorities of the buffer for `BufferSample` with `priority`, the new
+            data gets the max priority. Only supported on CPU. Default: False
 
     Inputs:
         - **data** (tuple(Parameter(Tensor))) - The tuple(Tensor) represents replaybuffer,
@@ -157,6 +174,8 @@ class BufferAppend(PrimitiveWithInfer):
         - **count** (Parameter) - The count means the real available size of the buffer,
          data type: int32.
         - **head** (Parameter) - The position of the first data in buffer, data type: int32.
+        - **priorities** (Parameter) - The priorities of the buffer, only needed when `priority` is True. It is a
+         float32 tensor of shape (2 * `capacity`,) initialized with zeros.
 
     Outputs:
         None.
@@ -191,10 +210,11 @@ class BufferAppend(PrimitiveWithInfer):
         >>> buffer_append(buffer, batch_exp, count, head)
     """
     @prim_attr_register
-    def __init__(self, capacity, buffer_shape, buffer_dtype):
+    def __init__(self, capacity, buffer_shape, buffer_dtype, priority=False):
         """Initialize BufferAppend."""
         validator.check_int(capacity, 1, Rel.GE, "capacity", self.name)
         self.add_prim_attr('capacity', capacity)
+        self.add_prim_attr('priority', validator.check_value_type("priority", priority, [bool], self.name))
         buffer_elements = []
         for shape in buffer_shape:
             buffer_elements.append(reduce(lambda x, y: x * y, shape))
@@ -204,8 +224,11 @@ class BufferAppend(PrimitiveWithInfer):
         if context.get_context('device_target') == "Ascend":
             self.add_prim_attr('device_target', "CPU")
 
-    def infer_shape(self, data_shape, exp_shape, count_shape, head_shape):
+    def infer_shape(self, data_shape, exp_shape, count_shape, head_shape, priorities_shape=None):
         validator.check_equal_int(len(data_shape), len(exp_shape), "exp elements", self.name)
+        if self.priority:
+            validator.check_value_type("shape of priorities", priorities_shape, [tuple, list], self.name)
+            validator.check("priorities shape", tuple(priorities_shape), "", (2 * self.capacity,), Rel.EQ, self.name)
         exp_batch = 1
         if len(data_shape[0]) == len(exp_shape[0]):
             exp_batch = exp_shape[0][0]
@@ -227,7 +250,9 @@ class BufferAppend(PrimitiveWithInfer):
         self.add_prim_attr('exp_batch', exp_batch)
         return count_shape
 
-    def infer_dtype(self, data_type, exp_type, count_type, head_type):
+    def infer_dtype(self, data_type, exp_type, count_type, head_type, priorities_type=None):
+        if self.priority:
+            validator.check_tensor_dtype_valid("priorities", priorities_type, (mstype.float32,), self.name)
         for i in range(len(data_type)):
             if data_type[i] != exp_type[i]:
                 raise TypeError(f"For '{self.name}', each tensor in 'exp' must has the same type with 'data', but got "
@@ -315,3 +340,61 @@ class BufferGetItem(PrimitiveWithInfer):
         validator.check_type_name("head type", head_type, (mstype.int32), self.name)
         validator.check_type_name("index type", index_type, (mstype.int64, mstype.int32), self.name)
         return tuple(self._buffer_dtype)
+
+
+class BufferUpdatePriority(PrimitiveWithInfer):
+    r"""
+    In prioritized experience replay, updates the priorities of the sampled data, e.g. by their TD errors, so that
+    `BufferSample` with `priority` samples the data in proportion to the new priorities.
+
+    .. warning::
+        This is an experimental prototype that is subject to change and/or deletion.
+
+    Args:
+        capacity (int64): Capacity of the buffer, must be non-negative.
+
+    Inputs:
+        - **priorities** (Parameter) - The priorities of the buffer given to `BufferAppend` and `BufferSample`,
+         a float32 tensor of shape (2 * `capacity`,).
+        - **indexes** (Tensor) - The int32 indexes of the data to update, usually output by `BufferSample`.
+        - **new_priorities** (Tensor) - The non-negative float32 priorities of the data, in the shape of `indexes`.
+
+    Outputs:
+        None.
+
+    Raises:
+        ValueError: If `capacity` is not a positive integer.
+        ValueError: If the shape of `priorities` is not (2 * `capacity`,).
+        ValueError: If the shape of `new_priorities` is not the shape of `indexes`.
+
+    Supported Platforms:
+        ``CPU``
+
+    Examples:
+        >>> capacity = 100
+        >>> priorities = Parameter(Tensor(np.zeros(2 * capacity), ms.float32), name="priorities")
+        >>> indexes = Tensor(np.array([0, 1]), ms.int32)
+        >>> new_priorities = Tensor(np.array([0.5, 2.0]), ms.float32)
+        >>> buffer_update_priority = ops.BufferUpdatePriority(capacity)
+        >>> buffer_update_priority(priorities, indexes, new_priorities)
+    """
+    @prim_attr_register
+    def __init__(self, capacity):
+        """Initialize BufferUpdatePriority."""
+        validator.check_int(capacity, 1, Rel.GE, "capacity", self.name)
+        self.add_prim_attr('side_effect_mem', True)
+        if context.get_context('device_target') == "Ascend":
+            self.add_prim_attr('device_target', "CPU")
+
+    def infer_shape(self, priorities_shape, indexes_shape, new_priorities_shape):
+        validator.check("priorities shape", tuple(priorities_shape), "", (2 * self.capacity,), Rel.EQ, self.name)
+        validator.check_equal_int(len(indexes_shape), 1, "rank of indexes", self.name)
+        validator.check("new_priorities shape", tuple(new_priorities_shape), "indexes shape", tuple(indexes_shape),
+                        Rel.EQ, self.name)
+        return ()
+
+    def infer_dtype(self, priorities_type, indexes_type, new_priorities_type):
+        validator.check_tensor_dtype_valid("priorities", priorities_type, (mstype.float32,), self.name)
+        validator.check_tensor_dtype_valid("indexes", indexes_type, (mstype.int32,), self.name)
+        validator.check_tensor_dtype_valid("new_priorities", new_priorities_type, (mstype.float32,), self.name)
+        return mstype.int32
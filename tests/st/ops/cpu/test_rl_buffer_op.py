@@ -64,6 +64,30 @@ class RLBufferSample(nn.Cell):
         return self.buffer_sample(buffer, self.count, self.head)
 
 
+class RLPriorityBuffer(nn.Cell):
+    def __init__(self, capcity, batch_size, shapes, types):
+        super(RLPriorityBuffer, self).__init__()
+        self._capacity = capcity
+        self.count = Parameter(Tensor(0, ms.int32), name="count")
+        self.head = Parameter(Tensor(0, ms.int32), name="head")
+        self.priorities = Parameter(Tensor(np.zeros(2 * capcity), ms.float32), name="priorities")
+        self.buffer_append = P.BufferAppend(self._capacity, shapes, types, priority=True)
+        self.buffer_sample = P.BufferSample(self._capacity, batch_size, shapes, types, priority=True)
+        self.buffer_update_priority = P.BufferUpdatePriority(self._capacity)
+
+    @ms_function
+    def append(self, buffer, exps):
+        return self.buffer_append(buffer, exps, self.count, self.head, self.priorities)
+
+    @ms_function
+    def sample(self, buffer):
+        return self.buffer_sample(buffer, self.count, self.head, self.priorities)
+
+    @ms_function
+    def update_priority(self, indexes, new_priorities):
+        return self.buffer_update_priority(self.priorities, indexes, new_priorities)
+
+
 states = Tensor(np.arange(4*5).reshape(5, 4).astype(np.float32)/10.0)
 actions = Tensor(np.arange(2*5).reshape(5, 2).astype(np.int32))
 rewards = Tensor(np.ones((5, 1)).astype(np.int32))
@@ -144,3 +168,32 @@ def test_BufferAppend():
     np.testing.assert_almost_equal(b[1].asnumpy(), expect_a2)
     np.testing.assert_almost_equal(b[2].asnumpy(), expect_r2)
     np.testing.assert_almost_equal(b[3].asnumpy(), expect_s2_)
+
+
+@ pytest.mark.level0
+@ pytest.mark.platform_x86_cpu
+@ pytest.mark.env_onecard
+def test_BufferPrioritySample():
+    """
+    Feature: Prioritized experience replay
+    Description: Append five experiences with priority, then give the priority to one of them by BufferUpdatePriority
+    Expectation: All the experiences are sampled at first, and only the one of positive priority after the update
+    """
+    context.set_context(mode=context.PYNATIVE_MODE, device_target='CPU')
+    # One sample from each of the five equal segments of the total priority.
+    batch_size = 5
+    buffer = [Parameter(Tensor(np.zeros((5, 1)), ms.int32), name="id")]
+    priority_buffer = RLPriorityBuffer(capcity=5, batch_size=batch_size, shapes=[(1,)], types=[ms.int32])
+    for i in range(5):
+        priority_buffer.append(buffer, [Tensor(np.array([i]), ms.int32)])
+    ids, indexes = priority_buffer.sample(buffer)
+    np.testing.assert_equal(ids.asnumpy().reshape(-1), indexes.asnumpy())
+    np.testing.assert_equal(np.sort(indexes.asnumpy()), np.arange(5))
+
+    for priority_id in (3, 0):
+        new_priorities = np.zeros(5).astype(np.float32)
+        new_priorities[priority_id] = 2.0
+        priority_buffer.update_priority(Tensor(np.arange(5), ms.int32), Tensor(new_priorities))
+        ids, indexes = priority_buffer.sample(buffer)
+        np.testing.assert_equal(ids.asnumpy().reshape(-1), [priority_id] * batch_size)
+        np.testing.assert_equal(indexes.asnumpy(), [priority_id] * batch_size)
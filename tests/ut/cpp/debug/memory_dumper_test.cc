@@ -15,12 +15,17 @@
  */
 #include <fcntl.h>
 #include <iostream>
+#include <fstream>
+#include <iterator>
 #include <memory>
+#include <string>
+#include <vector>
 #include "common/common_test.h"
 #include "utils/system/file_system.h"
 #include "utils/system/env.h"
 #define private public
 #include "debug/data_dump/dump_json_parser.h"
+#include "debug/data_dump/tensor_dump_writer.h"
 #undef private
 
 namespace mindspore {
@@ -109,4 +114,35 @@ TEST_F(TestMemoryDumper, test_DumpToFileNotExistDir) {
 
   ASSERT_EQ(ret, true);
 }
+
+/// Feature: Async tensor dump
+/// Description: Dump the data to the file in the background, then change the data and flush the writer
+/// Expectation: The file holds the npy header and the data at the time of dumping
+TEST_F(TestMemoryDumper, test_DumpToFileAsync) {
+  constexpr size_t len = 1000;
+  constexpr size_t header_size = 128;
+  std::vector<int> data(len);
+  for (size_t i = 0; i < len; i++) {
+    data[i] = static_cast<int>(i % 10);
+  }
+  const std::string filename = "/tmp/dumpToFileAsyncTestFile";
+  ASSERT_TRUE(DumpJsonParser::DumpToFile(filename, data.data(), len * sizeof(int), ShapeVector{10, 100},
+                                         kNumberTypeInt32, true));
+  data.assign(len, -1);
+  TensorDumpWriter::GetInstance().Flush();
+
+  std::ifstream file(filename + ".npy", std::ios::in | std::ios::binary);
+  ASSERT_TRUE(file.is_open());
+  std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  file.close();
+  ASSERT_EQ(content.size(), header_size + len * sizeof(int));
+  auto read_back = reinterpret_cast<const int *>(content.data() + header_size);
+  for (size_t i = 0; i < len; i++) {
+    EXPECT_EQ(read_back[i], static_cast<int>(i % 10));
+  }
+  std::shared_ptr<system::FileSystem> fs = system::Env::GetFileSystem();
+  if (fs->FileExist(filename + ".npy")) {
+    fs->DeleteFile(filename + ".npy");
+  }
+}
 }  // namespace mindspore
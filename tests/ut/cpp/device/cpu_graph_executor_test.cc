@@ -0,0 +1,208 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/hardware/cpu/cpu_graph_executor.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "backend/session/anf_runtime_algorithm.h"
+
+namespace mindspore::device::cpu {
+namespace {
+constexpr size_t kElementNum = 4;
+constexpr size_t kTensorSize = kElementNum * sizeof(float);
+
+// The element-wise binary kernel of float tensors.
+class TestBinaryKernelMod : public kernel::KernelMod {
+ public:
+  explicit TestBinaryKernelMod(const std::function<float(float, float)> &op) : op_(op) {}
+  ~TestBinaryKernelMod() override = default;
+
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &,
+              const std::vector<AddressPtr> &outputs, void *) override {
+    auto x = reinterpret_cast<float *>(inputs[0]->addr);
+    auto y = reinterpret_cast<float *>(inputs[1]->addr);
+    auto output = reinterpret_cast<float *>(outputs[0]->addr);
+    for (size_t i = 0; i < kElementNum; ++i) {
+      output[i] = op_(x[i], y[i]);
+    }
+    return true;
+  }
+
+ private:
+  std::function<float(float, float)> op_;
+  std::vector<size_t> input_size_list_{kTensorSize, kTensorSize};
+  std::vector<size_t> output_size_list_{kTensorSize};
+  std::vector<size_t> workspace_size_list_;
+};
+
+class TestDeviceContext : public DeviceContext {
+ public:
+  TestDeviceContext() : DeviceContext({"CPU", 0}) {}
+  ~TestDeviceContext() override = default;
+
+  void Initialize() override {}
+  bool AllocateMemory(DeviceAddress *const &address, size_t size) const override {
+    address->set_ptr(malloc(size));
+    return address->GetPtr() != nullptr;
+  }
+  void FreeMemory(DeviceAddress *const &address) const override {
+    free(address->GetMutablePtr());
+    address->set_ptr(nullptr);
+  }
+  void *AllocateMemory(size_t size) const override { return nullptr; }
+  void FreeMemory(void *const ptr) const override {}
+  DeviceAddressPtr CreateDeviceAddress(void *const device_ptr, size_t device_size, const string &format,
+                                       TypeId type_id) const override {
+    return std::make_shared<CPUDeviceAddress>(device_ptr, device_size, format, type_id);
+  }
+  DeviceAddressType GetDeviceAddressType() const override { return DeviceAddressType::kCPU; }
+  void SetOperatorInfo(const std::vector<CNodePtr> &nodes) const override {}
+  void CreateKernel(const std::vector<CNodePtr> &nodes) const override {}
+  bool LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
+                    const std::vector<AddressPtr> &workspace, const std::vector<AddressPtr> &outputs,
+                    bool is_dynamic_shape) const override {
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    return kernel_mod->Launch(inputs, workspace, outputs, nullptr);
+  }
+};
+
+// Build the graph d = (x + y - x * y) + x, whose Add and Mul kernels are independent.
+KernelGraphPtr BuildGraph(std::vector<float> *x_data, std::vector<float> *y_data) {
+  auto graph = std::make_shared<session::KernelGraph>();
+  auto tensor_abs = std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{SizeToLong(kElementNum)});
+  auto x = graph->NewParameter(tensor_abs);
+  auto y = graph->NewParameter(tensor_abs);
+  AnfAlgo::SetOutputAddr(std::make_shared<CPUDeviceAddress>(x_data->data(), kTensorSize), 0, x.get());
+  AnfAlgo::SetOutputAddr(std::make_shared<CPUDeviceAddress>(y_data->data(), kTensorSize), 0, y.get());
+
+  auto new_kernel = [&graph, &tensor_abs](const std::string &name, const std::function<float(float, float)> &op,
+                                          const AnfNodePtr &input0, const AnfNodePtr &input1) {
+    auto kernel = graph->NewCNode({NewValueNode(std::make_shared<Primitive>(name)), input0, input1});
+    kernel->set_abstract(tensor_abs);
+    AnfAlgo::SetKernelMod(std::make_shared<TestBinaryKernelMod>(op), kernel.get());
+    AnfAlgo::SetOutputAddr(std::make_shared<CPUDeviceAddress>(nullptr, kTensorSize), 0, kernel.get());
+    return kernel;
+  };
+  auto add = new_kernel("Add", std::plus<float>(), x, y);
+  auto mul = new_kernel("Mul", std::multiplies<float>(), x, y);
+  auto sub = new_kernel("Sub", std::minus<float>(), add, mul);
+  auto output = new_kernel("Add", std::plus<float>(), sub, x);
+  graph->set_execution_order({add, mul, sub, output});
+  graph->set_output(output);
+  return graph;
+}
+
+// Launch the kernels one by one in the execution order as the kernel actors do.
+void LaunchByKernel(const KernelGraphPtr &graph, const DeviceContext *device_context) {
+  for (const auto &kernel : graph->execution_order()) {
+    std::vector<AddressPtr> inputs;
+    for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(kernel); ++i) {
+      auto device_tensor = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i, true);
+      (void)inputs.emplace_back(std::make_shared<kernel::Address>(device_tensor->GetMutablePtr(), kTensorSize));
+    }
+    auto device_tensor = AnfAlgo::GetMutableOutputAddr(kernel, 0, false);
+    ASSERT_TRUE(device_context->AllocateMemory(device_tensor.get(), kTensorSize));
+    std::vector<AddressPtr> outputs = {std::make_shared<kernel::Address>(device_tensor->GetMutablePtr(), kTensorSize)};
+    ASSERT_TRUE(device_context->LaunchKernel(kernel, inputs, {}, outputs, false));
+  }
+}
+
+std::vector<float> FetchOutput(const KernelGraphPtr &graph) {
+  auto output = reinterpret_cast<float *>(AnfAlgo::GetMutableOutputAddr(graph->output(), 0, false)->GetMutablePtr());
+  return std::vector<float>(output, output + kElementNum);
+}
+
+void FreeOutputs(const KernelGraphPtr &graph, const DeviceContext *device_context) {
+  for (const auto &kernel : graph->execution_order()) {
+    auto device_tensor = AnfAlgo::GetMutableOutputAddr(kernel, 0, false);
+    device_context->FreeMemory(device_tensor.get());
+  }
+}
+}  // namespace
+
+class TestCPUGraphExecutor : public UT::Common {
+ public:
+  TestCPUGraphExecutor() = default;
+};
+
+/// Feature: CPU graph sink
+/// Description: Test grouping the independent branches of a graph into levels
+/// Expectation: The kernels of a level only depend on the kernels of the former levels
+TEST_F(TestCPUGraphExecutor, test_build_levels) {
+  // 0 -> 1 -> 3, 0 -> 2 -> 3, 4 has no input.
+  std::vector<std::vector<size_t>> deps = {{}, {0}, {0}, {1, 2}, {}};
+  std::vector<bool> barriers(deps.size(), false);
+  auto levels = CPUGraphExecutor::BuildLevels(deps, barriers);
+  std::vector<std::vector<size_t>> expect_levels = {{0, 4}, {1, 2}, {3}};
+  EXPECT_EQ(levels, expect_levels);
+}
+
+/// Feature: CPU graph sink
+/// Description: Test grouping the kernels with side effect into levels
+/// Expectation: A barrier kernel runs alone after all the former kernels and before all the latter ones
+TEST_F(TestCPUGraphExecutor, test_build_levels_with_barrier) {
+  // 2 assigns the parameter read by 0 and 3.
+  std::vector<std::vector<size_t>> deps = {{}, {0}, {}, {}, {3}};
+  std::vector<bool> barriers = {false, false, true, false, false};
+  auto levels = CPUGraphExecutor::BuildLevels(deps, barriers);
+  std::vector<std::vector<size_t>> expect_levels = {{0}, {1}, {2}, {3}, {4}};
+  EXPECT_EQ(levels, expect_levels);
+
+  barriers = {false, false, false, true, false};
+  deps = {{}, {}, {}, {}, {}};
+  levels = CPUGraphExecutor::BuildLevels(deps, barriers);
+  expect_levels = {{0, 1, 2}, {3}, {4}};
+  EXPECT_EQ(levels, expect_levels);
+}
+
+/// Feature: CPU graph sink
+/// Description: Launch a graph with independent kernels in whole by the level schedule and kernel by kernel
+/// Expectation: The independent kernels share a level, and the graph output is the same as launched kernel by kernel
+TEST_F(TestCPUGraphExecutor, test_launch_same_as_kernel_by_kernel) {
+  std::vector<float> x_data = {1, 2, 3, 4};
+  std::vector<float> y_data = {0.5, -1, 2, 8};
+  TestDeviceContext device_context;
+
+  auto sink_graph = BuildGraph(&x_data, &y_data);
+  CPUGraphExecutor graph_executor(sink_graph);
+  EXPECT_EQ(graph_executor.level_num(), 3U);
+  ASSERT_TRUE(graph_executor.Launch(&device_context));
+  auto sink_output = FetchOutput(sink_graph);
+
+  auto actor_graph = BuildGraph(&x_data, &y_data);
+  LaunchByKernel(actor_graph, &device_context);
+  auto actor_output = FetchOutput(actor_graph);
+  std::vector<float> expect_output = {2, 5, 2, -16};
+  EXPECT_EQ(actor_output, expect_output);
+  EXPECT_EQ(sink_output, actor_output);
+
+  // The memory of the outputs is kept, and the second step reads the new inputs.
+  y_data = {1, 1, 1, 1};
+  ASSERT_TRUE(graph_executor.Launch(&device_context));
+  expect_output = {2, 3, 4, 5};
+  EXPECT_EQ(FetchOutput(sink_graph), expect_output);
+  FreeOutputs(sink_graph, &device_context);
+  FreeOutputs(actor_graph, &device_context);
+}
+}  // namespace mindspore::device::cpu
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/device/cpu/cpu_simple_mem_plan.h"
+namespace mindspore::device::cpu {
+class TestCPUSimpleMemPlan : public UT::Common {
+ public:
+  TestCPUSimpleMemPlan() = default;
+};
+
+namespace {
+CPUMemBlock MakeBlock(size_t size, size_t start, size_t end) {
+  CPUMemBlock block;
+  block.size_ = size;
+  block.start_ = start;
+  block.end_ = end;
+  return block;
+}
+
+bool Overlap(const CPUMemBlock &a, const CPUMemBlock &b, size_t a_size, size_t b_size) {
+  bool live_together = a.start_ <= b.end_ && b.start_ <= a.end_;
+  bool share_memory = a.offset_ < b.offset_ + b_size && b.offset_ < a.offset_ + a_size;
+  return live_together && share_memory;
+}
+}  // namespace
+
+/// Feature: cpu liveness based memory plan.
+/// Description: blocks whose lifetimes do not overlap.
+/// Expectation: all blocks reuse offset 0 and the plan takes the largest block only.
+TEST_F(TestCPUSimpleMemPlan, test_disjoint_lifetimes) {
+  std::vector<CPUMemBlock> blocks = {MakeBlock(1024, 0, 1), MakeBlock(512, 2, 3), MakeBlock(2048, 4, 5)};
+  auto total_size = CPUSimpleMemPlan::PlanOffsets(&blocks);
+  for (const auto &block : blocks) {
+    ASSERT_EQ(block.offset_, 0);
+  }
+  ASSERT_EQ(total_size, 2048);
+}
+
+/// Feature: cpu liveness based memory plan.
+/// Description: a chain of kernels where each output lives until the next kernel runs.
+/// Expectation: blocks alive at the same step never share memory and the plan is smaller than the naive sum.
+TEST_F(TestCPUSimpleMemPlan, test_chain_reuse) {
+  std::vector<CPUMemBlock> blocks;
+  size_t naive_size = 0;
+  constexpr size_t kBlockNum = 8;
+  constexpr size_t kBlockSize = 4096;
+  for (size_t i = 0; i < kBlockNum; ++i) {
+    size_t size = kBlockSize + i * 32;
+    blocks.push_back(MakeBlock(size, i, i + 1));
+    naive_size += size;
+  }
+  // a long lived block, e.g. a graph output
+  blocks.push_back(MakeBlock(kBlockSize, 0, kBlockNum));
+  naive_size += kBlockSize;
+
+  auto total_size = CPUSimpleMemPlan::PlanOffsets(&blocks);
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    for (size_t j = i + 1; j < blocks.size(); ++j) {
+      ASSERT_FALSE(Overlap(blocks[i], blocks[j], blocks[i].size_, blocks[j].size_));
+    }
+    ASSERT_LE(blocks[i].offset_ + blocks[i].size_, total_size);
+  }
+  ASSERT_LT(total_size, naive_size);
+}
+
+/// Feature: cpu liveness based memory plan.
+/// Description: a short lived block fits both a large gap at a low offset and a tight gap at a high offset.
+/// Expectation: the block takes the tight gap rather than the lowest offset, and the plan does not grow.
+TEST_F(TestCPUSimpleMemPlan, test_best_fit_gap) {
+  // a and c die early, leaving a 512 bytes gap at offset 0 and a 128 bytes gap at offset 768 for e
+  std::vector<CPUMemBlock> blocks = {MakeBlock(512, 0, 1), MakeBlock(256, 0, 9), MakeBlock(128, 0, 1),
+                                     MakeBlock(128, 0, 9), MakeBlock(96, 5, 6)};
+  auto total_size = CPUSimpleMemPlan::PlanOffsets(&blocks);
+  ASSERT_EQ(blocks[0].offset_, 0);
+  ASSERT_EQ(blocks[1].offset_, 512);
+  ASSERT_EQ(blocks[2].offset_, 768);
+  ASSERT_EQ(blocks[3].offset_, 896);
+  ASSERT_EQ(blocks[4].offset_, 768);
+  ASSERT_EQ(total_size, 1024);
+}
+}  // namespace mindspore::device::cpu
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/device/cpu/cpu_tensor_array.h"
+
+namespace mindspore::device::cpu {
+namespace {
+constexpr size_t kElementNum = 2;
+constexpr int64_t kWriteNum = 100;
+
+std::vector<float> Element(int64_t index) { return std::vector<float>(kElementNum, static_cast<float>(index)); }
+}  // namespace
+
+class TestCPUTensorArray : public UT::Common {
+ public:
+  TestCPUTensorArray() = default;
+};
+
+/// Feature: CPU TensorArray
+/// Description: Append elements until the TensorArray grows several times, skip some positions and stack all of them
+/// Expectation: The element addresses read before growing stay valid, the skipped positions are zeros and the
+/// stacked values are the same as the ones written
+TEST_F(TestCPUTensorArray, test_write_grow_and_stack) {
+  CPUTensorArray tensor_array("TestTensorArray", kFloat32, {kElementNum});
+  auto value = Element(0);
+  ASSERT_TRUE(tensor_array.WriteValue(0, value.data(), value.size() * sizeof(float)));
+  auto first = tensor_array.Read(0);
+  auto first_addr = first->addr;
+  for (int64_t i = 1; i < kWriteNum; ++i) {
+    // The middle position is skipped, which is filled with zeros.
+    if (i == kWriteNum / 2) {
+      continue;
+    }
+    value = Element(i);
+    ASSERT_TRUE(tensor_array.WriteValue(i, value.data(), value.size() * sizeof(float)));
+  }
+  EXPECT_EQ(tensor_array.GetValidSize(), LongToSize(kWriteNum));
+  EXPECT_EQ(tensor_array.GetRealSize(), LongToSize(kWriteNum));
+  EXPECT_EQ(tensor_array.Read(0)->addr, first_addr);
+  EXPECT_EQ(tensor_array.GetTensorAddr(0), first_addr);
+
+  std::vector<float> stacked(LongToSize(kWriteNum) * kElementNum);
+  ASSERT_TRUE(tensor_array.StackValues(stacked.data(), stacked.size() * sizeof(float)));
+  for (int64_t i = 0; i < kWriteNum; ++i) {
+    auto expect = (i == kWriteNum / 2) ? Element(0) : Element(i);
+    std::vector<float> element(stacked.begin() + i * kElementNum, stacked.begin() + (i + 1) * kElementNum);
+    EXPECT_EQ(element, expect);
+  }
+  // The output which can't hold all the valid elements is rejected.
+  EXPECT_FALSE(tensor_array.StackValues(stacked.data(), kElementNum * sizeof(float)));
+
+  tensor_array.Clear();
+  EXPECT_EQ(tensor_array.GetValidSize(), 0U);
+  EXPECT_EQ(tensor_array.GetRealSize(), LongToSize(kWriteNum));
+  tensor_array.Free();
+  EXPECT_EQ(tensor_array.GetRealSize(), 0U);
+}
+
+/// Feature: CPU TensorArray
+/// Description: Append elements in one thread while reading the first element and the sizes in another one
+/// Expectation: The reader always gets the first element and a valid size no more than the elements written
+TEST_F(TestCPUTensorArray, test_read_while_growing) {
+  CPUTensorArray tensor_array("TestTensorArray", kFloat32, {kElementNum});
+  auto first = Element(1);
+  ASSERT_TRUE(tensor_array.WriteValue(0, first.data(), first.size() * sizeof(float)));
+  auto first_addr = tensor_array.GetTensorAddr(0);
+
+  std::thread writer([&tensor_array]() {
+    for (int64_t i = 1; i < kWriteNum; ++i) {
+      auto value = Element(i);
+      EXPECT_TRUE(tensor_array.WriteValue(i, value.data(), value.size() * sizeof(float)));
+    }
+  });
+  for (int64_t i = 0; i < kWriteNum; ++i) {
+    std::vector<float> output(kElementNum);
+    EXPECT_TRUE(tensor_array.ReadValue(0, output.data(), output.size() * sizeof(float)));
+    EXPECT_EQ(output, first);
+    EXPECT_LE(tensor_array.GetValidSize(), LongToSize(kWriteNum));
+    EXPECT_EQ(tensor_array.GetTensorAddr(0), first_addr);
+  }
+  writer.join();
+  EXPECT_EQ(tensor_array.GetValidSize(), LongToSize(kWriteNum));
+  tensor_array.Free();
+}
+}  // namespace mindspore::device::cpu
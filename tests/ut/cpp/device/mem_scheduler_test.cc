@@ -16,6 +16,7 @@
 
 #include <vector>
 #include <map>
+#include <numeric>
 #include "common/common_test.h"
 #include "runtime/device/memory_scheduler.h"
 namespace mindspore::device {
@@ -232,4 +233,76 @@ TEST_F(TestMemScheduler, test_manual_mem_scheduler) {
   // run
   Run(scheduler);
 }
-}  // namespace mindspore::device
\ No newline at end of file
+
+/// Feature: MemDiskSwap
+/// Description: Test writing and reading back the host memory with the swap file
+/// Expectation: The data read back equal the data written, and released file space is reused
+TEST_F(TestMemScheduler, test_mem_disk_swap) {
+  MemDiskSwap disk_swap("mem_disk_swap_test.bin");
+  ASSERT_TRUE(disk_swap.Init());
+  constexpr size_t kKeyNum = 3;
+  constexpr size_t kDataSize = 5000;
+  std::vector<uint8_t> keys(kKeyNum, 0);
+  std::vector<std::vector<uint8_t>> datas(kKeyNum, std::vector<uint8_t>(kDataSize));
+  for (size_t i = 0; i < kKeyNum; ++i) {
+    std::iota(datas[i].begin(), datas[i].end(), static_cast<uint8_t>(i));
+    disk_swap.AsyncWrite(keys.data() + i, datas[i].data(), kDataSize);
+  }
+  std::vector<uint8_t> read_data(kDataSize, 0);
+  for (size_t i = 0; i < kKeyNum; ++i) {
+    disk_swap.AsyncRead(keys.data() + i, read_data.data(), kDataSize);
+    ASSERT_TRUE(disk_swap.Wait(keys.data() + i));
+    ASSERT_TRUE(disk_swap.IsDone(keys.data() + i));
+    ASSERT_EQ(read_data, datas[i]);
+  }
+  auto file_size = disk_swap.file_size();
+  disk_swap.Release(keys.data());
+  disk_swap.AsyncWrite(keys.data(), datas[0].data(), kDataSize);
+  ASSERT_TRUE(disk_swap.Wait(keys.data()));
+  ASSERT_EQ(disk_swap.file_size(), file_size);
+  disk_swap.Clear();
+  ASSERT_EQ(disk_swap.file_size(), 0);
+}
+
+/// Feature: MemScheduler
+/// Description: Test MemScheduler spilling all the swapped out memory to disk
+/// Expectation: MemScheduler GetOrMalloc return valid ptr
+TEST_F(TestMemScheduler, test_disk_swap_mem_scheduler) {
+  MemSchedulerManager mem_scheduler_manager;
+  auto scheduler = mem_scheduler_manager.GetOrCreateMemScheduler(0);
+  ASSERT_NE(scheduler, nullptr);
+  std::shared_ptr<MemHandler> mem_handler = std::make_shared<MemHandlerImpl>();
+  ASSERT_NE(mem_handler, nullptr);
+  scheduler->SetMemHandler(mem_handler);
+  ASSERT_TRUE(scheduler->SetDiskSwap("mem_scheduler_disk_swap_test.bin", 0));
+
+  // input data
+  used_tensor_num_ = 10;
+  total_step_ = 8;
+  std::vector<uint8_t> tensor_keys(used_tensor_num_, 0);
+  std::vector<uint8_t> tensor_datas(used_tensor_num_, 0);
+  std::vector<size_t> init_tensors = {0, 2, 4};
+  std::vector<size_t> offload_tensor = {1, 2, 3};
+  // same tensor usage as test_manual_mem_scheduler
+  std::vector<std::vector<size_t>> step_used_tensors = {{0, 1},    {1, 2, 3}, {3, 4, 5}, {5, 6},
+                                                        {4, 6, 7}, {3, 7, 8}, {2, 8, 9}, {1, 9}};
+  tensor_keys_.swap(tensor_keys);
+  tensor_datas_.swap(tensor_datas);
+  init_tensors_.swap(init_tensors);
+  step_used_tensors_.swap(step_used_tensors);
+  scheduler->SetTotalStep(total_step_);
+
+  // set offload key
+  for (auto index : offload_tensor) {
+    scheduler->SetOffload(tensor_keys_.data() + index);
+  }
+  // record
+  Record(scheduler);
+  // optimize
+  scheduler->Optimize();
+  // run twice, the second run reuses the file space of the first one
+  Run(scheduler);
+  Run(scheduler);
+  scheduler->ClearAllocatedMem();
+}
+}  // namespace mindspore::device
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/framework/actor/memory_manager_actor.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+
+namespace mindspore::runtime {
+namespace {
+constexpr size_t kThrowSize = 3;
+
+// Fails the allocation above the limit and throws for kThrowSize, as a memory pool running out of memory may do.
+class TestDeviceContext : public device::DeviceContext {
+ public:
+  explicit TestDeviceContext(size_t limit) : DeviceContext({"CPU", 0}), limit_(limit) {}
+  ~TestDeviceContext() override = default;
+
+  void Initialize() override {}
+  bool AllocateMemory(DeviceAddress *const &address, size_t size) const override {
+    if (size == kThrowSize) {
+      throw std::runtime_error("Out of memory.");
+    }
+    if (size > limit_) {
+      return false;
+    }
+    address->set_ptr(malloc(size));
+    ++alloc_count_;
+    return true;
+  }
+  void FreeMemory(DeviceAddress *const &address) const override {
+    free(address->GetMutablePtr());
+    address->set_ptr(nullptr);
+  }
+  void *AllocateMemory(size_t size) const override { return nullptr; }
+  void FreeMemory(void *const ptr) const override {}
+  bool IsMemoryAllocThreadSafe() const override { return true; }
+  DeviceAddressPtr CreateDeviceAddress(void *const device_ptr, size_t device_size, const string &format,
+                                       TypeId type_id) const override {
+    return std::make_shared<device::cpu::CPUDeviceAddress>(device_ptr, device_size, format, type_id);
+  }
+  DeviceAddressType GetDeviceAddressType() const override { return DeviceAddressType::kCPU; }
+  void SetOperatorInfo(const std::vector<CNodePtr> &nodes) const override {}
+  void CreateKernel(const std::vector<CNodePtr> &nodes) const override {}
+
+  size_t alloc_count() const { return alloc_count_; }
+
+ private:
+  size_t limit_;
+  mutable size_t alloc_count_{0};
+};
+}  // namespace
+
+class TestMemoryManagerActor : public UT::Common {
+ public:
+  TestMemoryManagerActor() = default;
+};
+
+/// Feature: Memory allocation in the kernel actor thread
+/// Description: Allocate a list in the actor thread which fits the memory, has an allocated tensor, runs out of memory
+/// and throws on the allocation
+/// Expectation: The list is allocated only if all allocations succeed, otherwise false is returned without throwing
+/// and the rest of the list is left to the memory manager actor
+TEST_F(TestMemoryManagerActor, test_try_allocate_memory) {
+  constexpr size_t kLimit = 16;
+  TestDeviceContext device_context(kLimit);
+  device::cpu::CPUDeviceAddress allocated(nullptr, 8);
+  device_context.AllocateMemory(&allocated, 8);
+  device::cpu::CPUDeviceAddress small(nullptr, 4);
+  device::cpu::CPUDeviceAddress large(nullptr, kLimit + 1);
+  device::cpu::CPUDeviceAddress throwing(nullptr, kThrowSize);
+
+  std::vector<DeviceTensor *> fit_list = {&allocated, &small};
+  EXPECT_TRUE(MemoryManagerActor::TryAllocateMemory(fit_list, &device_context));
+  EXPECT_NE(small.GetPtr(), nullptr);
+  // The allocated tensor is skipped.
+  EXPECT_EQ(device_context.alloc_count(), 2);
+
+  device_context.FreeMemory(&small);
+  std::vector<DeviceTensor *> out_of_memory_list = {&small, &large, &throwing};
+  EXPECT_FALSE(MemoryManagerActor::TryAllocateMemory(out_of_memory_list, &device_context));
+  EXPECT_NE(small.GetPtr(), nullptr);
+  EXPECT_EQ(large.GetPtr(), nullptr);
+  EXPECT_EQ(throwing.GetPtr(), nullptr);
+
+  std::vector<DeviceTensor *> throwing_list = {&throwing};
+  EXPECT_FALSE(MemoryManagerActor::TryAllocateMemory(throwing_list, &device_context));
+  EXPECT_EQ(throwing.GetPtr(), nullptr);
+
+  device_context.FreeMemory(&allocated);
+  device_context.FreeMemory(&small);
+}
+}  // namespace mindspore::runtime
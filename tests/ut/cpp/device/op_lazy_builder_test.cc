@@ -0,0 +1,172 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "base/core_ops.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "runtime/framework/graph_compiler.h"
+#include "runtime/op_builder/op_lazy_builder.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "utils/ms_context.h"
+#include "utils/utils.h"
+
+namespace mindspore::runtime {
+namespace {
+constexpr int64_t kElementNum = 4;
+
+// Selects the default format and float32 for the kernels, so the single op graphs get their device addresses.
+class TestDeviceContext : public device::DeviceContext {
+ public:
+  TestDeviceContext() : DeviceContext({"CPU", 0}) {}
+  ~TestDeviceContext() override = default;
+
+  void Initialize() override {}
+  bool AllocateMemory(DeviceAddress *const &address, size_t size) const override { return false; }
+  void FreeMemory(DeviceAddress *const &address) const override {}
+  void *AllocateMemory(size_t size) const override { return nullptr; }
+  void FreeMemory(void *const ptr) const override {}
+  DeviceAddressPtr CreateDeviceAddress(void *const device_ptr, size_t device_size, const string &format,
+                                       TypeId type_id) const override {
+    return std::make_shared<device::cpu::CPUDeviceAddress>(device_ptr, device_size, format, type_id);
+  }
+  DeviceAddressType GetDeviceAddressType() const override { return DeviceAddressType::kCPU; }
+  void UnifyMindIR(const KernelGraphPtr &graph) const override {}
+  void OptimizeSingleOpGraph(const KernelGraphPtr &graph) const override {
+    MS_EXCEPTION_IF_NULL(graph);
+    for (const auto &kernel : graph->execution_order()) {
+      auto input_num = AnfAlgo::GetInputTensorNum(kernel);
+      kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+      builder.SetInputsFormat(std::vector<std::string>(input_num, kOpFormat_DEFAULT));
+      builder.SetInputsDeviceType(std::vector<TypeId>(input_num, kNumberTypeFloat32));
+      builder.SetOutputsFormat({kOpFormat_DEFAULT});
+      builder.SetOutputsDeviceType({kNumberTypeFloat32});
+      AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), kernel.get());
+    }
+  }
+  void SetOperatorInfo(const std::vector<CNodePtr> &nodes) const override {}
+  void CreateKernel(const std::vector<CNodePtr> &nodes) const override {}
+};
+
+KernelGraphPtr NewGraph(GraphId graph_id) {
+  auto graph = std::make_shared<session::KernelGraph>();
+  graph->set_graph_id(graph_id);
+  return graph;
+}
+
+std::shared_ptr<OpTask> NewRunTask(const KernelGraphPtr &graph, const session::OpRunInfo &op_run_info) {
+  auto context = std::make_shared<OpLazyBuilderContext>(nullptr, graph, std::vector<session::KernelWithIndex>(),
+                                                        op_run_info, nullptr, false);
+  return std::make_shared<OpRunTask>(context);
+}
+
+// The run info of the single op Add with two float32 inputs.
+session::OpRunInfo AddRunInfo(const PrimitivePtr &prim) {
+  session::OpRunInfo op_run_info;
+  op_run_info.op_name = prim->name();
+  op_run_info.primitive = prim.get();
+  op_run_info.abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{kElementNum});
+  op_run_info.lazy_build = true;
+  op_run_info.graph_info = "TestAdd";
+  op_run_info.device_target = kCPUDevice;
+  for (size_t i = 0; i < 2; ++i) {
+    (void)op_run_info.input_tensors.emplace_back(
+      std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{kElementNum}));
+    (void)op_run_info.tensor_mask.emplace_back(kParameterDataTensorMask);
+  }
+  return op_run_info;
+}
+}  // namespace
+
+class TestOpLazyBuilder : public UT::Common {
+ public:
+  TestOpLazyBuilder() = default;
+  void SetUp() override { OpLazyBuilder::GetInstance().Reset(); }
+  void TearDown() override { OpLazyBuilder::GetInstance().Reset(); }
+};
+
+/// Feature: PyNative lazy build
+/// Description: Push the run tasks of two graphs, one of which is queued twice, and pop them one by one
+/// Expectation: A graph is pending until its last run task is popped, and resetting the builder clears all the graphs
+TEST_F(TestOpLazyBuilder, test_push_and_pop_run_tasks) {
+  auto &op_lazy_builder = OpLazyBuilder::GetInstance();
+  session::OpRunInfo op_run_info;
+  auto graph_a = NewGraph(0);
+  auto graph_b = NewGraph(1);
+  op_lazy_builder.PushOpRunTask(NewRunTask(graph_a, op_run_info));
+  op_lazy_builder.PushOpRunTask(NewRunTask(graph_a, op_run_info));
+  op_lazy_builder.PushOpRunTask(NewRunTask(graph_b, op_run_info));
+  EXPECT_TRUE(op_lazy_builder.IsGraphPending(0));
+  EXPECT_TRUE(op_lazy_builder.IsGraphPending(1));
+  EXPECT_FALSE(op_lazy_builder.IsGraphPending(2));
+
+  // The second run task of graph a is still queued.
+  op_lazy_builder.PopOpRunTask();
+  EXPECT_TRUE(op_lazy_builder.IsGraphPending(0));
+  op_lazy_builder.PopOpRunTask();
+  EXPECT_FALSE(op_lazy_builder.IsGraphPending(0));
+  EXPECT_TRUE(op_lazy_builder.IsGraphPending(1));
+  op_lazy_builder.PopOpRunTask();
+  EXPECT_FALSE(op_lazy_builder.IsGraphPending(1));
+  EXPECT_TRUE(op_lazy_builder.QueueEmpty());
+  // Popping the empty queue does nothing.
+  EXPECT_NO_THROW(op_lazy_builder.PopOpRunTask());
+
+  op_lazy_builder.PushOpRunTask(NewRunTask(graph_a, op_run_info));
+  op_lazy_builder.Reset();
+  EXPECT_FALSE(op_lazy_builder.IsGraphPending(0));
+  EXPECT_TRUE(op_lazy_builder.QueueEmpty());
+}
+
+/// Feature: PyNative lazy build
+/// Description: Compile the same single op while the run task of its cached graph or of another graph is queued
+/// Expectation: The cached graph is reused unless its own run task is queued, when a new graph is compiled instead
+TEST_F(TestOpLazyBuilder, test_compile_single_op_graph_while_queued) {
+  auto &op_lazy_builder = OpLazyBuilder::GetInstance();
+  TestDeviceContext device_context;
+  GraphCompiler graph_compiler;
+  auto prim = std::make_shared<Primitive>(prim::kPrimAdd->name());
+  auto op_run_info = AddRunInfo(prim);
+
+  bool cache_hit = true;
+  auto first_id = graph_compiler.CompileGraph(op_run_info, &cache_hit, &device_context);
+  EXPECT_FALSE(cache_hit);
+  EXPECT_EQ(graph_compiler.CompileGraph(op_run_info, &cache_hit, &device_context), first_id);
+  EXPECT_TRUE(cache_hit);
+
+  // The queued graph can't be shared, whose outputs would be overwritten by the latter op before it runs.
+  auto first_graph = graph_compiler.Fetch(op_run_info.graph_info);
+  ASSERT_NE(first_graph, nullptr);
+  op_lazy_builder.PushOpRunTask(NewRunTask(first_graph, op_run_info));
+  auto second_id = graph_compiler.CompileGraph(op_run_info, &cache_hit, &device_context);
+  EXPECT_FALSE(cache_hit);
+  EXPECT_NE(second_id, first_id);
+  auto second_graph = graph_compiler.Fetch(op_run_info.graph_info);
+  ASSERT_NE(second_graph, nullptr);
+  EXPECT_EQ(second_graph->graph_id(), second_id);
+  EXPECT_NE(AnfAlgo::GetMutableOutputAddr(second_graph->execution_order()[0], 0),
+            AnfAlgo::GetMutableOutputAddr(first_graph->execution_order()[0], 0));
+
+  // The new cached graph is reused while only the former one is queued, as well as after the queue is run.
+  EXPECT_EQ(graph_compiler.CompileGraph(op_run_info, &cache_hit, &device_context), second_id);
+  EXPECT_TRUE(cache_hit);
+  op_lazy_builder.PopOpRunTask();
+  EXPECT_EQ(graph_compiler.CompileGraph(op_run_info, &cache_hit, &device_context), second_id);
+  EXPECT_TRUE(cache_hit);
+}
+}  // namespace mindspore::runtime
@@ -0,0 +1,132 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "utils/convert_utils_base.h"
+#include "distributed/persistent/storage/local_file.h"
+
+namespace mindspore {
+namespace distributed {
+namespace storage {
+namespace {
+constexpr int kRowNum = 10;
+constexpr int kColNum = 4;
+// Two rows of both the inputs are in one block, so the inputs are split into five blocks.
+constexpr size_t kBlockNum = 5;
+constexpr char kBlockLength[] = "64";
+constexpr char kStoragePath[] = "./local_file_test_storage";
+}  // namespace
+
+class TestLocalFile : public UT::Common {
+ public:
+  TestLocalFile() = default;
+
+  void SetUp() override {
+    RemoveStorage();
+    FileIOUtils::CreateDir(kStoragePath);
+    config_[kFileStoragePath] = kStoragePath;
+    config_[kMaxBlockLength] = kBlockLength;
+  }
+
+  void TearDown() override { RemoveStorage(); }
+
+  // Read all the blocks into two tensors by a new LocalFile, which loads the block files and meta files from disk.
+  std::vector<std::vector<int>> ReadBack() {
+    std::vector<std::vector<int>> outputs(2, std::vector<int>(kRowNum * kColNum, 0));
+    LocalFile local_file(config_);
+    local_file.Read(std::vector<OutputData>{{outputs[0].data(), outputs[0].size() * sizeof(int)},
+                                            {outputs[1].data(), outputs[1].size() * sizeof(int)}});
+    return outputs;
+  }
+
+  static void RemoveStorage() {
+    for (size_t i = 0; i < kBlockNum; ++i) {
+      (void)remove(BlockFileName(i).c_str());
+      (void)remove(BlockMetaFileName(i).c_str());
+    }
+    (void)rmdir(kStoragePath);
+  }
+
+  static std::string BlockFileName(size_t index) {
+    return std::string(kStoragePath) + "/" + kBlockFilePrefix + std::to_string(index);
+  }
+
+  static std::string BlockMetaFileName(size_t index) {
+    return std::string(kStoragePath) + "/" + kBlockMetaFilePrefix + std::to_string(index) + kJsonSuffix;
+  }
+
+  std::map<std::string, std::string> config_;
+};
+
+/// Feature: LocalFile
+/// Description: Write two tensors to several blocks in the background and modify the inputs at once, then rewrite one
+/// dirty row and read the blocks back by new LocalFile objects
+/// Expectation: The block files and block meta files are created, and the data read back is the data at the time of
+/// each write
+TEST_F(TestLocalFile, test_write_and_read_back) {
+  std::vector<int> conv(kRowNum * kColNum);
+  std::vector<int> fc(kRowNum * kColNum);
+  for (size_t i = 0; i < conv.size(); ++i) {
+    conv[i] = SizeToInt(i);
+    fc[i] = SizeToInt(i) + kRowNum * kColNum;
+  }
+  auto expect_conv = conv;
+  auto expect_fc = fc;
+  std::vector<InputData> inputs = {{{kRowNum, kColNum}, conv.data(), conv.size() * sizeof(int)},
+                                   {{kRowNum, kColNum}, fc.data(), fc.size() * sizeof(int)}};
+
+  LocalFile local_file(config_);
+  auto persist_future = local_file.WriteAsync(inputs);
+  // The blocks are copied before the persistence returns, so the inputs can be modified during the persistence.
+  std::fill(conv.begin(), conv.end(), -1);
+  std::fill(fc.begin(), fc.end(), -1);
+  persist_future.get();
+  for (size_t i = 0; i < kBlockNum; ++i) {
+    EXPECT_TRUE(FileIOUtils::IsFileOrDirExist(BlockFileName(i)));
+    EXPECT_TRUE(FileIOUtils::IsFileOrDirExist(BlockMetaFileName(i)));
+  }
+  EXPECT_FALSE(FileIOUtils::IsFileOrDirExist(BlockFileName(kBlockNum)));
+  auto outputs = ReadBack();
+  EXPECT_EQ(outputs[0], expect_conv);
+  EXPECT_EQ(outputs[1], expect_fc);
+
+  // Only the block holding the dirty row is rewritten, the others keep the data of the former write.
+  const int dirty_row = 7;
+  // The inputs are refilled in place, because they are written through the pointers in the input data.
+  (void)std::copy(expect_conv.begin(), expect_conv.end(), conv.begin());
+  (void)std::copy(expect_fc.begin(), expect_fc.end(), fc.begin());
+  for (int col = 0; col < kColNum; ++col) {
+    conv[dirty_row * kColNum + col] = -2;
+    fc[dirty_row * kColNum + col] = -3;
+  }
+  expect_conv = conv;
+  expect_fc = fc;
+  // The row out of the dirty information is not written.
+  conv[0] = -4;
+  local_file.Write(inputs, {dirty_row});
+  outputs = ReadBack();
+  EXPECT_EQ(outputs[0], expect_conv);
+  EXPECT_EQ(outputs[1], expect_fc);
+}
+}  // namespace storage
+}  // namespace distributed
+}  // namespace mindspore
@@ -18,8 +18,10 @@
 #include <sys/types.h>
 #include <dirent.h>
 #include <atomic>
+#include <chrono>
 #include <string>
 #include <thread>
+#include <vector>
 #include <csignal>
 
 #include <gtest/gtest.h>
@@ -27,6 +29,7 @@
 #include "actor/iomgr.h"
 #include "async/async.h"
 #include "distributed/rpc/tcp/tcp_comm.h"
+#include "distributed/rpc/tcp/connection_pool.h"
 #include "common/common_test.h"
 
 namespace mindspore {
@@ -257,6 +260,76 @@ TEST_F(TCPTest, send1Msg) {
   shutdownTcpServer(pid1);
   pid1 = 0;
 }
+std::atomic<int> g_multi_loop_recv_num(0);
+
+class TCPMultiLoopTest : public UT::Common {
+ public:
+  TCPMultiLoopTest() = default;
+};
+
+/// Feature: test sending and receiving tcp messages over several event loops.
+/// Description: start a socket server on all the addresses, and send messages to it by the hosts of different
+/// connection pools from several threads.
+/// Expectation: all the messages are received, and each connection is guarded by the pool of its event loops.
+TEST_F(TCPMultiLoopTest, SendRecvOnMultiLoops) {
+  g_multi_loop_recv_num = 0;
+  std::unique_ptr<TCPComm> io = std::make_unique<TCPComm>();
+  ASSERT_TRUE(io->Initialize());
+  io->SetMessageHandler([](std::unique_ptr<MessageBase> &&msg) {
+    if (msg->GetType() != MessageBase::Type::KEXIT) {
+      g_multi_loop_recv_num++;
+    }
+  });
+  const std::string port = "2227";
+  ASSERT_TRUE(io->StartServerSocket("tcp://0.0.0.0:" + port, "tcp://127.0.0.1:" + port));
+
+  // The loopback addresses of another connection pool, if there are several pools.
+  std::vector<std::string> hosts = {"127.0.0.1"};
+  for (int i = 2; i < 255; ++i) {
+    std::string host = "127.0.0." + std::to_string(i);
+    if (ConnectionPool::GetPoolIndex(host) != ConnectionPool::GetPoolIndex(hosts[0])) {
+      hosts.push_back(host);
+      break;
+    }
+  }
+
+  const int thread_num = 4;
+  const int msg_num = 50;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < thread_num; ++i) {
+    threads.emplace_back([&io, &hosts, &port, i]() {
+      for (int j = 0; j < msg_num; ++j) {
+        std::unique_ptr<MessageBase> message = std::make_unique<MessageBase>();
+        message->name = "testname";
+        message->from = AID("client", "tcp://127.0.0.1:" + port);
+        message->to = AID("testserver", "tcp://" + hosts[(i + j) % hosts.size()] + ":" + port);
+        message->body = std::string(j + 1, 'A');
+        io->Send(std::move(message));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  const int expect_num = thread_num * msg_num;
+  const int timeout_ms = 5000;
+  const int interval_ms = 100;
+  for (int waited = 0; g_multi_loop_recv_num < expect_num && waited < timeout_ms; waited += interval_ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+  }
+  EXPECT_EQ(g_multi_loop_recv_num, expect_num);
+
+  for (auto conn_pool : ConnectionPool::GetConnectionPools()) {
+    std::lock_guard<std::mutex> lock(conn_pool->mutex_);
+    for (auto conns : {&conn_pool->local_conns_, &conn_pool->remote_conns_}) {
+      for (const auto &item : *conns) {
+        EXPECT_EQ(item.second->conn_pool, conn_pool);
+      }
+    }
+  }
+  io->Finalize();
+}
 }  // namespace rpc
 }  // namespace distributed
 }  // namespace mindspore
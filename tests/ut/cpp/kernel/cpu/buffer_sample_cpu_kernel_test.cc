@@ -0,0 +1,175 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <algorithm>
+#include <set>
+#include <iterator>
+#include <numeric>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/rl/buffer_sample_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/rl/buffer_append_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/rl/buffer_update_priority_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+constexpr size_t kCapacity = 1000;
+constexpr size_t kBatchSize = 64;
+class BufferSampleCpuKernelTest : public UT::Common {
+ public:
+  BufferSampleCpuKernelTest() : sample_(std::make_shared<BufferCPUSampleKernel>()) {}
+
+  void SetUp() override {
+    buffer_.resize(kCapacity);
+    std::iota(buffer_.begin(), buffer_.end(), 0);
+    output_.resize(kBatchSize, -1);
+    count_ = SizeToInt(kCapacity);
+    head_ = 0;
+    sample_->element_nums_ = 1;
+    sample_->capacity_ = SizeToLong(kCapacity);
+    sample_->batch_size_ = kBatchSize;
+    sample_->exp_element_list = {sizeof(int)};
+    sample_->generator_.seed(1);
+    inputs_.clear();
+    workspace_.clear();
+    outputs_.clear();
+  }
+
+  AddressPtr CreateKernelAddress(void *addr) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    return kernel_addr;
+  }
+
+  void CreateAddress() {
+    inputs_.push_back(CreateKernelAddress(buffer_.data()));
+    inputs_.push_back(CreateKernelAddress(&count_));
+    inputs_.push_back(CreateKernelAddress(&head_));
+    outputs_.push_back(CreateKernelAddress(output_.data()));
+  }
+
+  std::vector<int> buffer_;
+  std::vector<int> output_;
+  int count_{0};
+  int head_{0};
+  std::vector<AddressPtr> inputs_;
+  std::vector<AddressPtr> workspace_;
+  std::vector<AddressPtr> outputs_;
+  std::shared_ptr<BufferCPUSampleKernel> sample_;
+};
+
+/// Feature: SumTree
+/// Description: Test updating the priorities and finding the slot of a prefix sum
+/// Expectation: The slot whose priority range contains the prefix sum is found, zero priorities are never found
+TEST_F(BufferSampleCpuKernelTest, test_sum_tree) {
+  // The capacity is not a power of two, whose leaves are met in the order of 3, 4, 0, 1, 2.
+  std::vector<float> priorities(10, 0.0f);
+  SumTree sum_tree(priorities.data(), 5);
+  EXPECT_FLOAT_EQ(sum_tree.Max(), 1.0f);
+  sum_tree.Update(0, 1.0f);
+  sum_tree.Update(2, 2.0f);
+  sum_tree.Update(4, 3.0f);
+  EXPECT_FLOAT_EQ(sum_tree.Total(), 6.0f);
+  EXPECT_FLOAT_EQ(sum_tree.Max(), 3.0f);
+  EXPECT_EQ(sum_tree.Find(0.5f), 4U);
+  EXPECT_EQ(sum_tree.Find(3.5f), 0U);
+  EXPECT_EQ(sum_tree.Find(4.5f), 2U);
+  EXPECT_EQ(sum_tree.Find(6.0f), 2U);
+  sum_tree.Update(2, 0.0f);
+  EXPECT_FLOAT_EQ(sum_tree.Total(), 4.0f);
+  EXPECT_EQ(sum_tree.Find(5.0f), 0U);
+  // The max priority is kept in the tensor, so another tree on it sees the same priorities.
+  SumTree other(priorities.data(), 5);
+  EXPECT_FLOAT_EQ(other.Max(), 3.0f);
+  EXPECT_FLOAT_EQ(other.GetPriority(4), 3.0f);
+}
+
+/// Feature: BufferSample
+/// Description: Test unique sampling from the buffer
+/// Expectation: The sampled data are unique and all from the buffer
+TEST_F(BufferSampleCpuKernelTest, test_unique_sample) {
+  sample_->unique_ = true;
+  CreateAddress();
+  ASSERT_TRUE(sample_->Launch(inputs_, workspace_, outputs_));
+  std::set<int> sampled(output_.begin(), output_.end());
+  EXPECT_EQ(sampled.size(), kBatchSize);
+  EXPECT_GE(*sampled.begin(), 0);
+  EXPECT_LT(*sampled.rbegin(), count_);
+
+  // The whole buffer is a permutation when the batch size equals the count.
+  count_ = SizeToInt(kBatchSize);
+  ASSERT_TRUE(sample_->Launch(inputs_, workspace_, outputs_));
+  sampled = std::set<int>(output_.begin(), output_.end());
+  EXPECT_EQ(sampled.size(), kBatchSize);
+  EXPECT_EQ(*sampled.rbegin(), count_ - 1);
+}
+
+/// Feature: BufferSample
+/// Description: Test sampling with the priorities appended by BufferAppend and updated by BufferUpdatePriority
+/// Expectation: Only the slots appended with priority are sampled, in proportion to the priorities, and the sampled
+/// indexes are output
+TEST_F(BufferSampleCpuKernelTest, test_priority_sample) {
+  auto append = std::make_shared<BufferCPUAppendKernel>();
+  append->element_nums_ = 1;
+  append->capacity_ = SizeToLong(kCapacity);
+  append->exp_batch_ = 2;
+  append->exp_element_list = {sizeof(int)};
+  append->priority_ = true;
+  std::vector<int> exp = {-1, -2};
+  std::vector<float> priorities(2 * kCapacity, 0.0f);
+  count_ = 0;
+  head_ = 0;
+  std::vector<AddressPtr> append_inputs = {CreateKernelAddress(buffer_.data()), CreateKernelAddress(exp.data()),
+                                           CreateKernelAddress(&count_), CreateKernelAddress(&head_),
+                                           CreateKernelAddress(priorities.data())};
+  ASSERT_TRUE(append->Launch(append_inputs, workspace_, outputs_));
+  EXPECT_EQ(count_, 2);
+
+  sample_->priority_ = true;
+  std::vector<int> indexes(kBatchSize, -1);
+  CreateAddress();
+  inputs_.push_back(CreateKernelAddress(priorities.data()));
+  outputs_.push_back(CreateKernelAddress(indexes.data()));
+  ASSERT_TRUE(sample_->Launch(inputs_, workspace_, outputs_));
+  for (size_t i = 0; i < kBatchSize; ++i) {
+    EXPECT_TRUE(output_[i] == -1 || output_[i] == -2);
+    EXPECT_EQ(output_[i], -1 - indexes[i]);
+  }
+
+  // Slot 1 is given 3 times the priority of slot 0 by the sampled indexes.
+  auto update = std::make_shared<BufferCPUUpdatePriorityKernel>();
+  update->capacity_ = SizeToLong(kCapacity);
+  update->batch_size_ = kBatchSize;
+  std::vector<float> new_priorities;
+  (void)std::transform(indexes.begin(), indexes.end(), std::back_inserter(new_priorities),
+                       [](int index) { return index == 0 ? 1.0f : 3.0f; });
+  std::vector<AddressPtr> update_inputs = {CreateKernelAddress(priorities.data()), CreateKernelAddress(indexes.data()),
+                                           CreateKernelAddress(new_priorities.data())};
+  ASSERT_TRUE(update->Launch(update_inputs, workspace_, outputs_));
+  ASSERT_TRUE(sample_->Launch(inputs_, workspace_, outputs_));
+  auto num = std::count(output_.begin(), output_.end(), -2);
+  EXPECT_EQ(static_cast<size_t>(num), kBatchSize * 3 / 4);
+
+  // An index out of the capacity is rejected.
+  indexes[0] = SizeToInt(kCapacity);
+  EXPECT_FALSE(update->Launch(update_inputs, workspace_, outputs_));
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/fl/fused_pull_weight_kernel.h"
+
+namespace mindspore {
+namespace kernel {
+class FusedPullWeightKernelTest : public UT::Common {
+ public:
+  FusedPullWeightKernelTest() = default;
+
+  // Build the response of one bucket, holding one weight filled with the value.
+  std::shared_ptr<std::vector<unsigned char>> BuildResponse(int retcode, int iteration, const std::string &name,
+                                                            float value) {
+    flatbuffers::FlatBufferBuilder fbb;
+    std::vector<flatbuffers::Offset<schema::FeatureMap>> feature_maps;
+    if (retcode == schema::ResponseCode_SUCCEED) {
+      std::vector<float> data(kWeightSize, value);
+      feature_maps.push_back(schema::CreateFeatureMap(fbb, fbb.CreateString(name), fbb.CreateVector(data)));
+    }
+    auto rsp = schema::CreateResponsePullWeight(fbb, retcode, fbb.CreateString("test"), iteration,
+                                                fbb.CreateVector(feature_maps));
+    fbb.Finish(rsp);
+    return std::make_shared<std::vector<unsigned char>>(fbb.GetBufferPointer(), fbb.GetBufferPointer() + fbb.GetSize());
+  }
+
+  AddressPtr CreateKernelAddress(std::vector<float> *data) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = data->data();
+    kernel_addr->size = data->size() * sizeof(float);
+    return kernel_addr;
+  }
+
+  static constexpr size_t kWeightSize = 4;
+};
+
+/// Feature: FusedPullWeightKernel
+/// Description: Stage a SUCCEED response and a SucNotReady one, then the SUCCEED responses of different iterations
+/// Expectation: The weights are copied only after all the buckets are pulled from the same iteration
+TEST_F(FusedPullWeightKernelTest, StageMixedResponses) {
+  const std::vector<std::string> names = {"conv.weight", "fc.weight"};
+  const std::vector<std::vector<size_t>> buckets = {{0}, {1}};
+  std::vector<float> conv(kWeightSize, 0);
+  std::vector<float> fc(kWeightSize, 0);
+  std::vector<AddressPtr> weights = {CreateKernelAddress(&conv), CreateKernelAddress(&fc)};
+  PullWeightStaging staging(buckets.size());
+  uint64_t iteration = 0;
+
+  EXPECT_EQ(staging.Stage(0, BuildResponse(schema::ResponseCode_SUCCEED, 3, names[0], 1))->retcode(),
+            schema::ResponseCode_SUCCEED);
+  EXPECT_EQ(staging.Stage(1, BuildResponse(schema::ResponseCode_SucNotReady, 4, names[1], 2))->retcode(),
+            schema::ResponseCode_SucNotReady);
+  // The not ready bucket is not staged, so nothing can be copied yet.
+  EXPECT_ANY_THROW(staging.SameIteration(&iteration));
+  EXPECT_ANY_THROW(staging.CopyWeights(buckets, names, weights));
+  EXPECT_EQ(conv, std::vector<float>(kWeightSize, 0));
+  EXPECT_EQ(fc, std::vector<float>(kWeightSize, 0));
+
+  // The retried bucket is pulled from the next iteration, so all the buckets have to be pulled again.
+  (void)staging.Stage(1, BuildResponse(schema::ResponseCode_SUCCEED, 4, names[1], 2));
+  EXPECT_FALSE(staging.SameIteration(&iteration));
+  EXPECT_EQ(iteration, 4U);
+  staging.Clear();
+  EXPECT_ANY_THROW(staging.SameIteration(&iteration));
+
+  (void)staging.Stage(0, BuildResponse(schema::ResponseCode_SUCCEED, 4, names[0], 3));
+  (void)staging.Stage(1, BuildResponse(schema::ResponseCode_SUCCEED, 4, names[1], 4));
+  EXPECT_TRUE(staging.SameIteration(&iteration));
+  EXPECT_EQ(iteration, 4U);
+  staging.CopyWeights(buckets, names, weights);
+  EXPECT_EQ(conv, std::vector<float>(kWeightSize, 3));
+  EXPECT_EQ(fc, std::vector<float>(kWeightSize, 4));
+}
+}  // namespace kernel
+}  // namespace mindspore
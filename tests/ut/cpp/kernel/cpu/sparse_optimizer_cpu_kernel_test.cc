@@ -15,6 +15,10 @@
  */
 
 #include <vector>
+#include <map>
+#include <utility>
+#include <cmath>
+#include <random>
 #include "common/common_test.h"
 #include "backend/kernel_compiler/cpu/sparse_optimizer_cpu_kernel.h"
 
@@ -25,6 +29,66 @@ class CommonUtilTest : public UT::Common {
   CommonUtilTest() = default;
 };
 
+namespace {
+constexpr size_t kValueStride = 16;
+
+// Recommendation style indices, the popularity of the ids follows a power law.
+std::vector<int> GenPowerLawIndices(size_t indices_size, size_t max_index, double alpha, uint32_t seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> distrib(0.0, 1.0);
+  std::vector<int> indices(indices_size);
+  for (auto &index : indices) {
+    auto rank = std::pow(static_cast<double>(max_index), std::pow(distrib(generator), alpha));
+    index = static_cast<int>(std::min(static_cast<size_t>(rank) - 1, max_index - 1));
+  }
+  return indices;
+}
+
+std::map<int, std::vector<float>> Reduce(const std::vector<int> &indices, const std::vector<float> &grad,
+                                         size_t max_index, bool use_sort_reduce) {
+  size_t indices_size = indices.size();
+  std::vector<int> input_indices(indices);
+  std::vector<float> input_value(grad);
+  std::vector<int> unique_indices(indices_size);
+  std::vector<float> summed_grad(indices_size * kValueStride);
+  std::vector<int> tmp_indices(indices_size);
+  std::vector<float> tmp_grad(indices_size * kValueStride);
+  SparseGradient<int> unique_grad({summed_grad.data(), unique_indices.data(), indices_size});
+  SparseGradient<int> workspace_grad({tmp_grad.data(), tmp_indices.data(), indices_size});
+  SparseGradient<int> input_grad({input_value.data(), input_indices.data(), indices_size});
+  ReduceSparseGradientParam<int> param;
+  param.input_grad_ = &input_grad;
+  param.workspace_grad_ = &workspace_grad;
+  param.output_grad_ = &unique_grad;
+  param.max_index_ = max_index;
+  param.value_stride_ = kValueStride;
+  param.use_sort_reduce_ = use_sort_reduce;
+  SparseOptimizerCPUKernel::BucketReduceSparseGradient(param);
+  std::map<int, std::vector<float>> result;
+  for (size_t i = 0; i < unique_grad.indices_size_; ++i) {
+    auto value = unique_grad.value_ + i * kValueStride;
+    result[unique_grad.indices_[i]] = std::vector<float>(value, value + kValueStride);
+  }
+  return result;
+}
+
+void CheckReduce(const std::vector<int> &indices, size_t max_index, bool use_sort_reduce) {
+  std::vector<float> grad(indices.size() * kValueStride);
+  for (size_t i = 0; i < grad.size(); ++i) {
+    grad[i] = static_cast<float>(i % 7);
+  }
+  std::map<int, std::vector<float>> expect;
+  for (size_t i = 0; i < indices.size(); ++i) {
+    auto &value = expect[indices[i]];
+    value.resize(kValueStride, 0);
+    for (size_t j = 0; j < kValueStride; ++j) {
+      value[j] += grad[i * kValueStride + j];
+    }
+  }
+  EXPECT_EQ(Reduce(indices, grad, max_index, use_sort_reduce), expect);
+}
+}  // namespace
+
 TEST_F(CommonUtilTest, BucketReduceSparseGradient1) {
   // The indices is a vector and the grad is a tensor with shape (6, 2)
   /* 0
@@ -130,5 +194,38 @@ TEST_F(CommonUtilTest, BucketReduceSparseGradient2) {
     EXPECT_EQ(unique_grad.value_[i], expect_value[i]);
   }
 }
+/// Feature: SparseOptimizer
+/// Description: Test reducing the sparse gradient by sorting each bucket
+/// Expectation: The duplicated indices are reduced and the last index of each bucket is kept
+TEST_F(CommonUtilTest, BucketSortReduceSparseGradient) {
+  std::vector<int> indices{0, 0, 1, 1, 0, 3};
+  CheckReduce(indices, 6, true);
+}
+
+/// Feature: SparseOptimizer
+/// Description: Test reducing the sparse gradient of dense and sparse power law indices with the index tables
+/// Expectation: The result equals the reference for both the direct mapped and the hash table
+TEST_F(CommonUtilTest, BucketHashReduceSparseGradient) {
+  constexpr size_t kIndicesSize = 10000;
+  // Dense indices, reduced with the direct mapped table.
+  CheckReduce(GenPowerLawIndices(kIndicesSize, 1000, 1.0, 1), 1000, false);
+  // Sparse indices, reduced with the hash table.
+  CheckReduce(GenPowerLawIndices(kIndicesSize, 10000000, 1.0, 2), 10000000, false);
+  // The same indices reduced by sorting.
+  CheckReduce(GenPowerLawIndices(kIndicesSize, 1000, 1.0, 3), 1000, true);
+}
+
+/// Feature: SparseOptimizer
+/// Description: Reduce the same power law indices of different unique ratios by hashing and by sorting
+/// Expectation: Both give the same result
+TEST_F(CommonUtilTest, BucketHashReduceSameAsSortReduce) {
+  constexpr size_t kIndicesSize = 2000;
+  std::vector<std::pair<size_t, double>> cases = {{100, 1.0}, {10000, 1.0}, {100000000, 0.5}};
+  for (const auto &item : cases) {
+    auto indices = GenPowerLawIndices(kIndicesSize, item.first, item.second, 4);
+    std::vector<float> grad(kIndicesSize * kValueStride, 1.0f);
+    EXPECT_EQ(Reduce(indices, grad, item.first, false), Reduce(indices, grad, item.first, true));
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
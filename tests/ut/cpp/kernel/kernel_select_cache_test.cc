@@ -0,0 +1,55 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <cstdio>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/kernel_select_cache.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+class KernelSelectCacheTest : public UT::Common {
+ public:
+  KernelSelectCacheTest() = default;
+};
+
+/// Feature: KernelSelectCache
+/// Description: Test saving the kernel selections to file and loading them back
+/// Expectation: The loaded selection has the same formats and data types as the inserted one
+TEST_F(KernelSelectCacheTest, test_save_and_load) {
+  auto &cache = KernelSelectCache::GetInstance();
+  const std::string key = "CPU_TestAdd_in_43_43_not_cnode_1_out_43";
+  const std::string file_path = "./kernel_select_cache_test.json";
+  KernelSelectInfo info = {{kOpFormat_DEFAULT, kOpFormat_DEFAULT},
+                           {kNumberTypeFloat32, kNumberTypeFloat32},
+                           {kOpFormat_DEFAULT},
+                           {kNumberTypeFloat32}};
+  KernelSelectInfo found;
+  EXPECT_FALSE(cache.Find(key, &found));
+  cache.Insert(key, info);
+  ASSERT_TRUE(cache.Save(file_path));
+  ASSERT_TRUE(cache.Load(file_path));
+  ASSERT_TRUE(cache.Find(key, &found));
+  EXPECT_EQ(found.input_formats, info.input_formats);
+  EXPECT_EQ(found.input_types, info.input_types);
+  EXPECT_EQ(found.output_formats, info.output_formats);
+  EXPECT_EQ(found.output_types, info.output_types);
+  EXPECT_FALSE(cache.Load("./not_exist_kernel_select_cache.json"));
+  (void)remove(file_path.c_str());
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <vector>
 #include "common/common_test.h"
 #include "ir/dtype/number.h"
 #include "frontend/parallel/device_manager.h"
@@ -163,5 +165,35 @@ TEST_F(TestEdgeCostModel, test_EdgeEliminationSetNewCost) {
   new_edge->EdgeEliminationSetNewCost(matmul1, edges, matmul5);
 }
 
+/// Feature: Redistribution cost cache
+/// Description: Init the costs of two edges whose operators have the same shapes and strategies
+/// Expectation: The second edge reuses the cached redistribution costs and gets the same costs as the first one
+TEST_F(TestEdgeCostModel, test_RedistributionCostCache) {
+  Edge::ClearRedistributionCostCache();
+  matmul1->GenerateStrategies(0);
+  matmul2->GenerateStrategies(0);
+  matmul4->GenerateStrategies(0);
+  std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>("MatMul-MatMul", matmul1, matmul2, 0, 0, false);
+  ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
+  auto cache_size = Edge::RedistributionCostCacheSize();
+  ASSERT_GT(cache_size, 0);
+
+  std::shared_ptr<Edge> edge_m4_m2 = std::make_shared<Edge>("MatMul-MatMul", matmul4, matmul2, 0, 0, false);
+  ASSERT_EQ(edge_m4_m2->InitEdgeCost(), SUCCESS);
+  ASSERT_EQ(Edge::RedistributionCostCacheSize(), cache_size);
+
+  auto get_comm_costs = [](const std::shared_ptr<Edge> &edge) {
+    std::vector<double> comm_costs;
+    for (const auto &item : edge->GetCostMap()) {
+      comm_costs.push_back(item.second[0]->communication_cost_);
+    }
+    std::sort(comm_costs.begin(), comm_costs.end());
+    return comm_costs;
+  };
+  ASSERT_EQ(get_comm_costs(edge_m1_m2), get_comm_costs(edge_m4_m2));
+  Edge::ClearRedistributionCostCache();
+  ASSERT_EQ(Edge::RedistributionCostCacheSize(), 0);
+}
+
 }  // namespace parallel
 }  // namespace mindspore
@@ -0,0 +1,220 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <utility>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/optimizer/mem_reuse/mem_dynamic_allocator.h"
+
+namespace mindspore::device {
+namespace {
+constexpr size_t kTestUnitSize = 64 << 20;
+constexpr size_t kTestFreeMemSize = 8UL << 30;
+
+class TestMemPool : public DynamicMemPoolBestFit {
+ public:
+  explicit TestMemPool(bool thread_cache, size_t device_mem_size = kTestFreeMemSize)
+      : device_mem_size_(device_mem_size) {
+    SetMemAllocUintSize(kTestUnitSize, kTestUnitSize);
+    if (thread_cache) {
+      EnableThreadCache();
+    }
+  }
+  ~TestMemPool() override { ReleaseDeviceRes(); }
+
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    *addr = malloc(size);
+    if (*addr == nullptr) {
+      return 0;
+    }
+    alloc_sizes_[*addr] = size;
+    allocated_size_ += size;
+    return size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &addr) override {
+    allocated_size_ -= alloc_sizes_[addr];
+    (void)alloc_sizes_.erase(addr);
+    free(addr);
+    return true;
+  }
+  size_t free_mem_size() override { return device_mem_size_ - allocated_size_; }
+
+ private:
+  size_t device_mem_size_;
+  size_t allocated_size_{0};
+  std::map<DeviceMemPtr, size_t> alloc_sizes_;
+};
+
+// Every actor keeps a few tensors alive and frees the oldest one before the next alloc, like a kernel actor does with
+// its inputs and outputs. With hand_over half of the memory is freed by the neighbour actor, as across a data arrow.
+void RunActors(DynamicMemPoolBestFit *pool, size_t actor_num, size_t step_num, bool hand_over) {
+  constexpr size_t kLiveNum = 4;
+  constexpr size_t kSizeNum = 5;
+  const size_t sizes[kSizeNum] = {64, 1024, 4096, 16384, 65536};
+  std::vector<std::vector<DeviceMemPtr>> handed_over(actor_num);
+  std::vector<std::thread> actors;
+  for (size_t actor = 0; actor < actor_num; ++actor) {
+    actors.emplace_back([pool, actor, step_num, hand_over, &sizes, &handed_over]() {
+      std::vector<DeviceMemPtr> live;
+      for (size_t step = 0; step < step_num; ++step) {
+        auto addr = pool->AllocTensorMem(sizes[(actor + step) % kSizeNum]);
+        ASSERT_NE(addr, nullptr);
+        live.emplace_back(addr);
+        if (live.size() > kLiveNum) {
+          if (hand_over && step % 2 == 0) {
+            handed_over[actor].emplace_back(live.front());
+          } else {
+            pool->FreeTensorMem(live.front());
+          }
+          live.erase(live.begin());
+        }
+      }
+      pool->FreeTensorMems(live);
+    });
+  }
+  for (auto &thread : actors) {
+    thread.join();
+  }
+  // Free the handed over memory from other threads.
+  std::vector<std::thread> consumers;
+  for (size_t actor = 0; actor < actor_num; ++actor) {
+    consumers.emplace_back([pool, actor, actor_num, &handed_over]() {
+      pool->FreeTensorMems(handed_over[(actor + 1) % actor_num]);
+    });
+  }
+  for (auto &thread : consumers) {
+    thread.join();
+  }
+}
+}  // namespace
+
+class TestDynamicMemPool : public UT::Common {
+ public:
+  TestDynamicMemPool() = default;
+};
+
+/// Feature: thread cache of dynamic memory pool.
+/// Description: free and alloc the same size class on one thread.
+/// Expectation: the freed memory is reused and the pool statistics see it as used until the pool is released.
+TEST_F(TestDynamicMemPool, test_thread_cache_reuse) {
+  TestMemPool pool(true);
+  auto addr = pool.AllocTensorMem(1000);
+  ASSERT_NE(addr, nullptr);
+  pool.FreeTensorMem(addr);
+  ASSERT_EQ(pool.AllocTensorMem(1000), addr);
+  // Sizes of the same class share the cache.
+  pool.FreeTensorMem(addr);
+  ASSERT_EQ(pool.AllocTensorMem(DYNAMIC_MEM_ALIGN_SIZE * 2), addr);
+  // Large and continuous memory bypass the cache.
+  auto large_addr = pool.AllocTensorMem(DYNAMIC_MEM_THREAD_CACHE_MAX_SIZE + 1);
+  ASSERT_NE(large_addr, nullptr);
+  pool.FreeTensorMem(large_addr);
+  auto continuous_addrs = pool.AllocContinuousTensorMem(2048, {1024, 1024});
+  ASSERT_EQ(continuous_addrs.size(), 2);
+  pool.FreeTensorMems(continuous_addrs);
+  pool.ReleaseDeviceRes();
+  // The stale cache of this thread is dropped after the release.
+  ASSERT_NE(pool.AllocTensorMem(1000), nullptr);
+}
+
+/// Feature: thread cache of dynamic memory pool.
+/// Description: actors on several threads alloc memory and free it on their own and on other threads.
+/// Expectation: all memory is back in the pool once the threads exit.
+TEST_F(TestDynamicMemPool, test_thread_cache_cross_thread) {
+  constexpr size_t kActorNum = 8;
+  constexpr size_t kStepNum = 2000;
+  TestMemPool pool(true);
+  RunActors(&pool, kActorNum, kStepNum, true);
+  ASSERT_EQ(pool.TotalUsedMemStatistics(), 0);
+}
+
+/// Feature: thread cache of dynamic memory pool.
+/// Description: several threads hold memory of all the size classes at the same time, then free it.
+/// Expectation: no memory is handed out twice, and the pool statistics balance after the threads exit.
+TEST_F(TestDynamicMemPool, test_thread_cache_unique_addresses) {
+  constexpr size_t kThreadNum = 4;
+  constexpr size_t kAllocNum = 64;
+  TestMemPool pool(true);
+  std::vector<std::vector<std::pair<DeviceMemPtr, size_t>>> allocated(kThreadNum);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&pool, &allocated, i]() {
+      for (size_t j = 0; j < kAllocNum; ++j) {
+        // Sizes from below one size class to above the thread cache.
+        size_t size = (i * kAllocNum + j + 1) * DYNAMIC_MEM_ALIGN_SIZE / 2 + 1;
+        auto addr = pool.AllocTensorMem(size);
+        ASSERT_NE(addr, nullptr);
+        allocated[i].emplace_back(addr, size);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::vector<std::pair<DeviceMemPtr, size_t>> all_allocated;
+  for (const auto &thread_allocated : allocated) {
+    all_allocated.insert(all_allocated.end(), thread_allocated.begin(), thread_allocated.end());
+  }
+  ASSERT_EQ(all_allocated.size(), kThreadNum * kAllocNum);
+  std::sort(all_allocated.begin(), all_allocated.end());
+  for (size_t i = 1; i < all_allocated.size(); ++i) {
+    auto prev_end = static_cast<uint8_t *>(all_allocated[i - 1].first) + all_allocated[i - 1].second;
+    EXPECT_LE(prev_end, static_cast<uint8_t *>(all_allocated[i].first));
+  }
+
+  threads.clear();
+  for (size_t i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&pool, &allocated, i]() {
+      for (const auto &addr_size : allocated[i]) {
+        pool.FreeTensorMem(addr_size.first);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), 0);
+  EXPECT_EQ(pool.TotalMemStatistics(), kTestUnitSize);
+}
+
+/// Feature: thread cache of dynamic memory pool.
+/// Description: the device memory holds one memory block, this thread keeps freed memory in its cache, and another
+/// thread allocs the whole block.
+/// Expectation: the cache of this thread is given back to the pool, so the alloc of the other thread succeeds.
+TEST_F(TestDynamicMemPool, test_thread_cache_flush_on_alloc_failure) {
+  constexpr size_t kCachedNum = 4;
+  TestMemPool pool(true, kTestUnitSize);
+  std::vector<DeviceMemPtr> cached_addrs;
+  for (size_t i = 0; i < kCachedNum; ++i) {
+    cached_addrs.emplace_back(pool.AllocTensorMem(DYNAMIC_MEM_THREAD_CACHE_MAX_SIZE));
+    ASSERT_NE(cached_addrs.back(), nullptr);
+  }
+  pool.FreeTensorMems(cached_addrs);
+  ASSERT_GT(pool.TotalUsedMemStatistics(), 0);
+
+  DeviceMemPtr whole_addr = nullptr;
+  std::thread other([&pool, &whole_addr]() { whole_addr = pool.AllocTensorMem(kTestUnitSize); });
+  other.join();
+  ASSERT_NE(whole_addr, nullptr);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), kTestUnitSize);
+  pool.FreeTensorMem(whole_addr);
+  EXPECT_EQ(pool.TotalUsedMemStatistics(), 0);
+}
+}  // namespace mindspore::device
@@ -0,0 +1,139 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <mutex>
+#include "common/common_test.h"
+#include "ps/embedding_lookup_prefetcher.h"
+
+namespace mindspore {
+namespace ps {
+constexpr size_t kRowSize = 2;
+constexpr size_t kVocabSize = 10;
+class TestEmbeddingLookupPrefetcher : public UT::Common {
+ public:
+  TestEmbeddingLookupPrefetcher() = default;
+  virtual ~TestEmbeddingLookupPrefetcher() = default;
+
+  void SetUp() override {
+    table_.assign(kVocabSize * kRowSize, 0.0f);
+    lookup_num_ = 0;
+  }
+  void TearDown() override {}
+
+  // The fake server table, in which each row is filled with its value.
+  bool LookupTable(const std::vector<int> &ids, std::vector<float> *rows) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++lookup_num_;
+    for (size_t i = 0; i < ids.size(); ++i) {
+      for (size_t j = 0; j < kRowSize; ++j) {
+        (*rows)[i * kRowSize + j] = table_[ids[i] * kRowSize + j];
+      }
+    }
+    return true;
+  }
+
+  void Push(int id, float value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t j = 0; j < kRowSize; ++j) {
+      table_[id * kRowSize + j] = value;
+    }
+  }
+
+  EmbeddingLookupPrefetcherPtr CreatePrefetcher(size_t max_staleness) {
+    return std::make_shared<EmbeddingLookupPrefetcher>(
+      kRowSize, max_staleness, [this](const std::vector<int> &ids, std::vector<float> *rows) {
+        return LookupTable(ids, rows);
+      });
+  }
+
+  std::mutex mutex_;
+  std::vector<float> table_;
+  size_t lookup_num_{0};
+};
+
+/// Feature: EmbeddingLookupPrefetcher
+/// Description: Test looking up the rows prefetched in the last step
+/// Expectation: The prefetched rows hit and the others are looked up synchronously with the latest values
+TEST_F(TestEmbeddingLookupPrefetcher, test_prefetch_hit) {
+  auto prefetcher = CreatePrefetcher(1);
+  Push(1, 1.0f);
+  Push(2, 2.0f);
+  std::vector<int> ids = {1, 2, 1};
+  std::vector<float> result(ids.size() * kRowSize, -1.0f);
+  ASSERT_TRUE(prefetcher->Lookup(ids, result.data(), result.size()));
+  EXPECT_EQ(result, std::vector<float>({1.0f, 1.0f, 2.0f, 2.0f, 1.0f, 1.0f}));
+  EXPECT_EQ(prefetcher->miss_num(), 3U);
+  prefetcher->Prefetch(ids);
+
+  Push(3, 3.0f);
+  ids = {2, 3};
+  result.assign(ids.size() * kRowSize, -1.0f);
+  ASSERT_TRUE(prefetcher->Lookup(ids, result.data(), result.size()));
+  EXPECT_EQ(result, std::vector<float>({2.0f, 2.0f, 3.0f, 3.0f}));
+  EXPECT_EQ(prefetcher->hit_num(), 1U);
+  EXPECT_EQ(prefetcher->miss_num(), 4U);
+
+  // Only the row fetched before the last step is prefetched again, with the value pushed in between.
+  Push(2, 20.0f);
+  auto lookup_num = lookup_num_;
+  prefetcher->Prefetch(ids);
+  result.assign(ids.size() * kRowSize, -1.0f);
+  ASSERT_TRUE(prefetcher->Lookup(ids, result.data(), result.size()));
+  EXPECT_EQ(result, std::vector<float>({20.0f, 20.0f, 3.0f, 3.0f}));
+  EXPECT_EQ(prefetcher->hit_num(), 3U);
+  EXPECT_EQ(lookup_num_, lookup_num + 1);
+}
+
+/// Feature: EmbeddingLookupPrefetcher
+/// Description: Test the staleness of the rows updated on the server after they are fetched
+/// Expectation: The stale rows are used for at most max_staleness steps, then the latest values are looked up
+TEST_F(TestEmbeddingLookupPrefetcher, test_bounded_staleness) {
+  constexpr size_t kMaxStaleness = 2;
+  auto prefetcher = CreatePrefetcher(kMaxStaleness);
+  std::vector<int> ids = {5};
+  std::vector<float> result(kRowSize, -1.0f);
+  ASSERT_TRUE(prefetcher->Lookup(ids, result.data(), result.size()));
+  EXPECT_EQ(result[0], 0.0f);
+
+  // Without prefetch, the row fetched in step 0 is used until step kMaxStaleness.
+  Push(5, 5.0f);
+  for (size_t step = 1; step <= kMaxStaleness; ++step) {
+    ASSERT_TRUE(prefetcher->Lookup(ids, result.data(), result.size()));
+    EXPECT_EQ(result[0], 0.0f);
+  }
+  ASSERT_TRUE(prefetcher->Lookup(ids, result.data(), result.size()));
+  EXPECT_EQ(result[0], 5.0f);
+  EXPECT_EQ(prefetcher->hit_num(), kMaxStaleness);
+
+  // The rows looked up in the current step are fresh enough to skip the prefetch.
+  auto lookup_num = lookup_num_;
+  prefetcher->Prefetch(ids);
+  ASSERT_TRUE(prefetcher->Lookup(ids, result.data(), result.size()));
+  EXPECT_EQ(lookup_num_, lookup_num);
+}
+
+/// Feature: EmbeddingLookupPrefetcher
+/// Description: Test looking up with a result buffer smaller than the rows
+/// Expectation: The lookup fails
+TEST_F(TestEmbeddingLookupPrefetcher, test_invalid_result_size) {
+  auto prefetcher = CreatePrefetcher(1);
+  std::vector<int> ids = {1, 2};
+  std::vector<float> result(kRowSize, 0.0f);
+  EXPECT_FALSE(prefetcher->Lookup(ids, result.data(), result.size()));
+}
+}  // namespace ps
+}  // namespace mindspore
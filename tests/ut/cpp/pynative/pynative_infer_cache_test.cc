@@ -0,0 +1,125 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <cstdio>
+#include "common/common_test.h"
+#include "pipeline/pynative/pynative_infer_cache.h"
+#include "ir/tensor.h"
+#include "base/core_ops.h"
+
+namespace mindspore {
+namespace pynative {
+class TestPynativeInferCache : public UT::Common {
+ public:
+  TestPynativeInferCache() = default;
+};
+
+/// Feature: PynativeInferCache
+/// Description: Build the keys of the operators with the static shape tensors, the scalars and the constant tensors
+/// Expectation: The key depends on the attributes and inputs, and the operator with constant tensor isn't cached
+TEST_F(TestPynativeInferCache, test_get_key) {
+  auto prim = std::make_shared<Primitive>(prim::kPrimReduceSum->name());
+  (void)prim->AddAttr("keep_dims", MakeValue(false));
+  auto input = std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{2, 3});
+  auto axis = std::make_shared<abstract::AbstractScalar>(MakeValue<int64_t>(1));
+  auto key = PynativeInferCache::GetKey(prim, {input, axis});
+  EXPECT_FALSE(key.empty());
+
+  auto other_axis = std::make_shared<abstract::AbstractScalar>(MakeValue<int64_t>(0));
+  EXPECT_NE(PynativeInferCache::GetKey(prim, {input, other_axis}), key);
+  auto other_input = std::make_shared<abstract::AbstractTensor>(kFloat16, ShapeVector{2, 3});
+  EXPECT_NE(PynativeInferCache::GetKey(prim, {other_input, axis}), key);
+  (void)prim->AddAttr("keep_dims", MakeValue(true));
+  EXPECT_NE(PynativeInferCache::GetKey(prim, {input, axis}), key);
+
+  auto const_tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{2, 3});
+  EXPECT_TRUE(PynativeInferCache::GetKey(prim, {const_tensor->ToAbstract(), axis}).empty());
+  auto dynamic_input = std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{-1, 3});
+  EXPECT_TRUE(PynativeInferCache::GetKey(prim, {dynamic_input, axis}).empty());
+}
+
+/// Feature: PynativeInferCache
+/// Description: Build the keys of the operators without C++ infer implementations, which are inferred in python
+/// Expectation: The operators defined by the users and the custom operators aren't cached
+TEST_F(TestPynativeInferCache, test_get_key_of_python_infer) {
+  auto input = std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{2, 3});
+  auto user_prim = std::make_shared<Primitive>("TestUserDefinedPrim");
+  EXPECT_TRUE(PynativeInferCache::GetKey(user_prim, {input}).empty());
+  auto custom_prim = std::make_shared<Primitive>("Custom");
+  (void)custom_prim->AddAttr("func_type", MakeValue("aot"));
+  EXPECT_TRUE(PynativeInferCache::GetKey(custom_prim, {input}).empty());
+}
+
+/// Feature: PynativeInferCache
+/// Description: Test saving the inferred abstracts to file and loading them back
+/// Expectation: The loaded abstract has the same data types and shapes as the inserted one
+TEST_F(TestPynativeInferCache, test_save_and_load) {
+  auto &cache = PynativeInferCache::GetInstance();
+  const std::string key = "TestSplit{axis=0,}T43(4, 2);";
+  const std::string file_path = "./pynative_infer_cache_test.json";
+  auto output = std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{2, 2});
+  auto abs = std::make_shared<abstract::AbstractTuple>(abstract::AbstractBasePtrList{output, output});
+  EXPECT_EQ(cache.Find(key), nullptr);
+  cache.Insert(key, abs);
+  ASSERT_TRUE(cache.Save(file_path));
+  ASSERT_TRUE(cache.Load(file_path));
+  auto found = cache.Find(key);
+  ASSERT_NE(found, nullptr);
+  ASSERT_TRUE(found->isa<abstract::AbstractTuple>());
+  EXPECT_EQ(found->cast<abstract::AbstractTuplePtr>()->size(), 2);
+  EXPECT_EQ(found->BuildType()->ToString(), abs->BuildType()->ToString());
+  EXPECT_EQ(found->BuildShape()->ToString(), abs->BuildShape()->ToString());
+
+  // The abstracts other than the static shape tensors are not cached.
+  const std::string dynamic_key = "TestUnique{}T43(4);";
+  cache.Insert(dynamic_key, std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{-1}));
+  EXPECT_EQ(cache.Find(dynamic_key), nullptr);
+  EXPECT_FALSE(cache.Load("./not_exist_pynative_infer_cache.json"));
+  (void)remove(file_path.c_str());
+}
+
+/// Feature: PynativeInferCache
+/// Description: Find the abstract saved to file for a primitive whose former infer added attributes
+/// Expectation: The miss keeps the recorded attributes for the infer, and the hit clears them like an infer adding no
+/// attributes, so they aren't cached with the found abstract
+TEST_F(TestPynativeInferCache, test_find_after_infer_added_attrs) {
+  auto &cache = PynativeInferCache::GetInstance();
+  const std::string file_path = "./pynative_infer_cache_attrs_test.json";
+  auto prim = std::make_shared<Primitive>(prim::kPrimReduceSum->name());
+  auto input = std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{4, 3});
+  auto key = PynativeInferCache::GetKey(prim, {input});
+  ASSERT_FALSE(key.empty());
+  // The former infer of the primitive added an attribute.
+  prim->BeginRecordAddAttr();
+  (void)prim->AddAttr("input_names", MakeValue(std::vector<std::string>{"x"}));
+  prim->EndRecordAddAttr();
+  ASSERT_FALSE(prim->evaluate_added_attrs().empty());
+
+  EXPECT_EQ(cache.Find(prim, key), nullptr);
+  EXPECT_FALSE(prim->evaluate_added_attrs().empty());
+  auto output = std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{4});
+  cache.Insert(key, output);
+  ASSERT_TRUE(cache.Save(file_path));
+  ASSERT_TRUE(cache.Load(file_path));
+  auto found = cache.Find(prim, key);
+  ASSERT_NE(found, nullptr);
+  EXPECT_EQ(found->BuildShape()->ToString(), output->BuildShape()->ToString());
+  EXPECT_TRUE(prim->evaluate_added_attrs().empty());
+  (void)remove(file_path.c_str());
+}
+}  // namespace pynative
+}  // namespace mindspore